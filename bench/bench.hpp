@@ -0,0 +1,174 @@
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+/**
+ * Outils communs aux programmes de mesure de performances du dossier bench/ : un chronomètre, les compteurs matériels du processeur (PerfCounters) une barrière empêchant le compilateur de supprimer un calcul dont le résultat n'est pas utilisé, et une autre l'empêchant de dévirtualiser les appels à travers un List<T>*.
+ *
+ * Compilation d'un benchmark : g++ -std=c++17 -O2 -I.. bench_xxx.cpp -o bench_xxx, ou avec CMake depuis la racine du dépôt (un exécutable par fichier bench_*.cpp, la cible "bench" lance bench_suite).
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class Chrono
+{
+    private:
+        std::chrono::steady_clock::time_point mStart;
+
+    public:
+        Chrono(){
+            this->reset();
+        }
+
+        void reset(){
+            mStart = std::chrono::steady_clock::now();
+        }
+
+        /**
+         * Temps écoulé depuis la création du chronomètre (ou le dernier reset()) en nanosecondes
+         */
+        double elapsedNs() const{
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - mStart).count();
+        }
+
+        double elapsedMs() const{
+            return this->elapsedNs() / 1e6;
+        }
+};
+
+/**
+ * Compteurs matériels du processeur (cycles, instructions, défauts de cache, mauvaises prédictions de branchement) du thread courant, lus par perf_event_open sous Linux. Un compteur que le système refuse d'ouvrir (autre système, machine virtuelle, /proc/sys/kernel/perf_event_paranoid trop restrictif...) est simplement indisponible : available(i) vaut false et sa valeur reste à 0.
+ */
+#define PERF_COUNTERS 4
+
+class PerfCounters
+{
+    private:
+        int mFd[PERF_COUNTERS];
+
+    public:
+        PerfCounters(){
+            for(int i = 0; i < PERF_COUNTERS; i++){
+                mFd[i] = -1;
+#ifdef __linux__
+                static const unsigned long long configs[PERF_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+                struct perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = configs[i];
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                mFd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+            }
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator= (const PerfCounters&) = delete;
+
+        ~PerfCounters(){
+#ifdef __linux__
+            for(int i = 0; i < PERF_COUNTERS; i++){
+                if(mFd[i] != -1)
+                    close(mFd[i]);
+            }
+#endif
+        }
+
+        static const char* name(int i){
+            static const char* names[PERF_COUNTERS] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+            return names[i];
+        }
+
+        bool available(int i) const{
+            return mFd[i] != -1;
+        }
+
+        bool anyAvailable() const{
+            for(int i = 0; i < PERF_COUNTERS; i++){
+                if(mFd[i] != -1)
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * Remet les compteurs à zéro et les démarre
+         */
+        void start(){
+#ifdef __linux__
+            for(int i = 0; i < PERF_COUNTERS; i++){
+                if(mFd[i] != -1){
+                    ioctl(mFd[i], PERF_EVENT_IOC_RESET, 0);
+                    ioctl(mFd[i], PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        /**
+         * Arrête les compteurs et place leurs valeurs dans values
+         */
+        void stop(long long values[PERF_COUNTERS]){
+            for(int i = 0; i < PERF_COUNTERS; i++){
+                values[i] = 0;
+#ifdef __linux__
+                if(mFd[i] != -1){
+                    ioctl(mFd[i], PERF_EVENT_IOC_DISABLE, 0);
+                    if(read(mFd[i], &values[i], sizeof(values[i])) != (ssize_t)sizeof(values[i]))
+                        values[i] = 0;
+                }
+#endif
+            }
+        }
+};
+
+/**
+ * Force le compilateur à considérer que la valeur v est lue (et donc à la calculer).
+ */
+template<typename T>
+inline void doNotOptimize(T const& v){
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(v) : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<const volatile char*>(&v);
+#endif
+}
+
+template<typename T>
+class List;
+
+/**
+ * Empêche le compilateur de connaître le type dynamique de la liste (et donc de dévirtualiser les appels)
+ */
+template<typename T>
+__attribute__((noinline)) List<T>* opaque(List<T>* l){
+    doNotOptimize(l);
+    return l;
+}
+
+template<typename T>
+__attribute__((noinline)) const List<T>* opaque(const List<T>* l){
+    doNotOptimize(l);
+    return l;
+}
+
+/**
+ * Lit le i-ème argument de la ligne de commande comme un entier, ou renvoie def s'il est absent.
+ */
+inline long argOr(int argc, char** argv, int i, long def){
+    return i < argc ? std::atol(argv[i]) : def;
+}
+
+#endif
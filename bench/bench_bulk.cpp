@@ -0,0 +1,149 @@
+/**
+ * Opérations par lots contre opérations élément par élément, à travers l'interface List<int> :
+ *  - ajout des N éléments d'une autre liste : append() un à un contre appendAll() (une réservation, une copie par bloc) ;
+ *  - insertion de N/10 éléments au milieu d'un Vector de N éléments : append() de la fin déplacée à la main contre insertRange() ;
+ *  - suppression de K valeurs distinctes : un remove() par valeur (une recherche et un décalage chacun, O(K·N)) contre removeAll() (un seul compactage, les valeurs étant cherchées dans une IndexedList) et removeIf() avec un prédicat ; pour LinkedList, K/10 valeurs parmi N/10 éléments.
+ * Temps en ms.
+ *
+ * Les listes obtenues de part et d'autre sont comparées : toute différence est signalée par "ERREUR" et fait échouer le programme.
+ *
+ * Usage : bench_bulk [N] [K]
+ */
+
+#include <cstdio>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../linkedlist.hpp"
+#include "../indexedlist.hpp"
+
+bool same(const List<int>& a, const List<int>& b){
+    if(a.size() != b.size())
+        return false;
+    List<int>::const_iterator it = b.begin();
+    for(int x : a){
+        if(x != *it)
+            return false;
+        ++it;
+    }
+    return true;
+}
+
+void report(const char* name, double oneByOneMs, double bulkMs){
+    std::printf("%-34s %12.2f %12.2f %8.1fx\n", name, oneByOneMs, bulkMs, oneByOneMs / bulkMs);
+}
+
+template<typename L>
+void appendBench(const char* name, const Vector<int>& src, bool& ok){
+    const List<int>& s = *opaque(const_cast<Vector<int>*>(&src));
+    L a, b;
+    List<int>& la = *opaque(&a);
+    List<int>& lb = *opaque(&b);
+
+    Chrono c;
+    for(int x : s)
+        la.append(x);
+    double oneMs = c.elapsedMs();
+    c.reset();
+    lb.appendAll(s);
+    double bulkMs = c.elapsedMs();
+
+    ok = ok && same(la, lb) && same(la, s);
+    report(name, oneMs, bulkMs);
+}
+
+int main(int argc, char** argv){
+    int n = (int)argOr(argc, argv, 1, 1000000);
+    int k = (int)argOr(argc, argv, 2, 10000);
+
+    Vector<int> src(n);
+    for(int i = 0; i < n; i++)
+        src.append(i);
+
+    bool ok = true;
+    std::printf("N = %d, K = %d, temps en ms\n", n, k);
+    std::printf("%-34s %12s %12s %9s\n", "", "un par un", "par lot", "gain");
+
+    appendBench< Vector<int> >("Vector : append / appendAll", src, ok);
+    appendBench< LinkedList<int> >("LinkedList : append / appendAll", src, ok);
+
+    //Insertion au milieu
+    {
+        Vector<int> part(n/10);
+        for(int i = 0; i < n/10; i++)
+            part.append(-i);
+        Vector<int> a(src), b(src);
+        List<int>& la = *opaque(&a);
+        List<int>& lb = *opaque(&b);
+        int mid = n/2;
+
+        Chrono c;
+        Vector<int> tail(n - mid); //À la main : on retire la fin, on ajoute, on remet la fin
+        for(int i = mid; i < n; i++)
+            tail.append(la[i]);
+        for(int i = n - 1; i >= mid; i--)
+            la.removeAt(i);
+        for(int x : part)
+            la.append(x);
+        for(int x : tail)
+            la.append(x);
+        double oneMs = c.elapsedMs();
+        c.reset();
+        lb.insertRange(mid, part);
+        double bulkMs = c.elapsedMs();
+
+        ok = ok && same(la, lb) && la[mid] == 0 && la[mid + n/10] == mid;
+        report("Vector : insertion / insertRange", oneMs, bulkMs);
+    }
+
+    //Suppression de K valeurs
+    {
+        IndexedList<int> values;
+        for(int i = 0; i < k; i++)
+            values.append(i * (n / k));
+        Vector<int> a(src), b(src), d(src);
+        List<int>& la = *opaque(&a);
+        List<int>& lb = *opaque(&b);
+        List<int>& ld = *opaque(&d);
+
+        Chrono c;
+        for(int x : values)
+            la.remove(x);
+        double oneMs = c.elapsedMs();
+        c.reset();
+        int removed = lb.removeAll(values);
+        double bulkMs = c.elapsedMs();
+        report("Vector : remove / removeAll", oneMs, bulkMs);
+
+        c.reset();
+        int step = n / k;
+        int removedIf = ld.removeIf([step, k](const int& x){ return x % step == 0 && x / step < k; });
+        report("Vector : remove / removeIf", oneMs, c.elapsedMs());
+
+        ok = ok && removed == k && removedIf == k && same(la, lb) && same(la, ld);
+    }
+    {
+        IndexedList<int> values;
+        for(int i = 0; i < k/10; i++)
+            values.append(i * (n / k));
+        LinkedList<int> a, b; //Parcours de noeuds épars : on se limite à N/10 éléments
+        a.appendAll(src.begin(), src.begin() + n/10);
+        b.appendAll(src.begin(), src.begin() + n/10);
+        List<int>& la = *opaque(&a);
+        List<int>& lb = *opaque(&b);
+
+        Chrono c;
+        for(int x : values)
+            la.remove(x);
+        double oneMs = c.elapsedMs();
+        c.reset();
+        lb.removeAll(values);
+        report("LinkedList : remove / removeAll", oneMs, c.elapsedMs());
+
+        ok = ok && same(la, lb) && la.size() == n/10 - k/10;
+    }
+
+    std::printf(ok ? "OK\n" : "ERREUR\n");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+/**
+ * Débit des files multi-producteurs / multi-consommateurs, en millions d'éléments par seconde : LinkedList protégée par un std::mutex (l'usage actuel), ConcurrentLinkedQueue et ConcurrentArrayQueue, pour plusieurs nombres de producteurs (P) et de consommateurs (C).
+ *
+ * Chaque mesure sert aussi de test de charge : le producteur p envoie les valeurs p*M, p*M + 1... et chaque consommateur vérifie qu'il reçoit les valeurs d'un même producteur dans l'ordre croissant (propriété FIFO), et que chaque valeur est reçue exactement une fois. Toute anomalie est signalée par "ERREUR" et fait échouer le programme.
+ *
+ * Usage : bench_concurrent_queue [M] [Tmax]   (M éléments par producteur, jusqu'à Tmax producteurs et autant de consommateurs)
+ *
+ * Compilation : g++ -std=c++17 -O2 -pthread -I.. bench_concurrent_queue.cpp -o bench_concurrent_queue
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "bench.hpp"
+#include "../linkedlist.hpp"
+#include "../concurrentlinkedqueue.hpp"
+#include "../concurrentarrayqueue.hpp"
+
+/**
+ * File de référence : une LinkedList et un verrou global
+ */
+class MutexQueue
+{
+    private:
+        LinkedList<long> mList;
+        std::mutex mMutex;
+
+    public:
+        bool offer(long e){
+            std::lock_guard<std::mutex> lock(mMutex);
+            mList.append(e);
+            return true;
+        }
+
+        bool poll(long& out){
+            std::lock_guard<std::mutex> lock(mMutex);
+            if(mList.size() == 0)
+                return false;
+            out = mList.first();
+            mList.removeAt(0);
+            return true;
+        }
+};
+
+template<typename Q>
+Q* makeQueue(){
+    return new Q();
+}
+
+template<>
+ConcurrentArrayQueue<long>* makeQueue< ConcurrentArrayQueue<long> >(){
+    return new ConcurrentArrayQueue<long>(4096);
+}
+
+/**
+ * Renvoie le débit en millions d'éléments par seconde, et met ok à false en cas d'anomalie
+ */
+template<typename Q>
+double run(int producers, int consumers, long m, bool& ok){
+    Q* q = makeQueue<Q>();
+    long total = producers * m;
+    std::atomic<char>* seen = new std::atomic<char>[total];
+    for(long i = 0; i < total; i++)
+        seen[i].store(0, std::memory_order_relaxed);
+    std::atomic<long> received(0);
+    std::atomic<bool> error(false);
+
+    std::thread* threads = new std::thread[producers + consumers];
+    Chrono c;
+    for(int p = 0; p < producers; p++){
+        threads[p] = std::thread([q, p, m]{
+            for(long i = 0; i < m; i++){
+                while(!q->offer(p*m + i)) //File bornée pleine
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for(int k = 0; k < consumers; k++){
+        threads[producers + k] = std::thread([q, producers, m, total, seen, &received, &error]{
+            long* last = new long[producers];
+            for(int p = 0; p < producers; p++)
+                last[p] = -1;
+            long v;
+            while(received.load(std::memory_order_relaxed) < total){
+                if(!q->poll(v)){
+                    std::this_thread::yield();
+                    continue;
+                }
+                received.fetch_add(1, std::memory_order_relaxed);
+                if(v < 0 || v >= total || seen[v].fetch_add(1) != 0){
+                    error = true;
+                    continue;
+                }
+                int p = (int)(v / m);
+                if(v % m <= last[p])
+                    error = true;
+                last[p] = v % m;
+            }
+            delete[] last;
+        });
+    }
+    for(int i = 0; i < producers + consumers; i++)
+        threads[i].join();
+    double ns = c.elapsedNs();
+
+    long v;
+    if(q->poll(v))
+        error = true; //Élément en trop
+    for(long i = 0; i < total; i++){
+        if(seen[i].load() != 1)
+            error = true;
+    }
+    if(error.load())
+        ok = false;
+
+    delete[] threads;
+    delete[] seen;
+    delete q;
+    return total / ns * 1e3;
+}
+
+int main(int argc, char** argv){
+    long m = argOr(argc, argv, 1, 1000000);
+    long tMax = argOr(argc, argv, 2, (long)std::thread::hardware_concurrency());
+    if(tMax < 1)
+        tMax = 1;
+
+    bool ok = true;
+    std::printf("M = %ld éléments par producteur, débit en Mélém/s\n", m);
+    std::printf("%-8s %14s %16s %16s\n", "P x C", "mutex", "ConcLinked", "ConcArray");
+    for(long t = 1; t <= tMax; t *= 2){
+        for(int shape = 0; shape < 3; shape++){
+            int p = (int)t, c = (int)t;
+            if(shape == 1) //Un seul consommateur
+                c = 1;
+            else if(shape == 2) //Un seul producteur
+                p = 1;
+            if(shape > 0 && t == 1)
+                continue;
+            double mutex = run<MutexQueue>(p, c, m, ok);
+            double linked = run< ConcurrentLinkedQueue<long> >(p, c, m, ok);
+            double array = run< ConcurrentArrayQueue<long> >(p, c, m, ok);
+            std::printf("%2d x %-3d %14.2f %16.2f %16.2f\n", p, c, mutex, linked, array);
+        }
+    }
+    std::printf(ok ? "OK\n" : "ERREUR\n");
+
+    return ok ? 0 : 1;
+}
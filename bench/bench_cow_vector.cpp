@@ -0,0 +1,225 @@
+/**
+ * Lectures concurrentes d'une table rarement modifiée : Vector protégé par un std::shared_mutex (l'usage actuel) contre CopyOnWriteVector, avec R lecteurs et un écrivain qui réécrit la table en permanence.
+ *
+ * Pour chaque nombre de lecteurs : latence moyenne d'une lecture (get() d'un élément, ou parcours complet d'un instantané) et 99e centile de la latence par paquet de 16 lectures, en ns ; puis débit de l'écrivain en écritures par seconde, pour une écriture d'un élément (set()) et pour la réécriture de tous les éléments en une seule écriture groupée (update()).
+ *
+ * Chaque mesure sert aussi de test de charge : l'écrivain donne à tous les éléments la même valeur à chaque écriture, et les lecteurs vérifient qu'un instantané ne mélange jamais deux écritures. Toute anomalie est signalée par "ERREUR" et fait échouer le programme.
+ *
+ * Usage : bench_cow_vector [N] [Rmax] [ms]   (N éléments, jusqu'à Rmax lecteurs, durée de chaque mesure en ms)
+ *
+ * Compilation : g++ -std=c++17 -O2 -pthread -I.. bench_cow_vector.cpp -o bench_cow_vector
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <shared_mutex>
+#include <thread>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../sort.hpp"
+#include "../copyonwritevector.hpp"
+
+#define BATCH 16 //Lectures par mesure de latence
+
+/**
+ * Table de référence : un Vector et un verrou lecteurs / écrivain
+ */
+class LockedVector
+{
+    private:
+        Vector<long> mItems;
+        mutable std::shared_mutex mMutex;
+
+    public:
+        explicit LockedVector(int n) : mItems(n){
+            for(int i = 0; i < n; i++)
+                mItems.append(0);
+        }
+
+        long get(int i) const{
+            std::shared_lock<std::shared_mutex> lock(mMutex);
+            return mItems[i];
+        }
+
+        /**
+         * Somme des éléments, false si elle mélange deux écritures
+         */
+        bool scan(long& sum) const{
+            std::shared_lock<std::shared_mutex> lock(mMutex);
+            sum = 0;
+            for(long x : mItems){
+                if(x != mItems[0])
+                    return false;
+                sum += x;
+            }
+            return true;
+        }
+
+        void set(int i, long x){
+            std::unique_lock<std::shared_mutex> lock(mMutex);
+            mItems[i] = x;
+        }
+
+        void setAll(long x){
+            std::unique_lock<std::shared_mutex> lock(mMutex);
+            for(long& e : mItems)
+                e = x;
+        }
+};
+
+class CowVector
+{
+    private:
+        CopyOnWriteVector<long> mItems;
+
+    public:
+        explicit CowVector(int n){
+            Vector<long> v(n);
+            for(int i = 0; i < n; i++)
+                v.append(0);
+            mItems.assign(v);
+        }
+
+        long get(int i) const{
+            return mItems.get(i);
+        }
+
+        bool scan(long& sum) const{
+            typename CopyOnWriteVector<long>::Snapshot s = mItems.snapshot();
+            sum = 0;
+            for(long x : s){
+                if(x != s[0])
+                    return false;
+                sum += x;
+            }
+            return true;
+        }
+
+        void set(int i, long x){
+            mItems.set(i, x);
+        }
+
+        void setAll(long x){
+            mItems.update([x](Vector<long>& v){
+                for(long& e : v)
+                    e = x;
+            });
+        }
+};
+
+struct ReadStats{
+    double meanNs;
+    double p99Ns; //Par paquet de BATCH lectures
+    double writes; //Écritures par seconde pendant la mesure
+};
+
+/**
+ * R lecteurs lisent la table pendant ms millisecondes (scan : parcours complets, sinon get()) tandis qu'un écrivain la réécrit en boucle (setAll(), ou set() d'un élément si batch vaut false : les parcours ne sont vérifiés qu'avec setAll())
+ */
+template<typename Table>
+ReadStats run(int n, int readers, long ms, bool scan, bool batch, bool& ok){
+    Table table(n);
+    std::atomic<bool> stop(false);
+    std::atomic<bool> error(false);
+    std::atomic<long> writes(0);
+    Vector<double>* samples = new Vector<double>[readers];
+
+    std::thread writer([&]{
+        long version = 1;
+        while(!stop.load(std::memory_order_relaxed)){
+            if(batch)
+                table.setAll(version);
+            else
+                table.set((int)(version % n), version);
+            version++;
+            writes.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    std::thread* threads = new std::thread[readers];
+    for(int r = 0; r < readers; r++){
+        threads[r] = std::thread([&, r]{
+            unsigned x = 12345 + r;
+            long sink = 0;
+            while(!stop.load(std::memory_order_relaxed)){
+                Chrono c;
+                for(int k = 0; k < BATCH; k++){
+                    if(scan){
+                        long sum;
+                        if(!table.scan(sum) && batch)
+                            error = true;
+                        sink += sum;
+                    }else{
+                        x = x*1103515245u + 12345u;
+                        sink += table.get((int)(x % n));
+                    }
+                }
+                samples[r].append(c.elapsedNs());
+            }
+            doNotOptimize(sink);
+        });
+    }
+
+    Chrono c;
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    stop = true;
+    for(int r = 0; r < readers; r++)
+        threads[r].join();
+    writer.join();
+    double elapsed = c.elapsedNs();
+
+    Vector<double> all;
+    for(int r = 0; r < readers; r++){
+        for(double s : samples[r])
+            all.append(s);
+    }
+    std::less<double> less;
+    arraySort(all.data(), all.data() + all.size(), less);
+    double total = 0;
+    for(double s : all)
+        total += s;
+
+    ReadStats stats;
+    stats.meanNs = all.size() == 0 ? 0 : total / all.size() / BATCH;
+    stats.p99Ns = all.size() == 0 ? 0 : all[(int)(all.size() * 0.99)];
+    stats.writes = writes.load() / elapsed * 1e9;
+    if(error.load())
+        ok = false;
+
+    delete[] threads;
+    delete[] samples;
+    return stats;
+}
+
+int main(int argc, char** argv){
+    long n = argOr(argc, argv, 1, 1000);
+    long rMax = argOr(argc, argv, 2, 2*(long)std::thread::hardware_concurrency());
+    long ms = argOr(argc, argv, 3, 300);
+    if(rMax < 1)
+        rMax = 1;
+
+    bool ok = true;
+    std::printf("N = %ld éléments, un écrivain, %ld ms par mesure\n", n, ms);
+    std::printf("Latence des lecteurs en ns (moyenne / p99 par paquet de %d), écritures par seconde\n", BATCH);
+    std::printf("%-8s %-8s %24s %24s %14s %14s\n", "lecteurs", "lecture", "shared_mutex", "CopyOnWrite", "écr. mutex", "écr. COW");
+    for(long r = 1; r <= rMax; r *= 2){
+        for(int scan = 0; scan < 2; scan++){
+            ReadStats a = run<LockedVector>((int)n, (int)r, ms, scan, true, ok);
+            ReadStats b = run<CowVector>((int)n, (int)r, ms, scan, true, ok);
+            std::printf("%-8ld %-8s %11.0f / %10.0f %11.0f / %10.0f %14.0f %14.0f\n", r, scan ? "parcours" : "get", a.meanNs, a.p99Ns, b.meanNs, b.p99Ns, a.writes, b.writes);
+        }
+    }
+
+    std::printf("\nDébit de l'écrivain (écritures par seconde) avec %ld lecteurs get() : set() d'un élément, update() de tous\n", rMax);
+    std::printf("%-14s %14s %14s\n", "", "set()", "update()");
+    ReadStats a1 = run<LockedVector>((int)n, (int)rMax, ms, false, false, ok);
+    ReadStats a2 = run<LockedVector>((int)n, (int)rMax, ms, false, true, ok);
+    ReadStats b1 = run<CowVector>((int)n, (int)rMax, ms, false, false, ok);
+    ReadStats b2 = run<CowVector>((int)n, (int)rMax, ms, false, true, ok);
+    std::printf("%-14s %14.0f %14.0f\n", "shared_mutex", a1.writes, a2.writes);
+    std::printf("%-14s %14.0f %14.0f\n", "CopyOnWrite", b1.writes, b2.writes);
+    std::printf(ok ? "OK\n" : "ERREUR\n");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+/**
+ * Ajouts alternés en début et en fin de liste (la boucle de main.cpp) et fenêtre glissante (append + retrait en tête) : Vector décale tout son tableau à chaque prepend, Deque non.
+ *
+ * Usage : bench_deque [Nmax]
+ */
+
+#include <cstdio>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../deque.hpp"
+
+template<typename L>
+double alternateNs(long n){
+    Chrono c;
+    L l;
+    for(long i = 0; i < n/2; i++){
+        l.append((int)i);
+        l.prepend((int)-i);
+    }
+    doNotOptimize(l.last());
+    return c.elapsedNs() / n;
+}
+
+/**
+ * Fenêtre glissante de taille w sur n valeurs
+ */
+double slidingDequeNs(long n, int w){
+    Chrono c;
+    Deque<int> d;
+    long sum = 0;
+    for(long i = 0; i < n; i++){
+        d.append((int)i);
+        if(d.size() > w)
+            sum += d.removeFirst();
+    }
+    doNotOptimize(sum);
+    return c.elapsedNs() / n;
+}
+
+double slidingVectorNs(long n, int w){
+    Chrono c;
+    Vector<int> v;
+    long sum = 0;
+    for(long i = 0; i < n; i++){
+        v.append((int)i);
+        if(v.size() > w){
+            int e = v.first();
+            v.remove(e);
+            sum += e;
+        }
+    }
+    doNotOptimize(sum);
+    return c.elapsedNs() / n;
+}
+
+int main(int argc, char** argv){
+    long nMax = argOr(argc, argv, 1, 1000000);
+
+    std::printf("append/prepend alternés\n");
+    std::printf("%-10s %14s %14s\n", "N", "Vector ns/op", "Deque ns/op");
+    for(long n = 1000; n <= nMax; n *= 10){
+        double v = n <= 200000 ? alternateNs< Vector<int> >(n) : -1;
+        std::printf("%-10ld %14.2f %14.2f\n", n, v, alternateNs< Deque<int> >(n));
+    }
+
+    std::printf("\nfenêtre glissante (N = %ld)\n", nMax);
+    std::printf("%-10s %14s %14s\n", "fenêtre", "Vector ns/op", "Deque ns/op");
+    for(int w = 16; w <= 65536; w *= 16)
+        std::printf("%-10d %14.2f %14.2f\n", w, slidingVectorNs(nMax, w), slidingDequeNs(nMax, w));
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * Dispatch virtuel (interface List<int>) contre dispatch statique (ListBase, CRTP) pour sommer et rechercher dans 10M entiers.
+ *
+ * Côté virtuel : parcours first()/hasNext()/next(), boucle sur operator[] et itérateur par blocs de List<T>, recherche avec pos(). Côté statique : fold() et indexOf() de ListBase, résolus et inlinés à la compilation.
+ *
+ * Usage : bench_dispatch [N]
+ */
+
+#include <cstdio>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../linkedlist.hpp"
+
+long sumCursor(const List<int>& l){
+    long s = 0;
+    l.first();
+    while(l.hasNext())
+        s += l.next();
+    return s;
+}
+
+long sumIndex(const List<int>& l){
+    long s = 0;
+    int n = l.size();
+    for(int i = 0; i < n; i++)
+        s += l[i];
+    return s;
+}
+
+long sumIterator(const List<int>& l){
+    long s = 0;
+    for(const int& e : l)
+        s += e;
+    return s;
+}
+
+/**
+ * Algorithme générique : toute implémentation de ListBase convient, sans appel virtuel
+ */
+template<typename L>
+long sumStatic(const L& l){
+    return l.fold(0L, [](long acc, int e){ return acc + e; });
+}
+
+template<typename F>
+void measure(const char* name, long n, F f){
+    f(); //Échauffement
+    Chrono c;
+    long r = f();
+    double ms = c.elapsedMs();
+    doNotOptimize(r);
+    std::printf("  %-28s %10.2f ms %8.3f ns/elt\n", name, ms, ms*1e6/n);
+}
+
+template<typename L>
+void run(const char* name, long n, bool indexed){
+    L concrete;
+    for(long i = 0; i < n; i++)
+        concrete.append((int)(i % 1000));
+    concrete.append(-1); //Valeur recherchée, en fin de liste
+    List<int>* l = opaque(&concrete);
+
+    std::printf("%s (N = %ld)\n", name, n);
+    measure("somme first()/next()", n, [&]{ return sumCursor(*l); });
+    if(indexed)
+        measure("somme operator[]", n, [&]{ return sumIndex(*l); });
+    measure("somme List::iterator", n, [&]{ return sumIterator(*l); });
+    measure("somme ListBase::fold", n, [&]{ return sumStatic(concrete); });
+    measure("recherche List::pos", n, [&]{ return (long)l->pos(-1); });
+    measure("recherche ListBase::indexOf", n, [&]{ return (long)concrete.indexOf(-1); });
+}
+
+int main(int argc, char** argv){
+    long n = argOr(argc, argv, 1, 10000000);
+
+    run< Vector<int> >("Vector<int>", n, true);
+    run< PooledLinkedList<int> >("PooledLinkedList<int>", n, false);
+
+    return 0;
+}
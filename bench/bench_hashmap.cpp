@@ -0,0 +1,114 @@
+/**
+ * HashMap<int, int> (pour plusieurs taux de remplissage maximaux) contre std::unordered_map<int, int>, en ns par opération :
+ *  - ajout de N clés aléatoires distinctes dans une table vide (croissance comprise) ;
+ *  - recherche de clés présentes, puis de clés absentes ;
+ *  - suppression de toutes les clés ;
+ *  - ajouts et suppressions mêlés sur une table de taille stable (la suppression sans pierre tombale ne dégrade pas la table).
+ * Les clés à chercher sont tirées dans un ordre aléatoire pour que les accès mémoire ne soient pas prévisibles. À titre de comparaison, la première ligne mesure, jusqu'à N = 100000, la recherche par indexOf() dans un Vector, que remplace une HashMap.
+ *
+ * Usage : bench_hashmap [Nmax]
+ */
+
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../hashmap.hpp"
+
+/**
+ * Opérations communes aux deux tables
+ */
+inline void put(HashMap<int, int>& m, int k, int v){ m.put(k, v); }
+inline void put(std::unordered_map<int, int>& m, int k, int v){ m[k] = v; }
+inline bool has(const HashMap<int, int>& m, int k){ return m.find(k) != nullptr; }
+inline bool has(const std::unordered_map<int, int>& m, int k){ return m.find(k) != m.end(); }
+inline void erase(HashMap<int, int>& m, int k){ m.remove(k); }
+inline void erase(std::unordered_map<int, int>& m, int k){ m.erase(k); }
+
+inline HashMap<int, int> makeMap(HashMap<int, int>*, float load){ return HashMap<int, int>(HASHTABLE_MIN_CAPACITY, load); }
+inline std::unordered_map<int, int> makeMap(std::unordered_map<int, int>*, float){ return std::unordered_map<int, int>(); }
+
+/**
+ * Clés distinctes : les n premières (mélangées) sont insérées, les n suivantes servent de clés absentes
+ */
+Vector<int> distinctKeys(long n){
+    std::mt19937 rng(1);
+    Vector<int> keys((int)(2*n));
+    for(long i = 0; i < 2*n; i++)
+        keys.append((int)(i * 2654435761u)); //Bijection sur les entiers de 32 bits : pas de doublon
+    for(long i = 2*n - 1; i > 0; i--){
+        long j = rng() % (i + 1);
+        std::swap(keys[(int)i], keys[(int)j]);
+    }
+    return keys;
+}
+
+template<typename M>
+void run(const char* name, const Vector<int>& keys, long n, float load){
+    M m = makeMap((M*)nullptr, load);
+    const int* k = keys.data();
+
+    Chrono c;
+    for(long i = 0; i < n; i++)
+        put(m, k[i], (int)i);
+    double insertNs = c.elapsedNs() / n;
+
+    c.reset();
+    long found = 0;
+    for(long i = n - 1; i >= 0; i--)
+        found += has(m, k[i]);
+    double hitNs = c.elapsedNs() / n;
+
+    c.reset();
+    for(long i = 0; i < n; i++)
+        found += has(m, k[n + i]);
+    double missNs = c.elapsedNs() / n;
+    doNotOptimize(found);
+
+    c.reset();
+    for(long i = 0; i < n; i++){ //Fenêtre glissante : on retire une ancienne clé à chaque ajout
+        erase(m, k[i]);
+        put(m, k[n + i], (int)i);
+    }
+    double churnNs = c.elapsedNs() / n;
+
+    c.reset();
+    for(long i = 0; i < n; i++)
+        erase(m, k[n + i]);
+    double eraseNs = c.elapsedNs() / n;
+
+    std::printf("  %-24s %9.1f %9.1f %9.1f %9.1f %9.1f\n", name, insertNs, hitNs, missNs, churnNs, eraseNs);
+}
+
+int main(int argc, char** argv){
+    long nMax = argOr(argc, argv, 1, 4000000);
+
+    static const long sizes[] = {1000, 100000, 1000000, 4000000, 16000000};
+    for(long n : sizes){
+        if(n > nMax)
+            break;
+        Vector<int> keys = distinctKeys(n);
+
+        std::printf("N = %ld %21s %9s %9s %9s %9s   (ns/op)\n", n, "ajout", "trouvé", "absent", "mêlé", "retrait");
+        if(n <= 100000){
+            Vector<int> v(keys.size());
+            for(long i = 0; i < n; i++)
+                v.append(keys[(int)i]);
+            long reps = 2000000 / n + 1;
+            Chrono c;
+            long acc = 0;
+            for(long i = 0; i < reps; i++)
+                acc += v.indexOf(keys[(int)((i * 7919) % n)]); //Positions réparties sur tout le tableau
+            doNotOptimize(acc);
+            std::printf("  %-24s %9s %9.1f\n", "Vector::indexOf", "-", c.elapsedNs() / reps);
+        }
+        run< HashMap<int, int> >("HashMap (max 0.5)", keys, n, 0.5f);
+        run< HashMap<int, int> >("HashMap (max 0.75)", keys, n, 0.75f);
+        run< HashMap<int, int> >("HashMap (max 0.875)", keys, n, 0.875f);
+        run< std::unordered_map<int, int> >("std::unordered_map", keys, n, 0);
+    }
+
+    return 0;
+}
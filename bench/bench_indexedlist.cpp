@@ -0,0 +1,84 @@
+/**
+ * IndexedList (table de hachage valeur -> positions) contre Vector et LinkedList nus :
+ *  - déduplication : on n'ajoute une valeur que si contains() est faux ;
+ *  - recherches pos() de valeurs présentes tirées au hasard ;
+ *  - suppressions par valeur (remove) de valeurs tirées au hasard.
+ *
+ * Les conteneurs nus font ces opérations en O(n) : ils ne sont mesurés que sur un échantillon d'opérations et le temps est ramené à une opération.
+ *
+ * Usage : bench_indexedlist [N]
+ */
+
+#include <cstdio>
+#include <random>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../linkedlist.hpp"
+#include "../indexedlist.hpp"
+
+/**
+ * Déduplication de n valeurs tirées parmi n/2 valeurs possibles, en ns par valeur
+ */
+template<typename L>
+double dedupNs(long n){
+    std::mt19937 rng(1);
+    L l;
+    Chrono c;
+    for(long i = 0; i < n; i++){
+        int v = (int)(rng() % (n/2));
+        if(!l.contains(v))
+            l.append(v);
+    }
+    doNotOptimize(l.size());
+    return c.elapsedNs() / n;
+}
+
+template<typename L>
+double posNs(L& l, long n, long ops){
+    std::mt19937 rng(2);
+    long acc = 0;
+    Chrono c;
+    for(long i = 0; i < ops; i++)
+        acc += l.pos((int)(rng() % n));
+    doNotOptimize(acc);
+    return c.elapsedNs() / ops;
+}
+
+template<typename L>
+double removeNs(L& l, long n, long ops){
+    std::mt19937 rng(3);
+    Chrono c;
+    for(long i = 0; i < ops; i++)
+        l.remove((int)((rng() % (n/ops)) * ops + i)); //Valeurs toutes distinctes et présentes
+    return c.elapsedNs() / ops;
+}
+
+template<typename L>
+void run(const char* name, long n, long ops){
+    if(ops > n)
+        ops = n; //removeNs() répartit les ops valeurs supprimées sur [0, n[
+    L l;
+    for(long i = 0; i < n; i++)
+        l.append((int)i);
+    double p = posNs(l, n, ops);
+    double r = removeNs(l, n, ops);
+    std::printf("%-32s %12.1f %12.1f\n", name, p, r);
+}
+
+int main(int argc, char** argv){
+    long n = argOr(argc, argv, 1, 1000000);
+
+    std::printf("déduplication (ns/valeur)\n");
+    std::printf("  Vector (N = %ld)           %10.1f\n", n/100, dedupNs< Vector<int> >(n/100));
+    std::printf("  IndexedList<Vector> (N = %ld) %10.1f\n", n, dedupNs< IndexedList<int> >(n));
+
+    std::printf("\nN = %ld %23s %12s\n", n, "pos ns/op", "remove ns/op");
+    run< Vector<int> >("Vector", n, 200);
+    run< IndexedList<int> >("IndexedList<Vector>", n, 200);
+    run< IndexedList<int> >("IndexedList<Vector> (x1000 ops)", n, 200000);
+    run< PooledLinkedList<int> >("PooledLinkedList", n, 200);
+    run< IndexedList<int, PooledLinkedList<int> > >("IndexedList<PooledLinkedList>", n, 200);
+
+    return 0;
+}
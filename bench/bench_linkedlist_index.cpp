@@ -0,0 +1,84 @@
+/**
+ * Accès par indice à une LinkedList<int> à travers l'interface List<int> : boucle croissante "for(i...) l[i]", boucle décroissante, accès presque séquentiels (i, i+2, i+1, i+3...) et accès aléatoires. Temps en ns par accès.
+ *
+ * La colonne "avant" refait le parcours de l'ancien operator[] (toujours depuis la tête, en O(i)) ; la colonne "doigt" utilise operator[], qui part de la tête, de la queue ou du dernier noeud atteint. Les sommes obtenues sont comparées : toute différence est signalée par "ERREUR" et fait échouer le programme.
+ *
+ * Usage : bench_linkedlist_index [N]   (l'ancien parcours coûte O(N²) : N reste modeste)
+ */
+
+#include <cstdio>
+#include <iterator>
+#include <random>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../linkedlist.hpp"
+
+/**
+ * Ancien operator[] : parcours depuis la tête
+ */
+int fromHead(const LinkedList<int>& l, int i){
+    return *std::next(l.begin(), i);
+}
+
+long sumFinger(const List<int>& l, const Vector<int>& order){
+    long s = 0;
+    for(int i : order)
+        s += l[i];
+    return s;
+}
+
+long sumFromHead(const LinkedList<int>& l, const Vector<int>& order){
+    long s = 0;
+    for(int i : order)
+        s += fromHead(l, i);
+    return s;
+}
+
+void run(const char* name, const LinkedList<int>& l, const Vector<int>& order, bool& ok){
+    Chrono c;
+    long before = sumFromHead(l, order);
+    double beforeNs = c.elapsedNs() / order.size();
+    c.reset();
+    long after = sumFinger(*opaque(&l), order);
+    double afterNs = c.elapsedNs() / order.size();
+
+    if(before != after)
+        ok = false;
+    std::printf("%-22s %12.1f %12.1f %10.0fx\n", name, beforeNs, afterNs, beforeNs / afterNs);
+}
+
+int main(int argc, char** argv){
+    int n = (int)argOr(argc, argv, 1, 20000);
+
+    LinkedList<int> l;
+    for(int i = 0; i < n; i++)
+        l.append(i * 7 - 3);
+
+    Vector<int> forward(n), backward(n), near(n), random(n);
+    for(int i = 0; i < n; i++){
+        forward.append(i);
+        backward.append(n - 1 - i);
+    }
+    for(int i = 0; i + 3 < n; i += 4){ //i, i+2, i+1, i+3
+        near.append(i);
+        near.append(i + 2);
+        near.append(i + 1);
+        near.append(i + 3);
+    }
+    std::mt19937 rng(1);
+    for(int i = 0; i < n; i++)
+        random.append((int)(rng() % n));
+
+    bool ok = true;
+    std::printf("N = %d, ns par accès\n", n);
+    std::printf("%-22s %12s %12s %11s\n", "", "avant", "doigt", "gain");
+    run("croissant", l, forward, ok);
+    run("décroissant", l, backward, ok);
+    run("presque séquentiel", l, near, ok);
+    run("aléatoire", l, random, ok);
+
+    std::printf(ok ? "OK\n" : "ERREUR\n");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+/**
+ * LinkedList avec un new/delete par noeud contre LinkedList dont les noeuds sont alloués par slabs (PooledLinkedList) :
+ *  - construction puis destruction d'une liste de N éléments ;
+ *  - "churn" : file de taille W où l'on ajoute en fin et retire en tête N fois ;
+ *  - parcours complet d'une liste construite par ajouts alternés en début et en fin.
+ *
+ * Usage : bench_linkedlist_pool [N]
+ */
+
+#include <cstdio>
+
+#include "bench.hpp"
+#include "../linkedlist.hpp"
+
+template<typename L>
+double buildAndDestroyNs(long n){
+    Chrono c;
+    {
+        L l;
+        for(long i = 0; i < n; i++)
+            l.append((int)i);
+        doNotOptimize(l.last());
+    }
+    return c.elapsedNs() / n;
+}
+
+template<typename L>
+double churnNs(long n, int w, long* allocs, long* frees){
+    Chrono c;
+    L l;
+    for(int i = 0; i < w; i++)
+        l.append(i);
+    for(long i = 0; i < n; i++){
+        l.append((int)i);
+        l.remove(l.first()); //L'élément recherché est en tête : retrait en O(1)
+    }
+    doNotOptimize(l.last());
+    double ns = c.elapsedNs() / n;
+    *allocs = l.allocator().allocCount();
+    *frees = l.allocator().freeCount();
+    return ns;
+}
+
+template<typename L>
+double scanNs(long n){
+    L l;
+    for(long i = 0; i < n/2; i++){
+        l.append((int)i);
+        l.prepend((int)i);
+    }
+    Chrono c;
+    long sum = 0;
+    l.first();
+    while(l.hasNext())
+        sum += l.next();
+    doNotOptimize(sum);
+    return c.elapsedNs() / n;
+}
+
+int main(int argc, char** argv){
+    long n = argOr(argc, argv, 1, 2000000);
+
+    std::printf("construction + destruction (N = %ld)\n", n);
+    std::printf("  new/delete : %8.2f ns/élément\n", buildAndDestroyNs< LinkedList<int> >(n));
+    std::printf("  slabs      : %8.2f ns/élément\n", buildAndDestroyNs< PooledLinkedList<int> >(n));
+
+    std::printf("\nchurn (N = %ld)\n", n);
+    std::printf("%-10s %16s %16s %12s %12s\n", "W", "new/delete ns/op", "slabs ns/op", "allocs", "frees");
+    for(int w = 16; w <= 1 << 20; w *= 32){
+        long a1, f1, a2, f2;
+        double heap = churnNs< LinkedList<int> >(n, w, &a1, &f1);
+        double pool = churnNs< PooledLinkedList<int> >(n, w, &a2, &f2);
+        std::printf("%-10d %16.2f %16.2f %12ld %12ld\n", w, heap, pool, a2, f2);
+    }
+
+    std::printf("\nparcours (N = %ld)\n", n);
+    std::printf("  new/delete : %8.2f ns/élément\n", scanNs< LinkedList<int> >(n));
+    std::printf("  slabs      : %8.2f ns/élément\n", scanNs< PooledLinkedList<int> >(n));
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+/**
+ * Coût d'un échec de recherche ou d'accès, avec exception et sans exception, sur un Vector<int> de K éléments (K petit : c'est le déroulement de pile qui domine) :
+ *  - recherche d'un absent : pos() et catch de l'ElementNotFoundException contre indexOf() qui renvoie -1 ;
+ *  - retrait d'un absent : remove() et catch contre tryRemove() qui renvoie false ;
+ *  - lecture hors de la liste : operator[] et catch de l'IndexOutOfBoundsException contre tryGet() qui renvoie un std::optional vide ;
+ *  - vidage de la liste : first() et remove() contre pollFirst().
+ * Temps en ns par opération.
+ *
+ * Les nombres d'échecs comptés de part et d'autre sont comparés : toute différence est signalée par "ERREUR" et fait échouer le programme.
+ *
+ * Usage : bench_lookup_miss [N] [K]
+ */
+
+#include <cstdio>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+
+void report(const char* name, double withNs, double withoutNs){
+    std::printf("%-22s %14.1f %14.1f %8.0fx\n", name, withNs, withoutNs, withNs / withoutNs);
+}
+
+int main(int argc, char** argv){
+    long n = argOr(argc, argv, 1, 200000);
+    int k = (int)argOr(argc, argv, 2, 16);
+
+    Vector<int> v;
+    for(int i = 0; i < k; i++)
+        v.append(i * 2); //Les valeurs impaires sont absentes
+    List<int>& l = *opaque(&v);
+
+    bool ok = true;
+    std::printf("N = %ld, K = %d, ns par opération\n", n, k);
+    std::printf("%-22s %14s %14s %9s\n", "", "exception", "sans", "gain");
+
+    //Recherche d'un absent
+    long misses[2] = {0, 0};
+    Chrono c;
+    for(long i = 0; i < n; i++){
+        try{
+            doNotOptimize(l.pos((int)(2*i + 1)));
+        }catch(ElementNotFoundException<int>&){
+            misses[0]++;
+        }
+    }
+    double withNs = c.elapsedNs() / n;
+    c.reset();
+    for(long i = 0; i < n; i++){
+        if(l.indexOf((int)(2*i + 1)) == -1)
+            misses[1]++;
+    }
+    report("pos / indexOf", withNs, c.elapsedNs() / n);
+    ok = ok && misses[0] == n && misses[1] == n;
+
+    //Retrait d'un absent
+    misses[0] = misses[1] = 0;
+    c.reset();
+    for(long i = 0; i < n; i++){
+        try{
+            l.remove((int)(2*i + 1));
+        }catch(ElementNotFoundException<int>&){
+            misses[0]++;
+        }
+    }
+    withNs = c.elapsedNs() / n;
+    c.reset();
+    for(long i = 0; i < n; i++){
+        if(!l.tryRemove((int)(2*i + 1)))
+            misses[1]++;
+    }
+    report("remove / tryRemove", withNs, c.elapsedNs() / n);
+    ok = ok && misses[0] == n && misses[1] == n && l.size() == k;
+
+    //Lecture hors de la liste
+    misses[0] = misses[1] = 0;
+    c.reset();
+    for(long i = 0; i < n; i++){
+        try{
+            doNotOptimize(l[k + (int)(i & 7)]);
+        }catch(IndexOutOfBoundsException&){
+            misses[0]++;
+        }
+    }
+    withNs = c.elapsedNs() / n;
+    c.reset();
+    for(long i = 0; i < n; i++){
+        if(!l.tryGet(k + (int)(i & 7)))
+            misses[1]++;
+    }
+    report("operator[] / tryGet", withNs, c.elapsedNs() / n);
+    ok = ok && misses[0] == n && misses[1] == n;
+
+    //Vidage de listes de K éléments
+    long rounds = n / k + 1, got[2] = {0, 0};
+    c.reset();
+    for(long r = 0; r < rounds; r++){
+        Vector<int> w(v);
+        List<int>& lw = *opaque(&w);
+        while(true){
+            try{
+                lw.remove(lw.first());
+                got[0]++;
+            }catch(EmptyContainerException&){
+                break;
+            }
+        }
+    }
+    withNs = c.elapsedNs() / (rounds * (k + 1));
+    c.reset();
+    for(long r = 0; r < rounds; r++){
+        Vector<int> w(v);
+        List<int>& lw = *opaque(&w);
+        while(lw.pollFirst())
+            got[1]++;
+    }
+    report("remove / pollFirst", withNs, c.elapsedNs() / (rounds * (k + 1)));
+    ok = ok && got[0] == rounds * k && got[1] == rounds * k;
+
+    std::printf(ok ? "OK\n" : "ERREUR\n");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+/**
+ * Temps de démarrage d'un jeu de données de N doubles : reconstruction d'un Vector<double> à partir d'un fichier texte (l'usage actuel) contre ouverture d'une MappedVector<double> déjà écrite, seule (O(1)) puis suivie d'un premier parcours complet (chargement des pages). Affiche aussi le temps d'écriture de la MappedVector.
+ *
+ * Les sommes des éléments lus par chaque méthode sont comparées : toute différence est signalée par "ERREUR" et fait échouer le programme.
+ *
+ * Usage : bench_mapped_vector [N] [dossier]   (fichiers temporaires créés dans le dossier, /tmp par défaut)
+ *
+ * Compilation : g++ -std=c++17 -O2 -I.. bench_mapped_vector.cpp -o bench_mapped_vector
+ */
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../mappedvector.hpp"
+
+int main(int argc, char** argv){
+    long n = argOr(argc, argv, 1, 10000000);
+    std::string dir = argc > 2 ? argv[2] : "/tmp";
+    std::string text = dir + "/bench_mapped_vector.txt";
+    std::string bin = dir + "/bench_mapped_vector.bin";
+
+    Vector<double> ref((int)n);
+    std::mt19937 rng(1);
+    for(long i = 0; i < n; i++)
+        ref.append((double)(rng() % 1000000) / 8);
+
+    FILE* f = std::fopen(text.c_str(), "w");
+    if(f == nullptr){
+        std::printf("impossible de créer %s\n", text.c_str());
+        return 1;
+    }
+    for(double x : ref)
+        std::fprintf(f, "%.17g\n", x);
+    std::fclose(f);
+
+    std::printf("N = %ld doubles, temps en ms\n", n);
+    bool ok = true;
+
+    Chrono c;
+    {
+        MappedVector<double> v(bin, MAPPED_CREATE);
+        v.append(ref.data(), ref.size());
+        v.flush();
+    }
+    std::printf("%-40s %10.1f\n", "écriture MappedVector + flush()", c.elapsedMs());
+
+    c.reset();
+    Vector<double> parsed;
+    f = std::fopen(text.c_str(), "r");
+    double x;
+    while(std::fscanf(f, "%lf", &x) == 1)
+        parsed.append(x);
+    std::fclose(f);
+    double sumText = parsed.fold(0.0, [](double a, double b){ return a + b; });
+    std::printf("%-40s %10.1f\n", "texte -> Vector (+ parcours)", c.elapsedMs());
+
+    c.reset();
+    MappedVector<double>* v = new MappedVector<double>(bin, MAPPED_READ_ONLY);
+    double openMs = c.elapsedMs();
+    double sumMapped = v->fold(0.0, [](double a, double b){ return a + b; });
+    double firstMs = c.elapsedMs();
+    std::printf("%-40s %10.3f\n", "ouverture MappedVector", openMs);
+    std::printf("%-40s %10.1f\n", "ouverture MappedVector + parcours", firstMs);
+    int size = v->size();
+    delete v;
+
+    if(size != ref.size() || parsed.size() != ref.size() || sumText != sumMapped){
+        std::printf("sommes : texte %.17g, MappedVector %.17g\n", sumText, sumMapped);
+        ok = false;
+    }
+    std::remove(text.c_str());
+    std::remove(bin.c_str());
+    std::printf(ok ? "OK\n" : "ERREUR\n");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+/**
+ * Passage à l'échelle des algorithmes de parallel.hpp sur un Vector<int> de N éléments, pour 1, 2, 4... jusqu'à Tmax threads (réserve de T - 1 threads plus le thread appelant) : temps en ms et accélération par rapport à un thread. La dernière colonne applique une fonction coûteuse (une cinquantaine d'opérations par élément) aux éléments d'une LinkedList de N/10 éléments, découpée par taille.
+ *
+ * Usage : bench_parallel [N] [Tmax]   (Tmax vaut par défaut le nombre de coeurs)
+ *
+ * Compilation : g++ -std=c++17 -O2 -pthread -I.. bench_parallel.cpp -o bench_parallel
+ */
+
+#include <cstdio>
+#include <random>
+#include <thread>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../linkedlist.hpp"
+#include "../parallel.hpp"
+
+/**
+ * Fonction volontairement coûteuse
+ */
+inline int heavy(int x){
+    unsigned h = (unsigned)x;
+    for(int i = 0; i < 16; i++)
+        h = (h ^ (h >> 13)) * 0x5bd1e995u + i;
+    return (int)h;
+}
+
+int main(int argc, char** argv){
+    long n = argOr(argc, argv, 1, 20000000);
+    long tMax = argOr(argc, argv, 2, (long)std::thread::hardware_concurrency());
+    if(tMax < 1)
+        tMax = 1;
+
+    Vector<int> ref((int)n);
+    std::mt19937 rng(1);
+    for(long i = 0; i < n; i++)
+        ref.append((int)(rng() % 1000000));
+    LinkedList<int> list;
+    for(long i = 0; i < n/10; i++)
+        list.append(ref[(int)i]);
+
+    std::printf("N = %ld, temps en ms (accélération)\n", n);
+    std::printf("%-8s %16s %16s %16s %16s %16s\n", "threads", "reduce", "countIf", "transform", "sort", "LinkedList");
+    double base[5] = {0, 0, 0, 0, 0};
+    for(long t = 1; ; t = (2*t > tMax && t < tMax) ? tMax : 2*t){
+        ThreadPool pool((int)t - 1);
+        double ms[5];
+
+        Chrono c;
+        long sum = parallelReduce(ref, 0L, [](long a, long b){ return a + b; }, pool);
+        ms[0] = c.elapsedMs();
+        doNotOptimize(sum);
+
+        c.reset();
+        long even = parallelCountIf(ref, [](int x){ return x % 2 == 0; }, pool);
+        ms[1] = c.elapsedMs();
+        doNotOptimize(even);
+
+        Vector<int> v(ref);
+        c.reset();
+        parallelTransform(v, [](int x){ return 3*x + 1; }, pool);
+        ms[2] = c.elapsedMs();
+
+        c.reset();
+        parallelSort(v, pool);
+        ms[3] = c.elapsedMs();
+        if(!v.isSorted())
+            std::printf("erreur : tableau non trié\n");
+
+        c.reset();
+        parallelForEach(list, [](int& x){ x = heavy(x); }, pool);
+        ms[4] = c.elapsedMs();
+
+        std::printf("%-8ld", t);
+        for(int k = 0; k < 5; k++){
+            if(t == 1)
+                base[k] = ms[k];
+            std::printf(" %9.1f (%4.1fx)", ms[k], base[k] / ms[k]);
+        }
+        std::printf("\n");
+
+        if(t >= tMax)
+            break;
+    }
+
+    return 0;
+}
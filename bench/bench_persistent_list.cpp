@@ -0,0 +1,252 @@
+/**
+ * Instantanés d'un historique qui grandit : on ajoute N événements en tête d'une liste et on en prend un instantané tous les S événements, les W derniers instantanés restant en vie (ils sont entre les mains de lecteurs). Instantané = copie complète d'une LinkedList<int> (appendAll) contre copie d'une PersistentList<int> (O(1), noeuds partagés).
+ *
+ * Mesures : temps total, mémoire vivante au maximum (comptée en remplaçant operator new et delete) ; puis débit avec R threads lecteurs qui prennent sans arrêt l'instantané publié (sous un verrou) et vérifient qu'il est cohérent, pendant que l'écrivain ajoute N événements et publie tous les S événements. Enfin, libération d'une PersistentList de 10M éléments (aucun débordement de pile).
+ *
+ * Toute incohérence est signalée par "ERREUR" et fait échouer le programme.
+ *
+ * Usage : bench_persistent_list [N] [S] [W] [R]
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "../linkedlist.hpp"
+#include "../persistentlist.hpp"
+
+/**
+ * Comptage de la mémoire vivante : chaque bloc est précédé de sa taille
+ */
+static std::atomic<long> gLiveBytes(0);
+static std::atomic<long> gPeakBytes(0);
+
+void* operator new(std::size_t n){
+    void* p = std::malloc(n + 16);
+    if(p == nullptr)
+        throw std::bad_alloc();
+    *static_cast<std::size_t*>(p) = n;
+    long live = gLiveBytes.fetch_add((long)n) + (long)n;
+    long peak = gPeakBytes.load();
+    while(live > peak && !gPeakBytes.compare_exchange_weak(peak, live));
+    return static_cast<char*>(p) + 16;
+}
+
+void operator delete(void* p) noexcept{
+    if(p == nullptr)
+        return;
+    void* base = static_cast<char*>(p) - 16;
+    gLiveBytes.fetch_sub((long)*static_cast<std::size_t*>(base));
+    std::free(base);
+}
+
+void operator delete(void* p, std::size_t) noexcept{
+    operator delete(p);
+}
+
+void resetPeak(){
+    gPeakBytes.store(gLiveBytes.load());
+}
+
+/**
+ * Un instantané est cohérent si ses éléments sont size()-1, size()-2, ..., 0
+ */
+template<typename L>
+bool consistent(const L& l){
+    int expected = l.size() - 1;
+    for(int x : l){
+        if(x != expected--)
+            return false;
+    }
+    return expected == -1;
+}
+
+/**
+ * Copie complète d'une LinkedList
+ */
+LinkedList<int>* deepCopy(const LinkedList<int>& l){
+    LinkedList<int>* c = new LinkedList<int>();
+    c->appendAll(l);
+    return c;
+}
+
+void snapshots(int n, int s, int w, bool& ok){
+    std::printf("Instantanés : %d événements, un instantané tous les %d, %d gardés\n", n, s, w);
+    std::printf("%-16s %12s %16s\n", "", "temps (ms)", "mémoire max (Mo)");
+    {
+        long before = gLiveBytes.load();
+        resetPeak();
+        Chrono c;
+        LinkedList<int> history;
+        std::vector<LinkedList<int>*> kept;
+        for(int i = 0; i < n; i++){
+            history.prepend(i);
+            if((i + 1) % s == 0){
+                kept.push_back(deepCopy(history));
+                if((int)kept.size() > w){
+                    ok = ok && consistent(*kept.front());
+                    delete kept.front();
+                    kept.erase(kept.begin());
+                }
+            }
+        }
+        for(LinkedList<int>* l : kept){
+            ok = ok && consistent(*l);
+            delete l;
+        }
+        std::printf("%-16s %12.1f %16.1f\n", "LinkedList", c.elapsedMs(), (gPeakBytes.load() - before) / 1e6);
+    }
+    {
+        long before = gLiveBytes.load();
+        resetPeak();
+        Chrono c;
+        PersistentList<int> history;
+        std::vector< PersistentList<int> > kept;
+        for(int i = 0; i < n; i++){
+            history.push(i);
+            if((i + 1) % s == 0){
+                kept.push_back(history);
+                if((int)kept.size() > w){
+                    ok = ok && consistent(kept.front());
+                    kept.erase(kept.begin());
+                }
+            }
+        }
+        for(const PersistentList<int>& l : kept)
+            ok = ok && consistent(l);
+        kept.clear();
+        std::printf("%-16s %12.1f %16.1f\n", "PersistentList", c.elapsedMs(), (gPeakBytes.load() - before) / 1e6);
+    }
+}
+
+/**
+ * Débit : l'écrivain publie un instantané tous les s événements, les lecteurs prennent le dernier publié et le vérifient
+ */
+template<typename Slot>
+void readers(const char* name, int n, int s, int r, bool& ok){
+    Slot slot;
+    std::atomic<bool> done(false);
+    std::atomic<long> reads(0);
+    std::atomic<bool> good(true);
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < r; t++){
+        threads.emplace_back([&]{
+            long local = 0;
+            while(!done.load()){
+                if(!slot.takeAndCheck())
+                    good = false;
+                local++;
+            }
+            reads += local;
+        });
+    }
+
+    Chrono c;
+    for(int i = 0; i < n; i++){
+        slot.add(i);
+        if((i + 1) % s == 0)
+            slot.publish();
+    }
+    double ms = c.elapsedMs();
+    done = true;
+    for(std::thread& t : threads)
+        t.join();
+
+    ok = ok && good.load();
+    std::printf("%-16s %12.1f %16.0f\n", name, ms, reads.load() / (ms / 1000));
+}
+
+struct LinkedSlot{
+    LinkedList<int> history;
+    LinkedList<int>* published = new LinkedList<int>();
+    std::mutex m;
+
+    ~LinkedSlot(){
+        delete published;
+    }
+
+    void add(int i){
+        history.prepend(i);
+    }
+
+    void publish(){
+        LinkedList<int>* copy = deepCopy(history);
+        std::lock_guard<std::mutex> lock(m);
+        std::swap(copy, published);
+        delete copy;
+    }
+
+    bool takeAndCheck(){
+        LinkedList<int>* snap;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            snap = deepCopy(*published); //Le lecteur doit copier : la liste publiée peut être libérée à tout moment
+        }
+        bool c = consistent(*snap);
+        delete snap;
+        return c;
+    }
+};
+
+struct PersistentSlot{
+    PersistentList<int> history;
+    PersistentList<int> published;
+    std::mutex m;
+
+    void add(int i){
+        history.push(i);
+    }
+
+    void publish(){
+        std::lock_guard<std::mutex> lock(m);
+        published = history;
+    }
+
+    bool takeAndCheck(){
+        PersistentList<int> snap;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            snap = published;
+        }
+        return snap.size() == 0 || (snap.first() == snap.size() - 1 && snap[snap.size() - 1] == 0);
+    }
+};
+
+int main(int argc, char** argv){
+    int n = (int)argOr(argc, argv, 1, 200000);
+    int s = (int)argOr(argc, argv, 2, 1000);
+    int w = (int)argOr(argc, argv, 3, 16);
+    int r = (int)argOr(argc, argv, 4, 4);
+
+    bool ok = true;
+    snapshots(n, s, w, ok);
+
+    std::printf("\nLecteurs : %d threads, écrivain de %d événements publiant tous les %d\n", r, n, s);
+    std::printf("%-16s %12s %16s\n", "", "écrivain (ms)", "instantanés/s");
+    readers<LinkedSlot>("LinkedList", n, s, r, ok);
+    readers<PersistentSlot>("PersistentList", n, s, r, ok);
+
+    {
+        Chrono c;
+        PersistentList<int>* big = new PersistentList<int>();
+        for(int i = 0; i < 10000000; i++)
+            big->push(i);
+        PersistentList<int> half = *big;
+        for(int i = 0; i < 5000000; i++)
+            half = half.tail();
+        delete big; //Libère les 5M premiers noeuds, les autres restent partagés avec half
+        ok = ok && half.size() == 5000000 && half.first() == 4999999;
+        half = PersistentList<int>();
+        std::printf("\nConstruction et libération de 10M noeuds : %.1f ms\n", c.elapsedMs());
+    }
+
+    std::printf(ok ? "OK\n" : "ERREUR\n");
+
+    return ok ? 0 : 1;
+}
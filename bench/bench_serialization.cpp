@@ -0,0 +1,131 @@
+/**
+ * Sauvegarde et relecture de N éléments : format texte (operator<< de List, relu avec >>) contre format binaire de serialization.hpp, pour un Vector<int>, une LinkedList<int> et un Vector<std::string>. Temps en ms et taille des fichiers.
+ *
+ * Chaque liste relue est comparée à l'originale : toute différence est signalée par "ERREUR" et fait échouer le programme.
+ *
+ * Usage : bench_serialization [N] [dossier]   (fichiers temporaires créés dans le dossier, /tmp par défaut)
+ *
+ * Compilation : g++ -std=c++17 -O2 -I.. bench_serialization.cpp -o bench_serialization
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../linkedlist.hpp"
+#include "../serialization.hpp"
+
+long fileSize(const std::string& path){
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return (long)in.tellg();
+}
+
+/**
+ * Écriture texte : operator<< de List ("{a, b, c}")
+ */
+template<typename T>
+void saveText(const std::string& path, const List<T>& l){
+    std::ofstream out(path);
+    out << l;
+}
+
+/**
+ * Relecture du format texte : on saute les séparateurs et on lit les éléments avec >>
+ */
+template<typename L>
+void loadText(const std::string& path, L& l){
+    std::ifstream in(path);
+    char c;
+    in >> c; //'{'
+    int x;
+    while(in >> x){
+        l.append(x);
+        in >> c; //',' ou '}'
+    }
+}
+
+template<typename L>
+bool sameAs(const L& a, const Vector<int>& ref){
+    if(a.size() != ref.size())
+        return false;
+    int i = 0;
+    for(int x : a){
+        if(x != ref.data()[i++])
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Mesure texte et binaire pour une liste de type L contenant les éléments de ref
+ */
+template<typename L>
+void run(const char* name, const Vector<int>& ref, const std::string& dir, bool& ok){
+    L l;
+    for(int x : ref)
+        l.append(x);
+    std::string text = dir + "/bench_serialization.txt";
+    std::string bin = dir + "/bench_serialization.bin";
+
+    Chrono c;
+    saveText(text, l);
+    double saveTextMs = c.elapsedMs();
+    c.reset();
+    L t;
+    loadText(text, t);
+    double loadTextMs = c.elapsedMs();
+
+    c.reset();
+    saveList(bin, l);
+    double saveBinMs = c.elapsedMs();
+    c.reset();
+    L b;
+    loadList(bin, b);
+    double loadBinMs = c.elapsedMs();
+
+    if(!sameAs(t, ref) || !sameAs(b, ref))
+        ok = false;
+    std::printf("%-22s %10.1f %10.1f %12ld %10.1f %10.1f %12ld\n", name, saveTextMs, loadTextMs, fileSize(text), saveBinMs, loadBinMs, fileSize(bin));
+    std::remove(text.c_str());
+    std::remove(bin.c_str());
+}
+
+int main(int argc, char** argv){
+    long n = argOr(argc, argv, 1, 5000000);
+    std::string dir = argc > 2 ? argv[2] : "/tmp";
+
+    Vector<int> ref((int)n);
+    std::mt19937 rng(1);
+    for(long i = 0; i < n; i++)
+        ref.append((int)(rng() % 2000000) - 1000000);
+
+    bool ok = true;
+    std::printf("N = %ld, temps en ms, tailles en octets\n", n);
+    std::printf("%-22s %10s %10s %12s %10s %10s %12s\n", "", "texte <<", "texte >>", "taille", "saveList", "loadList", "taille");
+    run< Vector<int> >("Vector<int>", ref, dir, ok);
+    run< LinkedList<int> >("LinkedList<int>", ref, dir, ok);
+
+    //Chaînes : codage élément par élément (Serializer<std::string>)
+    Vector<std::string> words((int)(n/10));
+    for(long i = 0; i < n/10; i++)
+        words.append("mot" + std::to_string(ref.data()[i]));
+    std::string bin = dir + "/bench_serialization.bin";
+    Chrono c;
+    saveList(bin, words);
+    double saveMs = c.elapsedMs();
+    c.reset();
+    Vector<std::string> back;
+    loadList(bin, back);
+    double loadMs = c.elapsedMs();
+    if(back.size() != words.size() || back.last() != words.last() || back.first() != words.first())
+        ok = false;
+    std::printf("%-22s %10s %10s %12s %10.1f %10.1f %12ld\n", "Vector<string> (N/10)", "", "", "", saveMs, loadMs, fileSize(bin));
+    std::remove(bin.c_str());
+
+    std::printf(ok ? "OK\n" : "ERREUR\n");
+
+    return ok ? 0 : 1;
+}
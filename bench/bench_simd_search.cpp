@@ -0,0 +1,64 @@
+/**
+ * Microbenchmarks des noyaux de recherche de simdsearch.hpp (élément absent : parcours complet) pour des tailles de 16 à 100M éléments, en int et en float : boucle scalaire, SSE2, AVX2 (si disponible) et Vector::indexOf (choix automatique). count() est mesuré à part.
+ *
+ * Usage : bench_simd_search [Nmax]
+ */
+
+#include <cstdio>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+
+/**
+ * Temps moyen en ns par élément d'un appel à f, répété de façon à parcourir au moins 200M éléments
+ */
+template<typename F>
+double perElementNs(long n, F f){
+    long reps = 200000000 / n;
+    if(reps < 1)
+        reps = 1;
+    f();
+    Chrono c;
+    long acc = 0;
+    for(long r = 0; r < reps; r++){
+        acc += f();
+        doNotOptimize(acc); //Empêche de sortir l'appel (pur) de la boucle
+    }
+    doNotOptimize(acc);
+    return c.elapsedNs() / ((double)reps * n);
+}
+
+template<typename T>
+void run(const char* name, long nMax){
+    std::printf("%s\n%-11s %9s %9s %9s %9s %9s   (ns/élément)\n", name, "N", "scalaire", "SSE2", "AVX2", "indexOf", "count");
+    static const long sizes[] = {16, 256, 4096, 65536, 1000000, 10000000, 100000000};
+    for(long n : sizes){
+        if(n > nMax)
+            break;
+        Vector<T> v((int)n);
+        for(long i = 0; i < n; i++)
+            v.append((T)(i % 1000));
+        const T* p = v.data();
+        T absent = (T)-1;
+
+        double scalar = perElementNs(n, [&]{ return (long)scalarIndexOf(p, (int)n, absent); });
+#ifdef LIST_SIMD_X86
+        double sse2 = perElementNs(n, [&]{ return (long)sse2IndexOf(p, (int)n, absent); });
+        double avx2 = cpuHasAvx2() ? perElementNs(n, [&]{ return (long)avx2IndexOf(p, (int)n, absent); }) : -1;
+#else
+        double sse2 = -1, avx2 = -1;
+#endif
+        double dispatched = perElementNs(n, [&]{ return (long)v.indexOf(absent); });
+        double count = perElementNs(n, [&]{ return (long)v.count((T)7); });
+        std::printf("%-11ld %9.3f %9.3f %9.3f %9.3f %9.3f\n", n, scalar, sse2, avx2, dispatched, count);
+    }
+}
+
+int main(int argc, char** argv){
+    long nMax = argOr(argc, argv, 1, 100000000);
+
+    run<int>("Vector<int>", nMax);
+    run<float>("Vector<float>", nMax);
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * Vecteurs éphémères : on crée M fois un vecteur, on y ajoute K éléments, on le parcourt puis on le détruit, pour K = 0, 2, 4, 8 et 16. Vector<T> (qui alloue toujours LIST_CLUSTER_SIZE cases), SmallVector<T, 8> et std::vector<T>, avec T = int et T = std::string. Temps en ns par vecteur et nombre d'allocations par vecteur (compté en remplaçant operator new).
+ *
+ * Les sommes obtenues sont comparées : toute différence est signalée par "ERREUR" et fait échouer le programme.
+ *
+ * Usage : bench_small_vector [M]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../smallvector.hpp"
+
+static long gAllocations = 0;
+
+void* operator new(std::size_t n){
+    gAllocations++;
+    if(void* p = std::malloc(n == 0 ? 1 : n))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept{
+    std::free(p);
+}
+
+/**
+ * Ajout en fin pour nos vecteurs et pour std::vector
+ */
+template<typename V, typename T>
+void add(V& v, const T& e){
+    v.append(e);
+}
+
+template<typename T>
+void add(std::vector<T>& v, const T& e){
+    v.push_back(e);
+}
+
+long weight(int x){
+    return x;
+}
+
+long weight(const std::string& s){
+    return (long)s.size();
+}
+
+template<typename V, typename T>
+long churn(long m, int k, const T* values, double& ns, double& allocs){
+    long before = gAllocations;
+    long s = 0;
+    Chrono c;
+    for(long i = 0; i < m; i++){
+        V v;
+        for(int j = 0; j < k; j++)
+            add(v, values[j]);
+        for(const T& e : v)
+            s += weight(e);
+        doNotOptimize(v);
+    }
+    ns = c.elapsedNs() / m;
+    allocs = (double)(gAllocations - before) / m;
+    return s;
+}
+
+template<typename T>
+void run(const char* type, long m, const T* values, bool& ok){
+    static const int sizes[] = {0, 2, 4, 8, 16};
+    std::printf("%s\n", type);
+    std::printf("%4s %14s %8s %14s %8s %14s %8s\n", "K", "Vector ns", "allocs", "SmallVector", "allocs", "std::vector", "allocs");
+    for(int k : sizes){
+        double ns[3], allocs[3];
+        long s0 = churn<Vector<T>, T>(m, k, values, ns[0], allocs[0]);
+        long s1 = churn<SmallVector<T, 8>, T>(m, k, values, ns[1], allocs[1]);
+        long s2 = churn<std::vector<T>, T>(m, k, values, ns[2], allocs[2]);
+        if(s0 != s1 || s0 != s2)
+            ok = false;
+        std::printf("%4d %14.1f %8.2f %14.1f %8.2f %14.1f %8.2f\n", k, ns[0], allocs[0], ns[1], allocs[1], ns[2], allocs[2]);
+    }
+}
+
+int main(int argc, char** argv){
+    long m = argOr(argc, argv, 1, 1000000);
+
+    int ints[16];
+    std::string strings[16];
+    for(int i = 0; i < 16; i++){
+        ints[i] = i * 3 + 1;
+        strings[i] = std::string(4 + i % 10, 'a' + i); //Chaînes courtes : pas d'allocation pour la copie (SSO)
+    }
+
+    bool ok = true;
+    std::printf("M = %ld vecteurs, ns et allocations par vecteur\n", m);
+    run("int", m, ints, ok);
+    run("std::string", m / 4, strings, ok);
+
+    std::printf(ok ? "OK\n" : "ERREUR\n");
+
+    return ok ? 0 : 1;
+}
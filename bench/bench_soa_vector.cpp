@@ -0,0 +1,146 @@
+/**
+ * Agrégation sur une colonne d'une table de N enregistrements (timestamp, id, prix, quantité) : Vector<Record> (un tableau de structures de 32 octets, bourrage compris) contre SoAVector<long, int, double, int> (un tableau par champ) :
+ *  - somme des quantités (entiers : la boucle sur la colonne est vectorisée) ;
+ *  - somme des prix (la boucle n'est pas réordonnée sans -ffast-math, seul le volume de mémoire lu change) ;
+ *  - plus grand prix des lignes de quantité > 50 (deux colonnes sur quatre) ;
+ *  - remplissage des N lignes par append().
+ * Chaque agrégation est répétée R fois ; temps en ms et débit utile (octets des champs lus par seconde).
+ *
+ * Les résultats obtenus de part et d'autre sont comparés : toute différence est signalée par "ERREUR" et fait échouer le programme.
+ *
+ * Usage : bench_soa_vector [N] [R]
+ */
+
+#include <cstdio>
+#include <ostream>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../soavector.hpp"
+
+struct Record{
+    long timestamp;
+    int id;
+    double price;
+    int qty;
+
+    bool operator== (const Record& o) const{
+        return timestamp == o.timestamp && id == o.id && price == o.price && qty == o.qty;
+    }
+
+    friend std::ostream& operator<< (std::ostream& flux, const Record& r){
+        return flux << r.id;
+    }
+};
+
+typedef SoAVector<long, int, double, int> Table;
+
+enum{ TIMESTAMP, ID, PRICE, QTY };
+
+void report(const char* name, double aosMs, double soaMs, double usefulBytes){
+    std::printf("%-26s %10.2f %10.2f %7.1fx %10.2f %10.2f\n", name, aosMs, soaMs, aosMs / soaMs, usefulBytes / aosMs / 1e6, usefulBytes / soaMs / 1e6);
+}
+
+long sumQty(const Vector<Record>& v){
+    long s = 0;
+    for(const Record& r : v)
+        s += r.qty;
+    return s;
+}
+
+long sumQty(const Table& t){
+    long s = 0;
+    for(int q : t.column<QTY>())
+        s += q;
+    return s;
+}
+
+double sumPrice(const Vector<Record>& v){
+    double s = 0;
+    for(const Record& r : v)
+        s += r.price;
+    return s;
+}
+
+double sumPrice(const Table& t){
+    double s = 0;
+    for(double p : t.column<PRICE>())
+        s += p;
+    return s;
+}
+
+double maxPrice(const Vector<Record>& v){
+    double m = 0;
+    for(const Record& r : v){
+        if(r.qty > 50 && r.price > m)
+            m = r.price;
+    }
+    return m;
+}
+
+double maxPrice(const Table& t){
+    SoAColumn<const double> price = t.column<PRICE>();
+    SoAColumn<const int> qty = t.column<QTY>();
+    double m = 0;
+    for(int i = 0; i < price.size(); i++){
+        if(qty[i] > 50 && price[i] > m)
+            m = price[i];
+    }
+    return m;
+}
+
+/**
+ * Temps (en ms) de r appels à f, dont on garde le dernier résultat dans *out
+ */
+template<typename R, typename F>
+double timeIt(int r, R* out, F f){
+    Chrono c;
+    for(int k = 0; k < r; k++){
+        *out = f();
+        doNotOptimize(*out);
+    }
+    return c.elapsedMs();
+}
+
+int main(int argc, char** argv){
+    int n = (int)argOr(argc, argv, 1, 2000000);
+    int r = (int)argOr(argc, argv, 2, 20);
+
+    bool ok = true;
+    std::printf("N = %d, R = %d, sizeof(Record) = %d\n", n, r, (int)sizeof(Record));
+    std::printf("%-26s %10s %10s %8s %10s %10s\n", "", "AoS (ms)", "SoA (ms)", "gain", "AoS Go/s", "SoA Go/s");
+
+    Chrono c;
+    Vector<Record> aos;
+    for(int i = 0; i < n; i++)
+        aos.append(Record{1600000000L + i, i, (i * 7919 % 10007) * 0.01, i % 100});
+    double aosMs = c.elapsedMs();
+    c.reset();
+    Table soa;
+    for(int i = 0; i < n; i++)
+        soa.append(1600000000L + i, i, (i * 7919 % 10007) * 0.01, i % 100);
+    report("append", aosMs, c.elapsedMs(), (double)n * (sizeof(long) + 2*sizeof(int) + sizeof(double)));
+
+    long q1 = 0, q2 = 0;
+    aosMs = timeIt(r, &q1, [&aos]{ return sumQty(aos); });
+    report("somme des quantités", aosMs, timeIt(r, &q2, [&soa]{ return sumQty(soa); }), (double)r * n * sizeof(int));
+    ok = ok && q1 == q2;
+
+    double p1 = 0, p2 = 0;
+    aosMs = timeIt(r, &p1, [&aos]{ return sumPrice(aos); });
+    report("somme des prix", aosMs, timeIt(r, &p2, [&soa]{ return sumPrice(soa); }), (double)r * n * sizeof(double));
+    ok = ok && p1 == p2;
+
+    aosMs = timeIt(r, &p1, [&aos]{ return maxPrice(aos); });
+    report("prix max (quantité > 50)", aosMs, timeIt(r, &p2, [&soa]{ return maxPrice(soa); }), (double)r * n * (sizeof(int) + sizeof(double)));
+    ok = ok && p1 == p2;
+
+    for(int i = 0; i < n; i += n / 16 + 1){
+        Record& a = aos[i];
+        ok = ok && soa[i].get<TIMESTAMP>() == a.timestamp && soa[i].get<ID>() == a.id && soa[i].get<PRICE>() == a.price && soa[i].get<QTY>() == a.qty;
+    }
+
+    std::printf(ok ? "OK\n" : "ERREUR\n");
+
+    return ok ? 0 : 1;
+}
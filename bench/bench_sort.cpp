@@ -0,0 +1,66 @@
+/**
+ * Tri de N entiers aléatoires : sort() de chaque liste (version template, puis à travers l'interface List<int>*) contre l'ancienne méthode, qui copie la liste dans un std::vector, le trie avec std::sort et recopie le résultat. Les temps comprennent la copie mais pas la construction de la liste.
+ *
+ * Usage : bench_sort [N]
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../linkedlist.hpp"
+#include "../deque.hpp"
+#include "../unrolledlist.hpp"
+
+template<typename L>
+void fill(L& l, long n){
+    std::mt19937 rng(1);
+    for(long i = 0; i < n; i++)
+        l.append((int)rng());
+}
+
+/**
+ * Mode de tri : 0 pour sort() sur le type concret, 1 pour sort() à travers List<int>*, 2 pour la copie dans un std::vector
+ */
+template<typename L>
+double sortMs(long n, int mode){
+    L l;
+    fill(l, n);
+    Chrono c;
+    if(mode == 0)
+        l.sort();
+    else if(mode == 1)
+        static_cast<List<int>&>(l).sort();
+    else{
+        std::vector<int> tmp(l.begin(), l.end());
+        std::sort(tmp.begin(), tmp.end());
+        int i = 0;
+        for(int& e : l)
+            e = tmp[i++];
+    }
+    double ms = c.elapsedMs();
+    if(!l.isSorted())
+        std::printf("erreur : liste non triée\n");
+    return ms;
+}
+
+template<typename L>
+void run(const char* name, long n){
+    std::printf("%-18s %12.1f %12.1f %12.1f\n", name, sortMs<L>(n, 0), sortMs<L>(n, 1), sortMs<L>(n, 2));
+}
+
+int main(int argc, char** argv){
+    long n = argOr(argc, argv, 1, 2000000);
+
+    std::printf("N = %ld %17s %12s %12s   (ms)\n", n, "sort()", "List*", "std::vector");
+    run< Vector<int> >("Vector", n);
+    run< Deque<int> >("Deque", n);
+    run< LinkedList<int> >("LinkedList", n);
+    run< PooledLinkedList<int> >("PooledLinkedList", n);
+    run< UnrolledList<int> >("UnrolledList", n);
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * Chaîne de traitement paresseuse (stream()) contre une suite de passes qui construisent chacune un Vector temporaire, sur la requête "garder les pairs, les transformer en 3x+1, écarter les multiples de 7" appliquée à N entiers, dans un Vector puis dans une LinkedList :
+ *  - collect() de tout le résultat ;
+ *  - limit(K) puis collect() (la chaîne s'arrête dès le K-ième résultat, les passes traitent toute la liste) ;
+ *  - somme des résultats par reduce().
+ * Temps en ms.
+ *
+ * Les résultats obtenus de part et d'autre sont comparés : toute différence est signalée par "ERREUR" et fait échouer le programme.
+ *
+ * Usage : bench_stream [N] [K]
+ */
+
+#include <cstdio>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../linkedlist.hpp"
+#include "../stream.hpp"
+
+bool same(const Vector<int>& a, const Vector<int>& b){
+    if(a.size() != b.size())
+        return false;
+    for(int i = 0; i < a.size(); i++){
+        if(a[i] != b[i])
+            return false;
+    }
+    return true;
+}
+
+void report(const char* name, double passesMs, double streamMs){
+    std::printf("%-30s %12.2f %12.2f %8.1fx\n", name, passesMs, streamMs, passesMs / streamMs);
+}
+
+/**
+ * La requête en plusieurs passes, limitée aux k premiers résultats (k < 0 : pas de limite)
+ */
+template<typename L>
+Vector<int> passes(const L& l, int k){
+    Vector<int> even;
+    for(int x : l){
+        if(x % 2 == 0)
+            even.append(x);
+    }
+    Vector<int> mapped(even.size());
+    for(int x : even)
+        mapped.append(3*x + 1);
+    Vector<int> kept;
+    for(int x : mapped){
+        if(x % 7 != 0)
+            kept.append(x);
+    }
+    if(k < 0 || kept.size() <= k)
+        return kept;
+    Vector<int> limited(k);
+    limited.appendAll(kept.begin(), kept.begin() + k);
+    return limited;
+}
+
+template<typename L>
+auto query(const L& l){
+    return stream(l).filter([](int x){ return x % 2 == 0; }).map([](int x){ return 3*x + 1; }).filter([](int x){ return x % 7 != 0; });
+}
+
+template<typename L>
+void run(const char* name, const L& l, int k, bool& ok){
+    std::printf("%s\n", name);
+
+    Chrono c;
+    Vector<int> a = passes(l, -1);
+    double passesMs = c.elapsedMs();
+    c.reset();
+    Vector<int> b = query(l).collect();
+    report("  collect", passesMs, c.elapsedMs());
+    ok = ok && same(a, b);
+
+    c.reset();
+    a = passes(l, k);
+    passesMs = c.elapsedMs();
+    c.reset();
+    b = query(l).limit(k).collect();
+    report("  limit + collect", passesMs, c.elapsedMs());
+    ok = ok && same(a, b);
+
+    c.reset();
+    Vector<int> all = passes(l, -1);
+    long s1 = all.fold(0L, [](long acc, int x){ return acc + x; });
+    passesMs = c.elapsedMs();
+    c.reset();
+    long s2 = query(l).reduce(0L, [](long acc, int x){ return acc + x; });
+    report("  reduce", passesMs, c.elapsedMs());
+    doNotOptimize(s2);
+    ok = ok && s1 == s2;
+}
+
+int main(int argc, char** argv){
+    int n = (int)argOr(argc, argv, 1, 2000000);
+    int k = (int)argOr(argc, argv, 2, 100);
+
+    Vector<int> v(n);
+    LinkedList<int> l;
+    for(int i = 0; i < n; i++){
+        v.append(i);
+        l.append(i);
+    }
+
+    bool ok = true;
+    std::printf("N = %d, K = %d, temps en ms\n", n, k);
+    std::printf("%-30s %12s %12s %9s\n", "", "passes", "stream", "gain");
+
+    run("Vector", v, k, ok);
+    run("LinkedList", l, k, ok);
+
+    std::printf(ok ? "OK\n" : "ERREUR\n");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,498 @@
+/**
+ * Suite de mesures comparant les conteneurs de la bibliothèque (Vector, LinkedList, Deque, UnrolledList) à ceux de la STL (std::vector, std::list, std::deque), pour aider à choisir le conteneur adapté à un usage (voir l'en-tête de list.hpp).
+ *
+ * Opérations mesurées, pour chaque type d'élément (int, et Big, une structure de 64 octets) et chaque taille N :
+ * - append : construction d'une liste de N éléments par ajouts en fin ;
+ * - prepend : SUITE_OPS ajouts en tête d'une liste de N éléments ;
+ * - random_access : SUITE_OPS lectures à des positions aléatoires ;
+ * - scan : parcours complet par itérateur ;
+ * - pos : SUITE_OPS recherches d'éléments présents (pos(), std::find pour la STL) ;
+ * - remove : SUITE_OPS suppressions d'éléments présents, par valeur ;
+ * - mixed : SUITE_OPS opérations tirées au hasard (50 % de lectures, 10 % d'ajouts en fin, 10 % en tête, 10 % de recherches, 20 % de suppressions par valeur).
+ *
+ * Chaque mesure est précédée de W exécutions d'échauffement puis répétée R fois sur une liste reconstruite (hors chronométrage) : le résultat donne le temps par opération en ns (minimum, médiane, moyenne, écart type) et, avec --perf, la moyenne par opération des compteurs matériels (voir PerfCounters dans bench.hpp), ou null si le système ne les fournit pas.
+ *
+ * Le résultat est écrit en JSON sur la sortie standard (ou dans un fichier avec --out), la progression sur la sortie d'erreur.
+ *
+ * Usage : bench_suite [--sizes 1000,100000] [--reps 5] [--warmup 1] [--perf] [--filter texte] [--out fichier]
+ *   --filter ne garde que les mesures dont le nom "conteneur/type/opération" contient le texte.
+ *
+ * Compilation : g++ -std=c++17 -O2 -I.. bench_suite.cpp -o bench_suite (ou la cible bench de CMake)
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../linkedlist.hpp"
+#include "../deque.hpp"
+#include "../unrolledlist.hpp"
+
+/**
+ * Nombre d'opérations des mesures dont le coût dépend de N (prepend, random_access, pos, remove, mixed)
+ */
+#ifndef SUITE_OPS
+#define SUITE_OPS 1000
+#endif
+
+/**
+ * Élément de 64 octets
+ */
+struct Big{
+    long v[8];
+
+    bool operator== (const Big& o) const{
+        return v[0] == o.v[0] && std::memcmp(v, o.v, sizeof(v)) == 0;
+    }
+
+    friend std::ostream& operator<< (std::ostream& flux, const Big& b){
+        return flux << b.v[0];
+    }
+};
+
+template<typename T>
+T makeValue(long k);
+
+template<>
+int makeValue<int>(long k){
+    return (int)k;
+}
+
+template<>
+Big makeValue<Big>(long k){
+    Big b;
+    for(int i = 0; i < 8; i++)
+        b.v[i] = k + i;
+    return b;
+}
+
+long checksum(int x){
+    return x;
+}
+
+long checksum(const Big& b){
+    return b.v[0];
+}
+
+/**
+ * Accès uniformes aux conteneurs : ListOps pour les List<T> de la bibliothèque, StdOps pour ceux de la STL
+ */
+template<typename L, typename T>
+struct ListOps{
+    static void append(L& l, const T& e){
+        l.append(e);
+    }
+
+    static void prepend(L& l, const T& e){
+        l.prepend(e);
+    }
+
+    static const T& get(L& l, int i){
+        return l[i];
+    }
+
+    static int pos(L& l, const T& e){
+        return l.pos(e);
+    }
+
+    static void remove(L& l, const T& e){
+        l.remove(e);
+    }
+
+    static int size(const L& l){
+        return l.size();
+    }
+};
+
+template<typename L, typename T>
+struct StdOps{
+    static void append(L& l, const T& e){
+        l.push_back(e);
+    }
+
+    static void prepend(L& l, const T& e){
+        l.insert(l.begin(), e);
+    }
+
+    static const T& get(L& l, int i){
+        return *std::next(l.begin(), i);
+    }
+
+    static int pos(L& l, const T& e){
+        return (int)std::distance(l.begin(), std::find(l.begin(), l.end(), e));
+    }
+
+    static void remove(L& l, const T& e){
+        typename L::iterator it = std::find(l.begin(), l.end(), e);
+        if(it != l.end())
+            l.erase(it);
+    }
+
+    static int size(const L& l){
+        return (int)l.size();
+    }
+};
+
+/**
+ * Chronométrage d'une mesure (et compteurs matériels si demandés)
+ */
+class Probe
+{
+    private:
+        PerfCounters* mPerf;
+        Chrono mChrono;
+        double mNs;
+        long long mCounters[PERF_COUNTERS];
+
+    public:
+        explicit Probe(PerfCounters* perf){
+            mPerf = perf;
+            mNs = 0;
+            for(int i = 0; i < PERF_COUNTERS; i++)
+                mCounters[i] = 0;
+        }
+
+        void start(){
+            if(mPerf != nullptr)
+                mPerf->start();
+            mChrono.reset();
+        }
+
+        void stop(){
+            mNs = mChrono.elapsedNs();
+            if(mPerf != nullptr)
+                mPerf->stop(mCounters);
+        }
+
+        double ns() const{
+            return mNs;
+        }
+
+        long long counter(int i) const{
+            return mCounters[i];
+        }
+};
+
+enum Workload{
+    APPEND,
+    PREPEND,
+    RANDOM_ACCESS,
+    SCAN,
+    POS,
+    REMOVE,
+    MIXED,
+    WORKLOADS
+};
+
+const char* workloadName(int w){
+    static const char* names[WORKLOADS] = {"append", "prepend", "random_access", "scan", "pos", "remove", "mixed"};
+    return names[w];
+}
+
+/**
+ * Liste de n éléments makeValue(0)... makeValue(n - 1)
+ */
+template<typename L, typename T, typename Ops>
+L* build(int n){
+    L* l = new L();
+    for(int i = 0; i < n; i++)
+        Ops::append(*l, makeValue<T>(i));
+    return l;
+}
+
+/**
+ * Exécute une fois l'opération w sur une liste de taille n et renvoie le nombre d'opérations effectuées
+ */
+template<typename L, typename T, typename Ops>
+long runOnce(int w, int n, std::mt19937& rng, Probe& probe){
+    int ops = n < SUITE_OPS ? n : SUITE_OPS;
+    long sink = 0;
+
+    if(w == APPEND){
+        L* l = new L();
+        probe.start();
+        for(int i = 0; i < n; i++)
+            Ops::append(*l, makeValue<T>(i));
+        probe.stop();
+        delete l;
+        return n;
+    }
+
+    L* l = build<L, T, Ops>(n);
+    std::vector<int> idx(ops);
+    for(int k = 0; k < ops; k++)
+        idx[k] = (int)(rng() % (unsigned)n);
+
+    switch(w){
+        case PREPEND:
+            probe.start();
+            for(int k = 0; k < ops; k++)
+                Ops::prepend(*l, makeValue<T>(-k));
+            probe.stop();
+            break;
+
+        case RANDOM_ACCESS:
+            probe.start();
+            for(int k = 0; k < ops; k++)
+                sink += checksum(Ops::get(*l, idx[k]));
+            probe.stop();
+            break;
+
+        case SCAN:
+            ops = n;
+            probe.start();
+            for(const T& e : *l)
+                sink += checksum(e);
+            probe.stop();
+            break;
+
+        case POS:
+            probe.start();
+            for(int k = 0; k < ops; k++)
+                sink += Ops::pos(*l, makeValue<T>(idx[k]));
+            probe.stop();
+            break;
+
+        case REMOVE:{
+            //Valeurs distinctes : les ops premières d'une permutation aléatoire
+            std::vector<int> perm(n);
+            for(int i = 0; i < n; i++)
+                perm[i] = i;
+            std::shuffle(perm.begin(), perm.end(), rng);
+            probe.start();
+            for(int k = 0; k < ops; k++)
+                Ops::remove(*l, makeValue<T>(perm[k]));
+            probe.stop();
+            break;
+        }
+
+        case MIXED:{
+            std::vector<int> kinds(ops);
+            for(int k = 0; k < ops; k++)
+                kinds[k] = (int)(rng() % 10);
+            probe.start();
+            for(int k = 0; k < ops; k++){
+                int size = Ops::size(*l);
+                int i = idx[k] % size;
+                switch(kinds[k]){
+                    case 5:
+                        Ops::append(*l, makeValue<T>(n + k));
+                        break;
+                    case 6:
+                        Ops::prepend(*l, makeValue<T>(n + k));
+                        break;
+                    case 7:
+                        sink += Ops::pos(*l, Ops::get(*l, i));
+                        break;
+                    case 8:
+                    case 9:
+                        if(size > 1)
+                            Ops::remove(*l, T(Ops::get(*l, i)));
+                        break;
+                    default:
+                        sink += checksum(Ops::get(*l, i));
+                }
+            }
+            probe.stop();
+            break;
+        }
+    }
+
+    doNotOptimize(sink);
+    delete l;
+    return ops;
+}
+
+/**
+ * Options de la ligne de commande
+ */
+struct Options{
+    std::vector<int> sizes;
+    int reps;
+    int warmup;
+    bool perf;
+    std::string filter;
+    std::string out;
+};
+
+/**
+ * Écriture du JSON : un objet par mesure dans le tableau "results"
+ */
+class Report
+{
+    private:
+        FILE* mOut;
+        bool mFirst;
+
+    public:
+        Report(FILE* out, const Options& o, const PerfCounters* perf){
+            mOut = out;
+            mFirst = true;
+            std::fprintf(mOut, "{\n  \"suite\": \"CppJavaContainers\",\n");
+#ifdef __VERSION__
+            std::fprintf(mOut, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+            std::fprintf(mOut, "  \"warmup\": %d,\n  \"repetitions\": %d,\n  \"ops\": %d,\n", o.warmup, o.reps, SUITE_OPS);
+            std::fprintf(mOut, "  \"perf\": %s,\n  \"results\": [", perf != nullptr && perf->anyAvailable() ? "true" : "false");
+        }
+
+        void add(const char* container, const char* type, int size, const char* workload, long ops, std::vector<double>& nsPerOp, const double* counters, const PerfCounters* perf){
+            std::sort(nsPerOp.begin(), nsPerOp.end());
+            double mean = 0;
+            for(double x : nsPerOp)
+                mean += x;
+            mean /= nsPerOp.size();
+            double var = 0;
+            for(double x : nsPerOp)
+                var += (x - mean)*(x - mean);
+            double stddev = nsPerOp.size() > 1 ? std::sqrt(var / (nsPerOp.size() - 1)) : 0;
+            int m = (int)nsPerOp.size();
+            double median = m % 2 == 1 ? nsPerOp[m/2] : (nsPerOp[m/2 - 1] + nsPerOp[m/2]) / 2;
+
+            std::fprintf(mOut, "%s\n    {\"container\": \"%s\", \"type\": \"%s\", \"size\": %d, \"workload\": \"%s\", \"ops\": %ld, ", mFirst ? "" : ",", container, type, size, workload, ops);
+            std::fprintf(mOut, "\"ns_per_op\": {\"min\": %.3f, \"median\": %.3f, \"mean\": %.3f, \"stddev\": %.3f}, \"counters\": ", nsPerOp[0], median, mean, stddev);
+            if(perf == nullptr || !perf->anyAvailable()){
+                std::fprintf(mOut, "null}");
+            }else{
+                std::fprintf(mOut, "{");
+                for(int i = 0; i < PERF_COUNTERS; i++){
+                    std::fprintf(mOut, "%s\"%s\": ", i == 0 ? "" : ", ", PerfCounters::name(i));
+                    if(perf->available(i))
+                        std::fprintf(mOut, "%.3f", counters[i]);
+                    else
+                        std::fprintf(mOut, "null");
+                }
+                std::fprintf(mOut, "}}");
+            }
+            mFirst = false;
+            std::fflush(mOut);
+        }
+
+        void close(){
+            std::fprintf(mOut, "\n  ]\n}\n");
+        }
+};
+
+/**
+ * Toutes les opérations pour un conteneur et un type d'élément
+ */
+template<typename L, typename T, typename Ops>
+void runAll(const char* container, const char* type, const Options& o, PerfCounters* perf, Report& report, std::mt19937& rng){
+    for(int n : o.sizes){
+        for(int w = 0; w < WORKLOADS; w++){
+            std::string name = std::string(container) + "/" + type + "/" + workloadName(w);
+            if(!o.filter.empty() && name.find(o.filter) == std::string::npos)
+                continue;
+            std::fprintf(stderr, "%s (N = %d)\n", name.c_str(), n);
+
+            Probe probe(perf);
+            for(int i = 0; i < o.warmup; i++)
+                runOnce<L, T, Ops>(w, n, rng, probe);
+            std::vector<double> nsPerOp;
+            double counters[PERF_COUNTERS] = {0, 0, 0, 0};
+            long ops = 0;
+            for(int r = 0; r < o.reps; r++){
+                ops = runOnce<L, T, Ops>(w, n, rng, probe);
+                nsPerOp.push_back(probe.ns() / ops);
+                for(int i = 0; i < PERF_COUNTERS; i++)
+                    counters[i] += (double)probe.counter(i) / ops / o.reps;
+            }
+            report.add(container, type, n, workloadName(w), ops, nsPerOp, counters, perf);
+        }
+    }
+}
+
+template<typename T>
+void runType(const char* type, const Options& o, PerfCounters* perf, Report& report, std::mt19937& rng){
+    runAll<Vector<T>, T, ListOps<Vector<T>, T> >("Vector", type, o, perf, report, rng);
+    runAll<LinkedList<T>, T, ListOps<LinkedList<T>, T> >("LinkedList", type, o, perf, report, rng);
+    runAll<Deque<T>, T, ListOps<Deque<T>, T> >("Deque", type, o, perf, report, rng);
+    runAll<UnrolledList<T>, T, ListOps<UnrolledList<T>, T> >("UnrolledList", type, o, perf, report, rng);
+    runAll<std::vector<T>, T, StdOps<std::vector<T>, T> >("std::vector", type, o, perf, report, rng);
+    runAll<std::list<T>, T, StdOps<std::list<T>, T> >("std::list", type, o, perf, report, rng);
+    runAll<std::deque<T>, T, StdOps<std::deque<T>, T> >("std::deque", type, o, perf, report, rng);
+}
+
+int main(int argc, char** argv){
+    Options o;
+    o.reps = 5;
+    o.warmup = 1;
+    o.perf = false;
+    for(int i = 1; i < argc; i++){
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if(a == "--sizes" && hasValue){
+            o.sizes.clear();
+            for(const char* p = argv[++i]; *p != '\0'; ){
+                char* end;
+                long n = std::strtol(p, &end, 10);
+                if(end == p)
+                    break;
+                if(n > 0)
+                    o.sizes.push_back((int)n);
+                p = *end == ',' ? end + 1 : end;
+            }
+        }else if(a == "--reps" && hasValue){
+            o.reps = std::atoi(argv[++i]);
+        }else if(a == "--warmup" && hasValue){
+            o.warmup = std::atoi(argv[++i]);
+        }else if(a == "--perf"){
+            o.perf = true;
+        }else if(a == "--filter" && hasValue){
+            o.filter = argv[++i];
+        }else if(a == "--out" && hasValue){
+            o.out = argv[++i];
+        }else{
+            std::fprintf(stderr, "Usage : %s [--sizes 1000,100000] [--reps 5] [--warmup 1] [--perf] [--filter texte] [--out fichier]\n", argv[0]);
+            return 1;
+        }
+    }
+    if(o.sizes.empty()){
+        o.sizes.push_back(1000);
+        o.sizes.push_back(100000);
+    }
+    if(o.reps < 1)
+        o.reps = 1;
+    if(o.warmup < 0)
+        o.warmup = 0;
+
+    PerfCounters* perf = nullptr;
+    if(o.perf){
+        perf = new PerfCounters();
+        if(!perf->anyAvailable())
+            std::fprintf(stderr, "Compteurs matériels indisponibles (perf_event_open refusé) : \"counters\" vaudra null\n");
+    }
+
+    FILE* out = stdout;
+    if(!o.out.empty()){
+        out = std::fopen(o.out.c_str(), "w");
+        if(out == nullptr){
+            std::fprintf(stderr, "Impossible d'ouvrir %s\n", o.out.c_str());
+            return 1;
+        }
+    }
+
+    std::mt19937 rng(42);
+    Report report(out, o, perf);
+    runType<int>("int", o, perf, report, rng);
+    runType<Big>("Big", o, perf, report, rng);
+    report.close();
+
+    if(out != stdout){
+        std::fclose(out);
+        std::fprintf(stderr, "Résultats écrits dans %s\n", o.out.c_str());
+    }
+    delete perf;
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * Débit de parcours (first()/hasNext()/next() et recherche avec pos()) de UnrolledList comparé à LinkedList, PooledLinkedList et Vector, ainsi que le coût d'insertions au milieu de la liste.
+ *
+ * Les listes chaînées sont construites par ajouts alternés en début et en fin de liste, comme dans main.cpp, ce qui disperse leurs noeuds en mémoire.
+ *
+ * Usage : bench_unrolledlist [N]
+ */
+
+#include <cstdio>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+#include "../linkedlist.hpp"
+#include "../unrolledlist.hpp"
+
+template<typename L>
+void fill(L& l, long n){
+    for(long i = 0; i < n/2; i++){
+        l.append((int)i);
+        l.prepend((int)-i - 1);
+    }
+}
+
+/**
+ * Vector::prepend étant en O(n), le Vector est rempli uniquement par ajouts en fin
+ */
+template<>
+void fill(Vector<int>& l, long n){
+    for(long i = 0; i < n; i++)
+        l.append((int)i);
+}
+
+/**
+ * Parcours complet à travers l'interface List<int> (appels virtuels)
+ */
+double scanNs(List<int>& l, long n){
+    Chrono c;
+    long sum = 0;
+    l.first();
+    while(l.hasNext())
+        sum += l.next();
+    doNotOptimize(sum);
+    return c.elapsedNs() / n;
+}
+
+/**
+ * Recherche d'un élément absent (parcours complet par pos())
+ */
+double posNs(List<int>& l, long n){
+    Chrono c;
+    try{
+        l.pos((int)n);
+    }catch(ElementNotFoundException<int>&){
+    }
+    return c.elapsedNs() / n;
+}
+
+template<typename L>
+void run(const char* name, long n){
+    L l;
+    fill(l, n);
+    std::printf("%-18s %12.2f %12.2f\n", name, scanNs(l, n), posNs(l, n));
+}
+
+int main(int argc, char** argv){
+    long n = argOr(argc, argv, 1, 4000000);
+
+    std::printf("N = %ld, %d éléments par noeud d'UnrolledList<int>\n", n, UnrolledList<int>::NODE_CAPACITY);
+    std::printf("%-18s %12s %12s\n", "", "scan ns/elt", "pos ns/elt");
+    run< Vector<int> >("Vector", n);
+    run< LinkedList<int> >("LinkedList", n);
+    run< PooledLinkedList<int> >("PooledLinkedList", n);
+    run< UnrolledList<int> >("UnrolledList", n);
+
+    //Insertions au milieu : seuls les éléments d'un noeud sont décalés
+    long m = n / 100;
+    UnrolledList<int> u;
+    fill(u, m);
+    Chrono c;
+    for(long i = 0; i < m; i++)
+        u.insert(u.size()/2, (int)i);
+    std::printf("\nUnrolledList::insert au milieu (N = %ld -> %d) : %.2f ns/op\n", m, u.size(), c.elapsedNs() / m);
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+/**
+ * Coût amorti de Vector::append selon la politique de croissance du tableau.
+ *
+ * Avec l'ancienne croissance arithmétique (facteur <= 1, LIST_CLUSTER_SIZE cases de plus à chaque fois), le temps par ajout croît linéairement avec N. Avec une croissance géométrique (1.5 ou 2), il reste constant.
+ *
+ * Usage : bench_vector_growth [Nmax]
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+
+template<typename T>
+double appendNs(long n, float growth, bool reserve, T value){
+    Chrono c;
+    Vector<T> v(LIST_CLUSTER_SIZE, growth);
+    if(reserve)
+        v.reserve(n);
+    for(long i = 0; i < n; i++)
+        v.append(value);
+    doNotOptimize(v.last());
+    return c.elapsedNs() / n;
+}
+
+int main(int argc, char** argv){
+    long nMax = argOr(argc, argv, 1, 10000000);
+
+    std::printf("%-10s %14s %14s %14s %14s %16s\n", "N", "linear ns/op", "x1.5 ns/op", "x2 ns/op", "reserve ns/op", "x1.5 string ns/op");
+    for(long n = 1000; n <= nMax; n *= 10){
+        //La croissance arithmétique est quadratique : on ne la mesure que pour des tailles raisonnables
+        double linear = n <= 100000 ? appendNs<int>(n, 1.0f, false, 42) : -1;
+        double g15 = appendNs<int>(n, 1.5f, false, 42);
+        double g2 = appendNs<int>(n, 2.0f, false, 42);
+        double res = appendNs<int>(n, 1.5f, true, 42);
+        double str = appendNs<std::string>(n, 1.5f, false, std::string("a string longer than the SSO buffer"));
+        std::printf("%-10ld %14.2f %14.2f %14.2f %14.2f %16.2f\n", n, linear, g15, g2, res, str);
+    }
+
+    return 0;
+}
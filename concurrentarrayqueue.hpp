@@ -0,0 +1,127 @@
+#ifndef _CONCURRENTARRAYQUEUE_H_
+#define _CONCURRENTARRAYQUEUE_H_
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * File FIFO bornée sans verrou, pour plusieurs producteurs et plusieurs consommateurs (algorithme de D. Vyukov) : la variante tableau de ConcurrentLinkedQueue, dans l'esprit de l'ArrayBlockingQueue de Java mais sans attente : offer() renvoie false si la file est pleine, poll() si elle est vide.
+ *
+ * Les éléments sont rangés dans un tableau circulaire alloué une fois pour toutes : aucune allocation par élément, donc pas de récupération de mémoire à gérer. Chaque case porte un numéro de séquence qui indique à qui elle appartient : pos si elle attend le producteur de la position pos, pos + 1 si elle attend son consommateur. Un producteur réserve une position en incrémentant mEnqueuePos (compare_exchange), écrit l'élément puis publie la case en avançant son numéro ; un consommateur fait de même avec mDequeuePos. Producteurs et consommateurs ne se disputent donc jamais le même compteur, et les deux compteurs sont sur des lignes de cache différentes.
+ *
+ * La capacité est arrondie à la puissance de 2 supérieure.
+ */
+
+template<typename T>
+class ConcurrentArrayQueue
+{
+    private:
+        struct Cell{
+            std::atomic<long> seq;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+            T* val(){
+                return reinterpret_cast<T*>(&storage);
+            }
+        };
+
+        Cell* mCells;
+        long mMask; //Capacité - 1
+        alignas(64) std::atomic<long> mEnqueuePos;
+        alignas(64) std::atomic<long> mDequeuePos; //L'alignement de la classe (64) laisse cette ligne de cache à mDequeuePos seul
+
+    public:
+        explicit ConcurrentArrayQueue(int capacity){
+            long c = 2;
+            while(c < capacity)
+                c *= 2;
+            mMask = c - 1;
+            mCells = new Cell[c];
+            for(long i = 0; i < c; i++)
+                mCells[i].seq.store(i, std::memory_order_relaxed);
+            mEnqueuePos.store(0, std::memory_order_relaxed);
+            mDequeuePos.store(0, std::memory_order_relaxed);
+        }
+
+        ConcurrentArrayQueue(const ConcurrentArrayQueue&) = delete;
+        ConcurrentArrayQueue& operator= (const ConcurrentArrayQueue&) = delete;
+
+        /**
+         * Destructeur : plus aucun thread ne doit utiliser la file
+         */
+        ~ConcurrentArrayQueue(){
+            for(long pos = mDequeuePos.load(); pos != mEnqueuePos.load(); pos++){
+                Cell& c = mCells[pos & mMask];
+                if(c.seq.load() == pos + 1)
+                    c.val()->~T();
+            }
+            delete[] mCells;
+        }
+
+        int capacity() const{
+            return (int)(mMask + 1);
+        }
+
+        /**
+         * Ajoute e en fin de file, renvoie false si la file est pleine
+         */
+        bool offer(T e){
+            long pos = mEnqueuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            for(;;){
+                cell = &mCells[pos & mMask];
+                long dif = cell->seq.load(std::memory_order_acquire) - pos;
+                if(dif == 0){ //Case libre pour la position pos : on tente de la réserver
+                    if(mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if(dif < 0) //La case contient encore l'élément d'il y a un tour : file pleine
+                    return false;
+                else //Un autre producteur a pris cette position
+                    pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+            ::new(static_cast<void*>(cell->val())) T(std::move(e));
+            cell->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Retire l'élément de tête et le place dans out, renvoie false si la file est vide
+         */
+        bool poll(T& out){
+            long pos = mDequeuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            for(;;){
+                cell = &mCells[pos & mMask];
+                long dif = cell->seq.load(std::memory_order_acquire) - (pos + 1);
+                if(dif == 0){
+                    if(mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if(dif < 0) //Le producteur de cette position n'a pas encore publié : file vide
+                    return false;
+                else
+                    pos = mDequeuePos.load(std::memory_order_relaxed);
+            }
+            out = std::move(*cell->val());
+            cell->val()->~T();
+            cell->seq.store(pos + mMask + 1, std::memory_order_release); //La case attend maintenant le producteur du tour suivant
+            return true;
+        }
+
+        /**
+         * Nombre approximatif d'éléments (exact si aucun autre thread n'utilise la file)
+         */
+        int size() const{
+            long n = mEnqueuePos.load() - mDequeuePos.load();
+            return n < 0 ? 0 : (int)n;
+        }
+
+        bool isEmpty() const{
+            return this->size() == 0;
+        }
+};
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef _CONCURRENTLINKEDQUEUE_H_
+#define _CONCURRENTLINKEDQUEUE_H_
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "list.hpp"
+#include "hazardpointer.hpp"
+
+/**
+ * File FIFO sans verrou, utilisable par plusieurs producteurs et plusieurs consommateurs en même temps, au sens de la classe ConcurrentLinkedQueue de Java : offer() ajoute un élément en fin de file, poll() retire celui de tête.
+ *
+ * C'est l'algorithme de Michael et Scott (1996) : une liste simplement chaînée, comme celle de LinkedList, dont le premier noeud est un noeud factice (sa valeur a déjà été consommée ou n'existe pas). mHead désigne ce noeud factice, mTail le dernier noeud ou l'avant-dernier. Toutes les modifications sont des compare_exchange sur un seul pointeur : un thread suspendu au milieu d'une opération ne bloque jamais les autres, qui terminent au besoin son travail (avancer mTail).
+ *
+ * Un noeud retiré de la tête peut encore être lu par un autre thread : il n'est libéré que lorsqu'aucun pointeur de danger ne le désigne plus (voir hazardpointer.hpp).
+ *
+ * size() parcourt la file (O(n)) et n'est qu'indicatif si d'autres threads la modifient en même temps, comme en Java.
+ */
+
+/**
+ * Noeud d'une ConcurrentLinkedQueue : l'équivalent de ListElt dont le pointeur suivant est atomique. La valeur n'est construite que pour les noeuds qui suivent le noeud factice.
+ */
+template<typename T>
+struct ConcurrentListElt{
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    std::atomic<ConcurrentListElt*> next;
+
+    ConcurrentListElt(){
+        next = nullptr;
+    }
+
+    T* val(){
+        return reinterpret_cast<T*>(&storage);
+    }
+
+    static void destroy(void* p){
+        delete static_cast<ConcurrentListElt*>(p);
+    }
+};
+
+template<typename T>
+class ConcurrentLinkedQueue
+{
+    private:
+        typedef ConcurrentListElt<T> Node;
+
+        alignas(64) std::atomic<Node*> mHead; //Noeud factice (les consommateurs)...
+        alignas(64) std::atomic<Node*> mTail; //... et fin de file (les producteurs) sur des lignes de cache différentes
+
+    public:
+        ConcurrentLinkedQueue(){
+            Node* dummy = new Node();
+            mHead = dummy;
+            mTail = dummy;
+        }
+
+        ConcurrentLinkedQueue(const ConcurrentLinkedQueue&) = delete;
+        ConcurrentLinkedQueue& operator= (const ConcurrentLinkedQueue&) = delete;
+
+        /**
+         * Destructeur : plus aucun thread ne doit utiliser la file
+         */
+        ~ConcurrentLinkedQueue(){
+            Node* n = mHead.load();
+            Node* next = n->next.load();
+            delete n;
+            for(n = next; n != nullptr; n = next){
+                next = n->next.load();
+                n->val()->~T();
+                delete n;
+            }
+        }
+
+        /**
+         * Ajoute e en fin de file (la file n'étant pas bornée, renvoie toujours true, comme en Java)
+         */
+        bool offer(T e){
+            Node* node = new Node();
+            ::new(static_cast<void*>(node->val())) T(std::move(e));
+
+            HazardRecord* hp = HazardThread::record();
+            for(;;){
+                Node* tail = hazardProtect(hp, 0, mTail);
+                Node* next = tail->next.load();
+                if(tail != mTail.load())
+                    continue;
+                if(next != nullptr){ //mTail est en retard d'un noeud : on l'avance et on recommence
+                    mTail.compare_exchange_strong(tail, next);
+                    continue;
+                }
+                Node* expected = nullptr;
+                if(tail->next.compare_exchange_weak(expected, node)){
+                    mTail.compare_exchange_strong(tail, node); //Peut échouer si un autre thread l'a déjà fait
+                    break;
+                }
+            }
+            hazardClear(hp, 0);
+            return true;
+        }
+
+        /**
+         * Retire l'élément de tête et le place dans out. Renvoie false (sans modifier out) si la file est vide.
+         */
+        bool poll(T& out){
+            HazardRecord* hp = HazardThread::record();
+            for(;;){
+                Node* head = hazardProtect(hp, 0, mHead);
+                Node* tail = mTail.load();
+                Node* next = hazardProtect(hp, 1, head->next);
+                if(head != mHead.load())
+                    continue; //head a été retiré (et next n'est donc peut-être plus protégé) : on recommence
+                if(next == nullptr){
+                    hazardClear(hp, 0);
+                    hazardClear(hp, 1);
+                    return false;
+                }
+                if(head == tail){ //mTail est en retard : on l'avance avant de retirer la tête
+                    mTail.compare_exchange_strong(tail, next);
+                    continue;
+                }
+                if(mHead.compare_exchange_weak(head, next)){
+                    //next devient le noeud factice : nous seuls pouvons consommer sa valeur, et le pointeur de danger 1 empêche sa libération
+                    out = std::move(*next->val());
+                    next->val()->~T();
+                    hazardClear(hp, 0);
+                    hazardClear(hp, 1);
+                    HazardDomain::global().retire(hp, head, &Node::destroy);
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * Renvoie true si la file était vide au moment de l'appel
+         */
+        bool isEmpty() const{
+            HazardRecord* hp = HazardThread::record();
+            for(;;){
+                Node* head = hazardProtect(hp, 0, mHead);
+                Node* next = head->next.load();
+                if(head == mHead.load()){
+                    hazardClear(hp, 0);
+                    return next == nullptr;
+                }
+            }
+        }
+
+        /**
+         * Nombre d'éléments (parcours de la file, à n'utiliser que lorsque la file n'est pas modifiée)
+         */
+        int size() const{
+            int n = 0;
+            for(Node* p = mHead.load()->next.load(); p != nullptr; p = p->next.load())
+                n++;
+            return n;
+        }
+};
+
+#endif
@@ -0,0 +1,327 @@
+#ifndef _COPYONWRITEVECTOR_H_
+#define _COPYONWRITEVECTOR_H_
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+#include "vector.hpp"
+#include "hazardpointer.hpp"
+
+/**
+ * Vecteur partagé entre threads pour les données lues très souvent et rarement modifiées (tables de configuration, de routage...), au sens de la classe CopyOnWriteArrayList de Java.
+ *
+ * Les éléments sont rangés dans un Vector qui n'est plus jamais modifié une fois publié : une écriture en construit une copie modifiée, puis la publie en remplaçant atomiquement le pointeur mBuffer. Les lecteurs ne prennent donc aucun verrou et voient toujours un état cohérent : celui d'avant ou celui d'après une écriture, jamais un mélange des deux.
+ *
+ * Deux façons de lire :
+ * - get(), size(), indexOf(), read()... lisent le tableau courant sous la protection d'un pointeur de danger (voir hazardpointer.hpp), sans rien écrire dans la mémoire partagée par les lecteurs : des milliers de lecteurs ne se disputent aucune ligne de cache. Elles ne recommencent que si un écrivain publie un tableau au même moment ;
+ * - snapshot() renvoie un instantané (Snapshot) qui garde le tableau en vie par un compteur de références, aussi longtemps qu'on le souhaite, même si d'autres écritures ont lieu entre-temps. Son coût est une opération atomique sur ce compteur.
+ *
+ * Les écrivains sont sérialisés par un verrou. Chaque écriture copie tout le tableau (O(n)) : pour modifier plusieurs éléments, update() applique toutes les modifications à une seule copie et ne publie qu'une fois.
+ *
+ * Un tableau remplacé est libéré lorsque plus aucun instantané ne le référence et qu'aucun lecteur ne le lit.
+ *
+ * Compilation : -pthread.
+ */
+
+template<typename T>
+class CopyOnWriteVector
+{
+    private:
+        /**
+         * Tableau publié et son nombre de références (la CopyOnWriteVector qui le publie et chacun de ses instantanés)
+         */
+        struct Buffer{
+            std::atomic<long> refs;
+            Vector<T> items;
+
+            explicit Buffer(Vector<T>&& v) : items(std::move(v)){
+                refs = 1;
+            }
+
+            static void destroy(void* p){
+                delete static_cast<Buffer*>(p);
+            }
+        };
+
+        std::atomic<Buffer*> mBuffer; //Tableau courant
+        std::mutex mWriteMutex; //Sérialise les écrivains
+
+        /**
+         * Ajoute une référence au tableau courant et le renvoie
+         */
+        Buffer* acquire() const{
+            HazardRecord* hp = HazardThread::record();
+            for(;;){
+                Buffer* b = hazardPush(hp, mBuffer);
+                long r = b->refs.load();
+                while(r > 0 && !b->refs.compare_exchange_weak(r, r + 1));
+                hazardPop(hp);
+                if(r > 0)
+                    return b;
+                //Plus aucune référence : b vient d'être remplacé, on relit mBuffer
+            }
+        }
+
+        /**
+         * Retire une référence à b, qui est confié aux pointeurs de danger lorsque c'était la dernière (un lecteur peut encore être en train de le lire)
+         */
+        static void release(Buffer* b){
+            if(b->refs.fetch_sub(1) == 1)
+                HazardDomain::global().retire(HazardThread::record(), b, &Buffer::destroy);
+        }
+
+        /**
+         * Copie des éléments courants, avec de la place pour extra éléments de plus (mWriteMutex doit être verrouillé)
+         */
+        Vector<T> copy(int extra = 0) const{
+            const Vector<T>& items = mBuffer.load()->items;
+            Vector<T> v(items.size() + extra);
+            for(const T& e : items)
+                v.append(e);
+            return v;
+        }
+
+        /**
+         * Publie v comme nouveau tableau courant (mWriteMutex doit être verrouillé)
+         */
+        void publish(Vector<T>&& v){
+            Buffer* old = mBuffer.exchange(new Buffer(std::move(v)));
+            release(old);
+        }
+
+    public:
+        /**
+         * Instantané du contenu d'une CopyOnWriteVector : un Vector en lecture seule, qui ne change plus, quelles que soient les écritures suivantes
+         */
+        class Snapshot
+        {
+            private:
+                Buffer* mBuffer;
+
+                friend class CopyOnWriteVector;
+
+                explicit Snapshot(Buffer* b){
+                    mBuffer = b;
+                }
+
+            public:
+                Snapshot(const Snapshot& o){
+                    mBuffer = o.mBuffer;
+                    mBuffer->refs++;
+                }
+
+                Snapshot& operator= (Snapshot o){
+                    std::swap(mBuffer, o.mBuffer);
+                    return *this;
+                }
+
+                ~Snapshot(){
+                    CopyOnWriteVector::release(mBuffer);
+                }
+
+                const Vector<T>& items() const{
+                    return mBuffer->items;
+                }
+
+                int size() const{
+                    return mBuffer->items.size();
+                }
+
+                bool isEmpty() const{
+                    return mBuffer->items.size() == 0;
+                }
+
+                T operator[] (int i) const{
+                    return mBuffer->items[i];
+                }
+
+                const T* begin() const{
+                    return mBuffer->items.begin();
+                }
+
+                const T* end() const{
+                    return mBuffer->items.end();
+                }
+
+                int indexOf(const T& t) const{
+                    return mBuffer->items.indexOf(t);
+                }
+
+                bool contains(const T& t) const{
+                    return mBuffer->items.contains(t);
+                }
+        };
+
+        CopyOnWriteVector(){
+            mBuffer = new Buffer(Vector<T>(0));
+        }
+
+        /**
+         * Constructeur à partir du contenu d'un Vector (copié)
+         */
+        explicit CopyOnWriteVector(const Vector<T>& v){
+            mBuffer = new Buffer(Vector<T>(v));
+        }
+
+        /**
+         * Constructeur de copie : les deux CopyOnWriteVector partagent le tableau courant de o jusqu'à la prochaine écriture (O(1))
+         */
+        CopyOnWriteVector(const CopyOnWriteVector<T>& o){
+            mBuffer = o.acquire();
+        }
+
+        CopyOnWriteVector<T>& operator= (const CopyOnWriteVector<T>&) = delete;
+
+        /**
+         * Destructeur : les instantanés encore en vie restent valides
+         */
+        ~CopyOnWriteVector(){
+            release(mBuffer.load());
+        }
+
+        /**
+         * Instantané du contenu courant
+         */
+        Snapshot snapshot() const{
+            return Snapshot(this->acquire());
+        }
+
+        /**
+         * Appelle f(const Vector<T>&) sur le tableau courant, sans le copier ni toucher à son compteur de références, et renvoie son résultat. Le tableau ne peut pas être libéré pendant l'appel, mais f ne doit pas en conserver de référence après son retour (utiliser snapshot() pour cela).
+         *
+         * f peut elle-même lire cette CopyOnWriteVector ou une autre (get(), snapshot(), read()...) : chaque lecture en cours occupe son propre pointeur de danger (voir hazardPush()), jusqu'à HAZARD_SLOTS - HAZARD_FIXED_SLOTS lectures imbriquées, au-delà desquelles read() lance une UnsupportedOperationException.
+         */
+        template<typename F>
+        auto read(F f) const -> decltype(f(std::declval<const Vector<T>&>())){
+            HazardRecord* hp = HazardThread::record();
+            Buffer* b = hazardPush(hp, mBuffer);
+            struct Pop{ //Libère le pointeur de danger au retour de f, qu'elle renvoie une valeur, rien (void) ou lance une exception
+                HazardRecord* hp;
+                ~Pop(){
+                    hazardPop(hp);
+                }
+            } guard{hp};
+            return f(static_cast<const Vector<T>&>(b->items));
+        }
+
+        int size() const{
+            return this->read([](const Vector<T>& v){ return v.size(); });
+        }
+
+        bool isEmpty() const{
+            return this->size() == 0;
+        }
+
+        /**
+         * Copie du i-ème élément (lance une IndexOutOfBoundsException ou une EmptyContainerException comme Vector)
+         */
+        T get(int i) const{
+            return this->read([i](const Vector<T>& v){ return v[i]; });
+        }
+
+        T operator[] (int i) const{
+            return this->get(i);
+        }
+
+        int indexOf(const T& t) const{
+            return this->read([&t](const Vector<T>& v){ return v.indexOf(t); });
+        }
+
+        bool contains(const T& t) const{
+            return this->indexOf(t) != -1;
+        }
+
+        /**
+         * Écritures : chacune publie un nouveau tableau
+         */
+        void append(T e){
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            Vector<T> v = this->copy(1);
+            v.append(std::move(e));
+            this->publish(std::move(v));
+        }
+
+        void prepend(T e){
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            const Vector<T>& items = mBuffer.load()->items;
+            Vector<T> v(items.size() + 1);
+            v.append(std::move(e));
+            for(const T& x : items)
+                v.append(x);
+            this->publish(std::move(v));
+        }
+
+        /**
+         * Remplace le i-ème élément par e (l'indice est toujours vérifié, quel que soit LIST_BOUNDS_CHECK)
+         */
+        void set(int i, T e){
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            int size = mBuffer.load()->items.size();
+            if((unsigned)i >= (unsigned)size)
+                listIndexError(size);
+            Vector<T> v = this->copy();
+            v[i] = std::move(e);
+            this->publish(std::move(v));
+        }
+
+        void removeAt(int i){
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            Vector<T> v = this->copy();
+            v.removeAt(i);
+            this->publish(std::move(v));
+        }
+
+        /**
+         * Retire la première occurrence de e, renvoie false (sans rien publier) s'il n'y en a pas
+         */
+        bool remove(const T& e){
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            int i = mBuffer.load()->items.indexOf(e);
+            if(i == -1)
+                return false;
+            Vector<T> v = this->copy();
+            v.removeAt(i);
+            this->publish(std::move(v));
+            return true;
+        }
+
+        /**
+         * Ajoute e s'il n'est pas déjà présent, renvoie true s'il a été ajouté (addIfAbsent de Java)
+         */
+        bool addIfAbsent(T e){
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            if(mBuffer.load()->items.contains(e))
+                return false;
+            Vector<T> v = this->copy(1);
+            v.append(std::move(e));
+            this->publish(std::move(v));
+            return true;
+        }
+
+        void clear(){
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            this->publish(Vector<T>(0));
+        }
+
+        /**
+         * Remplace tout le contenu par celui de v (une seule publication, sans copie des éléments courants)
+         */
+        void assign(Vector<T> v){
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            this->publish(std::move(v));
+        }
+
+        /**
+         * Écriture groupée : f(Vector<T>&) modifie une copie du contenu courant, publiée en une seule fois à son retour. Les lecteurs voient toutes les modifications de f ou aucune. Si f lance une exception, rien n'est publié.
+         */
+        template<typename F>
+        void update(F f){
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            Vector<T> v = this->copy();
+            f(v);
+            this->publish(std::move(v));
+        }
+};
+
+#endif
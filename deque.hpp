@@ -0,0 +1,446 @@
+#ifndef _DEQUE_H_
+#define _DEQUE_H_
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "list.hpp"
+#include "listbase.hpp"
+#include "simdsearch.hpp"
+
+/**
+ * Liste à double entrée (équivalent de l'ArrayDeque de Java) : les éléments sont stockés dans un tampon circulaire dont la capacité est une puissance de 2. mHead est l'indice du premier élément, le i-ème élément se trouve dans la case (mHead + i) modulo la capacité.
+ *
+ * Contrairement à Vector, un ajout en début de liste ne décale aucun élément : prepend et append sont en O(1) amorti, tout comme le retrait aux deux extrémités (removeFirst(), removeLast()). L'accès au i-ème élément reste en O(1) et les éléments occupent au plus deux blocs contigus du tableau.
+ */
+
+#ifndef DEQUE_MIN_CAPACITY
+#define DEQUE_MIN_CAPACITY 16
+#endif
+
+/**
+ * Itérateur externe sur une Deque (V vaut T ou const T) : indice logique de l'élément courant
+ */
+template<typename T, typename V>
+class DequeIterator
+{
+    private:
+        T* mTab;
+        int mMask; //Capacité - 1
+        int mHead;
+        int mIdx;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V* pointer;
+        typedef V& reference;
+
+        DequeIterator(T* tab, int mask, int head, int idx){
+            mTab = tab;
+            mMask = mask;
+            mHead = head;
+            mIdx = idx;
+        }
+
+        template<typename W>
+        DequeIterator(const DequeIterator<T, W>& o){
+            mTab = o.mTab;
+            mMask = o.mMask;
+            mHead = o.mHead;
+            mIdx = o.mIdx;
+        }
+
+        V& operator* () const{
+            return mTab[(mHead + mIdx) & mMask];
+        }
+
+        V* operator-> () const{
+            return &mTab[(mHead + mIdx) & mMask];
+        }
+
+        DequeIterator& operator++ (){
+            mIdx++;
+            return *this;
+        }
+
+        DequeIterator operator++ (int){
+            DequeIterator ret = *this;
+            mIdx++;
+            return ret;
+        }
+
+        bool operator== (const DequeIterator& o) const{
+            return mIdx == o.mIdx;
+        }
+
+        bool operator!= (const DequeIterator& o) const{
+            return mIdx != o.mIdx;
+        }
+
+        template<typename U, typename W>
+        friend class DequeIterator;
+};
+
+template<typename T>
+class Deque : public List<T>, public ListBase<Deque<T>, T>
+{
+    private:
+        int mSize; //Capacité du tampon (toujours une puissance de 2, ou 0)
+        int mHead; //Indice dans mTab du premier élément
+        int mFilled; //Nombre d'éléments présents
+        mutable int mCursor; //Itérateur (indice logique du dernier élément renvoyé par next())
+        T* mTab; //Mémoire brute, seules les cases correspondant aux indices logiques [0, mFilled[ sont construites
+
+        /**
+         * Indice dans mTab du i-ème élément de la liste
+         */
+        int slot(int i) const{
+            return (mHead + i) & (mSize - 1);
+        }
+
+        static T* allocate(int n){
+            if(n <= 0)
+                return nullptr;
+            return std::allocator<T>().allocate(n);
+        }
+
+        static void deallocate(T* p, int n){
+            if(p != nullptr)
+                std::allocator<T>().deallocate(p, n);
+        }
+
+        /**
+         * Déplace n éléments de src vers la zone brute dst et détruit les originaux (memcpy pour un type trivialement copiable).
+         */
+        static void relocate(T* dst, T* src, int n){
+            if(std::is_trivially_copyable<T>::value){
+                if(n > 0)
+                    std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n*sizeof(T));
+                return;
+            }
+            for(int i = 0; i < n; i++){
+                ::new(static_cast<void*>(dst + i)) T(std::move(src[i]));
+                src[i].~T();
+            }
+        }
+
+        /**
+         * Déplace un élément construit de la case src vers la case brute dst
+         */
+        void moveSlot(int dst, int src){
+            ::new(static_cast<void*>(mTab + dst)) T(std::move(mTab[src]));
+            mTab[src].~T();
+        }
+
+        /**
+         * Remplace le tampon par un tampon de capacité "capacity" (puissance de 2 >= mFilled). Les deux blocs contigus de l'ancien tampon sont remis bout à bout au début du nouveau.
+         */
+        void reallocate(int capacity){
+            LIST_STAT(REALLOCATIONS, 1);
+            LIST_STAT(MOVES, mFilled);
+            T* nTab = allocate(capacity);
+            if(mFilled > 0){
+                int firstPart = mSize - mHead < mFilled ? mSize - mHead : mFilled;
+                relocate(nTab, mTab + mHead, firstPart);
+                relocate(nTab + firstPart, mTab, mFilled - firstPart);
+            }
+            deallocate(mTab, mSize);
+            mTab = nTab;
+            mSize = capacity;
+            mHead = 0;
+        }
+
+        /**
+         * Double la capacité du tampon
+         */
+        void extendTab(){
+            this->reallocate(mSize == 0 ? DEQUE_MIN_CAPACITY : 2*mSize);
+        }
+
+        void release(){
+            if(!std::is_trivially_destructible<T>::value){
+                for(int i = 0; i < mFilled; i++)
+                    mTab[slot(i)].~T();
+            }
+            deallocate(mTab, mSize);
+            mTab = nullptr;
+            mSize = 0;
+            mHead = 0;
+            mFilled = 0;
+        }
+
+    public:
+        typedef DequeIterator<T, T> iterator;
+        typedef DequeIterator<T, const T> const_iterator;
+
+        /**
+         * Constructeur par défaut : aucun tampon n'est alloué avant le premier ajout.
+         */
+        Deque(){
+            mSize = 0;
+            mHead = 0;
+            mFilled = 0;
+            mCursor = -1;
+            mTab = nullptr;
+        }
+
+        Deque(const Deque<T>& o){
+            mSize = 0;
+            mHead = 0;
+            mFilled = 0;
+            mCursor = -1;
+            mTab = nullptr;
+            this->reserve(o.mFilled);
+            LIST_STAT(COPIES, o.mFilled);
+            for(; mFilled < o.mFilled; mFilled++)
+                ::new(static_cast<void*>(mTab + mFilled)) T(o.mTab[o.slot(mFilled)]);
+        }
+
+        Deque(Deque<T>&& o) noexcept{
+            mSize = o.mSize;
+            mHead = o.mHead;
+            mFilled = o.mFilled;
+            mCursor = -1;
+            mTab = o.mTab;
+            o.mTab = nullptr;
+            o.mSize = 0;
+            o.mHead = 0;
+            o.mFilled = 0;
+        }
+
+        Deque<T>& operator= (Deque<T> o){
+            std::swap(mSize, o.mSize);
+            std::swap(mHead, o.mHead);
+            std::swap(mFilled, o.mFilled);
+            std::swap(mTab, o.mTab);
+            mCursor = -1;
+            return *this;
+        }
+
+        ~Deque(){
+            this->release();
+        }
+
+        int size() const{
+            return this->mFilled;
+        }
+
+        int capacity() const{
+            return this->mSize;
+        }
+
+        /**
+         * Garantit que la liste peut contenir n éléments sans réallocation (la capacité est arrondie à la puissance de 2 supérieure).
+         */
+        void reserve(int n){
+            if(n <= mSize)
+                return;
+            int capacity = DEQUE_MIN_CAPACITY;
+            while(capacity < n)
+                capacity *= 2;
+            this->reallocate(capacity);
+        }
+
+        iterator begin(){
+            return iterator(mTab, mSize - 1, mHead, 0);
+        }
+
+        iterator end(){
+            return iterator(mTab, mSize - 1, mHead, mFilled);
+        }
+
+        const_iterator begin() const{
+            return const_iterator(mTab, mSize - 1, mHead, 0);
+        }
+
+        const_iterator end() const{
+            return const_iterator(mTab, mSize - 1, mHead, mFilled);
+        }
+
+        /**
+         * Les éléments forment au plus deux blocs : de mHead à la fin du tampon, puis depuis le début du tampon
+         */
+        void firstChunk(ListChunk<T>& c) const{
+            c.node = nullptr;
+            c.index = 0;
+            if(mFilled == 0){
+                c.begin = nullptr;
+                c.end = nullptr;
+                return;
+            }
+            int firstPart = mSize - mHead < mFilled ? mSize - mHead : mFilled;
+            c.begin = mTab + mHead;
+            c.end = mTab + mHead + firstPart;
+        }
+
+        void nextChunk(ListChunk<T>& c) const{
+            int rest = mFilled - (mSize - mHead);
+            if(c.index == 0 && rest > 0){
+                c.begin = mTab;
+                c.end = mTab + rest;
+                c.index = 1;
+                return;
+            }
+            c.begin = nullptr;
+            c.end = nullptr;
+        }
+
+        void append(T e){
+            if(mFilled == mSize)
+                this->extendTab();
+
+            ::new(static_cast<void*>(mTab + slot(mFilled))) T(std::move(e));
+            mFilled++;
+        }
+
+        void prepend(T e){
+            if(mFilled == mSize)
+                this->extendTab();
+
+            mHead = (mHead - 1) & (mSize - 1);
+            ::new(static_cast<void*>(mTab + mHead)) T(std::move(e));
+            mFilled++;
+        }
+
+        /**
+         * Retire et renvoie le premier élément de la liste
+         */
+        T removeFirst(){
+            if(this->mFilled == 0)
+                throw EmptyContainerException();
+
+            T ret = std::move(mTab[mHead]);
+            mTab[mHead].~T();
+            mHead = (mHead + 1) & (mSize - 1);
+            mFilled--;
+            return ret;
+        }
+
+        /**
+         * Retire et renvoie le dernier élément de la liste
+         */
+        T removeLast(){
+            if(this->mFilled == 0)
+                throw EmptyContainerException();
+
+            int s = slot(mFilled - 1);
+            T ret = std::move(mTab[s]);
+            mTab[s].~T();
+            mFilled--;
+            return ret;
+        }
+
+        T operator[] (int i) const{
+            listCheckIndex(i, this->mFilled);
+
+            return this->mTab[slot(i)];
+        }
+
+        T& operator[] (int i){
+            listCheckIndex(i, this->mFilled);
+
+            return this->mTab[slot(i)];
+        }
+
+        bool hasNext() const{
+            return this->mCursor+1 < this->mFilled;
+        }
+
+        T next() const{
+            if(hasNext()){
+                mCursor++;
+                return this->mTab[slot(this->mCursor)];
+            }
+
+            if(this->mFilled == 0)
+                throw EmptyContainerException();
+
+            throw IndexOutOfBoundsException();
+        }
+
+        T first() const{
+            if(this->mFilled == 0)
+               throw EmptyContainerException();
+
+            mCursor = -1;
+            return this->mTab[mHead];
+        }
+
+        T last() const{
+            if(this->mFilled == 0)
+                throw EmptyContainerException();
+
+            return this->mTab[slot(this->mFilled-1)];
+        }
+
+        /**
+         * Recherche dans chacun des deux blocs contigus du tampon (vectorisée pour les types arithmétiques)
+         */
+        int indexOf(const T& t) const{
+            if(mFilled == 0)
+                return -1;
+            int firstPart = mSize - mHead < mFilled ? mSize - mHead : mFilled;
+            int i = arrayIndexOf(mTab + mHead, firstPart, t);
+            if(i != -1)
+                return i;
+            i = arrayIndexOf(mTab, mFilled - firstPart, t);
+            return i == -1 ? -1 : firstPart + i;
+        }
+
+        void remove(T e){
+            this->removeAt(this->pos(e));
+        }
+
+        /**
+         * Supprime le i-ème élément. On décale le plus petit des deux côtés de la liste : les éléments précédents vers l'avant ou les suivants vers l'arrière.
+         */
+        void removeAt(int i){
+            if(this->mFilled == 0)
+                throw EmptyContainerException();
+
+            if(i < 0 || this->mFilled <= i)
+                throw IndexOutOfBoundsException();
+
+            mTab[slot(i)].~T();
+
+            LIST_STAT(MOVES, i < mFilled/2 ? i : mFilled - 1 - i);
+            LIST_STAT(BYTES_SHIFTED, (i < mFilled/2 ? i : mFilled - 1 - i)*sizeof(T));
+            if(i < mFilled/2){
+                for(int k = i; k > 0; k--)
+                    this->moveSlot(slot(k), slot(k-1));
+                mHead = (mHead + 1) & (mSize - 1);
+            }else{
+                for(int k = i; k < mFilled-1; k++)
+                    this->moveSlot(slot(k), slot(k+1));
+            }
+            mFilled--;
+        }
+
+        /**
+         * Tri en place : si les éléments sont répartis en deux blocs, on les remet d'abord bout à bout au début du tampon, puis on trie ce bloc unique (voir sort.hpp).
+         */
+        template<typename Cmp>
+        void sort(Cmp cmp){
+            if(mHead + mFilled > mSize)
+                this->reallocate(mSize);
+            arraySort(mTab + mHead, mTab + mHead + mFilled, cmp);
+        }
+
+        void sort(const typename List<T>::Comparator& cmp){
+            this->template sort<const typename List<T>::Comparator&>(cmp);
+        }
+
+        void sort(){
+            this->sort(std::less<T>());
+        }
+
+};
+
+#endif
@@ -0,0 +1,285 @@
+#ifndef _HASHMAP_H_
+#define _HASHMAP_H_
+
+#include <functional>
+#include <iostream>
+#include <utility>
+
+#include "list.hpp"
+#include "vector.hpp"
+#include "hashtable.hpp"
+
+/**
+ * Table associative au sens de la classe HashMap de Java : associe à chaque clé de type K au plus une valeur de type V. Les opérations usuelles (put, get, containsKey, remove) se font en temps constant en moyenne, contre O(n) pour un pos() sur une liste.
+ *
+ * Le stockage est une table de hachage à adressage ouvert (voir hashtable.hpp) : les couples clé-valeur sont rangés directement dans un tableau, sans noeud alloué par élément. Conséquence : un ajout peut déplacer tous les éléments (lorsque la table grandit), une suppression peut en déplacer quelques-uns. Les pointeurs, références et itérateurs sur les éléments ne restent donc valables que jusqu'au prochain put() ou remove().
+ *
+ * L'ordre de parcours (itérateurs, forEach, keys(), values()) est celui des cases de la table, il n'a aucun rapport avec l'ordre d'insertion.
+ *
+ * Comme Java, la capacité initiale et le taux de remplissage maximal se passent au constructeur ; un taux plus bas accélère les recherches de clés absentes et les suppressions au prix de la mémoire.
+ */
+
+/**
+ * Couple clé-valeur d'une HashMap (équivalent de Map.Entry en Java) : la clé ne peut pas être modifiée, la valeur si.
+ */
+template<typename K, typename V>
+class HashMapEntry
+{
+    private:
+        K mKey;
+        V mValue;
+
+    public:
+        template<typename KK, typename VV>
+        HashMapEntry(KK&& key, VV&& value) : mKey(std::forward<KK>(key)), mValue(std::forward<VV>(value)){}
+
+        const K& getKey() const{
+            return mKey;
+        }
+
+        V& getValue(){
+            return mValue;
+        }
+
+        const V& getValue() const{
+            return mValue;
+        }
+
+        void setValue(V value){
+            mValue = std::move(value);
+        }
+
+        /**
+         * Accès à la clé pour la table de hachage
+         */
+        struct KeyOf{
+            static const K& key(const HashMapEntry& e){
+                return e.mKey;
+            }
+        };
+};
+
+template<typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K> >
+class HashMap
+{
+    private:
+        typedef HashMapEntry<K, V> Entry;
+        typedef HashTable<Entry, K, typename Entry::KeyOf, Hash, Eq> Table;
+
+        Table mTable;
+
+    public:
+        typedef typename Table::iterator iterator;
+        typedef typename Table::const_iterator const_iterator;
+
+        /**
+         * HashMap pouvant recevoir "capacity" éléments sans grandir, de taux de remplissage maximal maxLoad (dans ]0, 1])
+         */
+        explicit HashMap(int capacity = HASHTABLE_MIN_CAPACITY, float maxLoad = HASHTABLE_MAX_LOAD) : mTable(capacity, maxLoad){}
+
+        int size() const{
+            return mTable.size();
+        }
+
+        bool isEmpty() const{
+            return mTable.size() == 0;
+        }
+
+        /**
+         * Associe value à key (remplace l'ancienne valeur si key était déjà présente). Renvoie true si la clé est nouvelle.
+         */
+        bool put(K key, V value){
+            bool inserted;
+            Entry& e = mTable.findOrEmplace(key, inserted, std::move(key), std::move(value));
+            if(!inserted)
+                e.setValue(std::move(value));
+            return inserted;
+        }
+
+        /**
+         * N'associe value à key que si la clé est absente. Renvoie true si elle a été ajoutée.
+         */
+        bool putIfAbsent(K key, V value){
+            bool inserted;
+            mTable.findOrEmplace(key, inserted, std::move(key), std::move(value));
+            return inserted;
+        }
+
+        /**
+         * Valeur associée à key, ou lance une ElementNotFoundException si la clé est absente
+         */
+        V& get(const K& key){
+            Entry* e = mTable.lookup(key);
+            if(e == nullptr)
+                throw ElementNotFoundException<K>(key);
+            return e->getValue();
+        }
+
+        const V& get(const K& key) const{
+            const Entry* e = mTable.lookup(key);
+            if(e == nullptr)
+                throw ElementNotFoundException<K>(key);
+            return e->getValue();
+        }
+
+        /**
+         * Valeur associée à key, ou def si la clé est absente
+         */
+        V getOrDefault(const K& key, V def) const{
+            const Entry* e = mTable.lookup(key);
+            return e == nullptr ? def : e->getValue();
+        }
+
+        /**
+         * Pointeur vers la valeur associée à key, nullptr si la clé est absente (recherche sans exception ni copie)
+         */
+        V* find(const K& key){
+            Entry* e = mTable.lookup(key);
+            return e == nullptr ? nullptr : &e->getValue();
+        }
+
+        const V* find(const K& key) const{
+            const Entry* e = mTable.lookup(key);
+            return e == nullptr ? nullptr : &e->getValue();
+        }
+
+        /**
+         * Valeur associée à key, créée par le constructeur par défaut de V si la clé est absente (comme pour std::unordered_map). Le V() n'est construit que lors d'une insertion : une clé présente ne coûte qu'une recherche.
+         */
+        V& operator[] (const K& key){
+            Entry* e = mTable.lookup(key);
+            if(e != nullptr)
+                return e->getValue();
+            bool inserted;
+            return mTable.findOrEmplace(key, inserted, key, V()).getValue();
+        }
+
+        bool containsKey(const K& key) const{
+            return mTable.lookup(key) != nullptr;
+        }
+
+        /**
+         * Recherche d'une valeur : parcours complet de la table, O(n)
+         */
+        bool containsValue(const V& value) const{
+            for(const Entry& e : mTable){
+                if(e.getValue() == value)
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * Supprime la clé key et sa valeur, renvoie false si elle était absente
+         */
+        bool remove(const K& key){
+            return mTable.erase(key);
+        }
+
+        void clear(){
+            mTable.clear();
+        }
+
+        /////////////////////////////////////////
+        ////////// RÉGLAGE DE LA TABLE //////////
+        /////////////////////////////////////////
+
+        /**
+         * Nombre de cases de la table
+         */
+        int capacity() const{
+            return mTable.capacity();
+        }
+
+        float loadFactor() const{
+            return mTable.loadFactor();
+        }
+
+        float maxLoadFactor() const{
+            return mTable.maxLoadFactor();
+        }
+
+        void setMaxLoadFactor(float maxLoad){
+            mTable.setMaxLoadFactor(maxLoad);
+        }
+
+        /**
+         * Prépare la table à recevoir n éléments sans grandir
+         */
+        void reserve(int n){
+            mTable.reserve(n);
+        }
+
+        /////////////////////////////////////////
+        ///////// MÉTHODES DE PARCOURS //////////
+        /////////////////////////////////////////
+
+        iterator begin(){
+            return mTable.begin();
+        }
+
+        iterator end(){
+            return mTable.end();
+        }
+
+        const_iterator begin() const{
+            return mTable.begin();
+        }
+
+        const_iterator end() const{
+            return mTable.end();
+        }
+
+        /**
+         * Applique f(clé, valeur) à chaque couple (la valeur est passée par référence)
+         */
+        template<typename F>
+        void forEach(F f){
+            for(Entry& e : mTable)
+                f(e.getKey(), e.getValue());
+        }
+
+        template<typename F>
+        void forEach(F f) const{
+            for(const Entry& e : mTable)
+                f(e.getKey(), e.getValue());
+        }
+
+        /**
+         * Copie des clés, dans l'ordre de parcours
+         */
+        Vector<K> keys() const{
+            Vector<K> v(this->size() > 0 ? this->size() : 1);
+            for(const Entry& e : mTable)
+                v.append(e.getKey());
+            return v;
+        }
+
+        /**
+         * Copie des valeurs, dans l'ordre de parcours
+         */
+        Vector<V> values() const{
+            Vector<V> v(this->size() > 0 ? this->size() : 1);
+            for(const Entry& e : mTable)
+                v.append(e.getValue());
+            return v;
+        }
+
+    /**
+     * Affichage au format de Java : {clé=valeur, ...}
+     */
+    friend std::ostream& operator<< (std::ostream& flux, HashMap const& m){
+        flux << "{";
+        bool firstElt = true;
+        for(const Entry& e : m){
+            if(!firstElt)
+                flux << ", ";
+            flux << e.getKey() << "=" << e.getValue();
+            firstElt = false;
+        }
+        flux << "}";
+        return flux;
+    }
+};
+
+#endif
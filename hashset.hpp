@@ -0,0 +1,143 @@
+#ifndef _HASHSET_H_
+#define _HASHSET_H_
+
+#include <functional>
+#include <iostream>
+#include <utility>
+
+#include "list.hpp"
+#include "vector.hpp"
+#include "hashtable.hpp"
+
+/**
+ * Ensemble au sens de la classe HashSet de Java : chaque valeur y figure au plus une fois, l'ajout, l'appartenance et la suppression se font en temps constant en moyenne.
+ *
+ * Même table de hachage que HashMap (voir hashtable.hpp), mêmes règles : l'ordre de parcours est quelconque, et les itérateurs et références ne restent valables que jusqu'au prochain add() ou remove(). Les éléments ne sont accessibles qu'en lecture, puisque leur valeur détermine leur place dans la table.
+ */
+
+/**
+ * Accès à la clé pour la table de hachage : l'élément est sa propre clé
+ */
+template<typename T>
+struct HashSetKeyOf{
+    static const T& key(const T& e){
+        return e;
+    }
+};
+
+template<typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<T> >
+class HashSet
+{
+    private:
+        typedef HashTable<T, T, HashSetKeyOf<T>, Hash, Eq> Table;
+
+        Table mTable;
+
+    public:
+        typedef typename Table::const_iterator iterator;
+        typedef typename Table::const_iterator const_iterator;
+
+        /**
+         * HashSet pouvant recevoir "capacity" éléments sans grandir, de taux de remplissage maximal maxLoad (dans ]0, 1])
+         */
+        explicit HashSet(int capacity = HASHTABLE_MIN_CAPACITY, float maxLoad = HASHTABLE_MAX_LOAD) : mTable(capacity, maxLoad){}
+
+        int size() const{
+            return mTable.size();
+        }
+
+        bool isEmpty() const{
+            return mTable.size() == 0;
+        }
+
+        /**
+         * Ajoute e s'il n'est pas déjà présent. Renvoie true s'il a été ajouté.
+         */
+        bool add(T e){
+            bool inserted;
+            mTable.findOrEmplace(e, inserted, std::move(e));
+            return inserted;
+        }
+
+        bool contains(const T& e) const{
+            return mTable.lookup(e) != nullptr;
+        }
+
+        /**
+         * Supprime e, renvoie false s'il était absent
+         */
+        bool remove(const T& e){
+            return mTable.erase(e);
+        }
+
+        void clear(){
+            mTable.clear();
+        }
+
+        /////////////////////////////////////////
+        ////////// RÉGLAGE DE LA TABLE //////////
+        /////////////////////////////////////////
+
+        int capacity() const{
+            return mTable.capacity();
+        }
+
+        float loadFactor() const{
+            return mTable.loadFactor();
+        }
+
+        float maxLoadFactor() const{
+            return mTable.maxLoadFactor();
+        }
+
+        void setMaxLoadFactor(float maxLoad){
+            mTable.setMaxLoadFactor(maxLoad);
+        }
+
+        void reserve(int n){
+            mTable.reserve(n);
+        }
+
+        /////////////////////////////////////////
+        ///////// MÉTHODES DE PARCOURS //////////
+        /////////////////////////////////////////
+
+        const_iterator begin() const{
+            return mTable.begin();
+        }
+
+        const_iterator end() const{
+            return mTable.end();
+        }
+
+        template<typename F>
+        void forEach(F f) const{
+            for(const T& e : mTable)
+                f(e);
+        }
+
+        /**
+         * Copie des éléments dans un Vector, dans l'ordre de parcours
+         */
+        Vector<T> toVector() const{
+            Vector<T> v(this->size() > 0 ? this->size() : 1);
+            for(const T& e : mTable)
+                v.append(e);
+            return v;
+        }
+
+    friend std::ostream& operator<< (std::ostream& flux, HashSet const& s){
+        flux << "{";
+        bool firstElt = true;
+        for(const T& e : s){
+            if(!firstElt)
+                flux << ", ";
+            flux << e;
+            firstElt = false;
+        }
+        flux << "}";
+        return flux;
+    }
+};
+
+#endif
@@ -0,0 +1,508 @@
+#ifndef _HASHTABLE_H_
+#define _HASHTABLE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "list.hpp"
+#include "simdsearch.hpp"
+
+/**
+ * Table de hachage à adressage ouvert commune à HashMap<K, V> et HashSet<T> (qui n'en sont que des façades).
+ *
+ * Organisation (dans l'esprit des "SwissTable") : à chaque case de la table correspond un octet de contrôle, rangé dans un tableau à part. Il vaut HASH_EMPTY (bit de poids fort à 1) si la case est libre, et sinon les 7 bits de poids fort du hachage de la clé qu'elle contient (H2). Les 57 autres bits (H1) donnent la case de départ de la clé. Une recherche charge 16 octets de contrôle à partir de la case de départ et les compare d'un coup à H2 (SSE2) : seules les cases dont l'octet correspond, soit en moyenne une sur 128 parmi les occupées, sont comparées à la clé. La recherche s'arrête au premier groupe de 16 qui contient une case libre. Les 16 premiers octets de contrôle sont recopiés après le dernier pour que le groupe d'une case proche de la fin puisse être lu d'un seul bloc.
+ *
+ * Les collisions sont résolues par sondage linéaire case par case, ce qui garantit qu'aucune case libre ne sépare une clé de sa case de départ. La suppression n'a donc pas besoin de pierres tombales : on recule d'une case chaque élément suivant qui peut l'être (suppression par décalage arrière), jusqu'à la prochaine case libre. La table ne se dégrade pas au fil des ajouts et suppressions et n'a jamais besoin d'être reconstruite sans avoir grandi.
+ *
+ * La table double de capacité dès que le nombre d'éléments dépasse capacité * taux de remplissage maximal (HASHTABLE_MAX_LOAD par défaut, réglable avec setMaxLoadFactor()). Un taux bas accélère surtout les recherches infructueuses et les suppressions, au prix de la mémoire : 1 + sizeof(E) octets par case.
+ *
+ * Le hachage fourni par Hash (std::hash par défaut, souvent l'identité pour les entiers) est d'abord mélangé (hashMix()) pour que H1 et H2 dépendent de tous ses bits.
+ *
+ * Paramètres : E est le type rangé dans les cases, K le type de clé, KeyOf fournit "static const K& key(const E&)", Hash et Eq le hachage et l'égalité des clés.
+ */
+
+/**
+ * Capacité minimale (puissance de 2, au moins 16) d'une table de hachage
+ */
+#ifndef HASHTABLE_MIN_CAPACITY
+#define HASHTABLE_MIN_CAPACITY 16
+#endif
+
+/**
+ * Taux de remplissage maximal par défaut (nombre d'éléments / nombre de cases) au-delà duquel la table double de taille
+ */
+#ifndef HASHTABLE_MAX_LOAD
+#define HASHTABLE_MAX_LOAD 0.75f
+#endif
+
+static const signed char HASH_EMPTY = (signed char)0x80; //Octet de contrôle d'une case libre
+static const int HASH_GROUP = 16; //Nombre d'octets de contrôle examinés d'un coup
+
+/**
+ * Mélange des bits d'un hachage (multiplication par une constante impaire puis repli des bits de poids fort sur ceux de poids faible)
+ */
+inline std::uint64_t hashMix(std::uint64_t h){
+    h *= 0x9E3779B97F4A7C15ULL;
+    return h ^ (h >> 32);
+}
+
+/**
+ * Groupe de 16 octets de contrôle : match(h2) renvoie le masque (un bit par case) des cases dont l'octet vaut h2, matchEmpty() celui des cases libres
+ */
+struct HashGroup{
+#ifdef LIST_SIMD_X86
+    __m128i mCtrl;
+
+    explicit HashGroup(const signed char* p){
+        mCtrl = _mm_loadu_si128((const __m128i*)p);
+    }
+
+    unsigned match(signed char h2) const{
+        return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(mCtrl, _mm_set1_epi8(h2)));
+    }
+
+    unsigned matchEmpty() const{
+        return (unsigned)_mm_movemask_epi8(mCtrl); //Seules les cases libres ont leur bit de poids fort à 1
+    }
+#else
+    const signed char* mCtrl;
+
+    explicit HashGroup(const signed char* p){
+        mCtrl = p;
+    }
+
+    unsigned match(signed char h2) const{
+        unsigned m = 0;
+        for(int i = 0; i < HASH_GROUP; i++){
+            if(mCtrl[i] == h2)
+                m |= 1u << i;
+        }
+        return m;
+    }
+
+    unsigned matchEmpty() const{
+        return this->match(HASH_EMPTY);
+    }
+#endif
+};
+
+/**
+ * Itérateur sur les cases occupées d'une table (V vaut E ou const E)
+ */
+template<typename E, typename V>
+class HashTableIterator
+{
+    private:
+        const signed char* mCtrl;
+        E* mSlots;
+        int mIdx;
+        int mCapacity;
+
+        void skipEmpty(){
+            while(mIdx < mCapacity && mCtrl[mIdx] == HASH_EMPTY)
+                mIdx++;
+        }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef E value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V* pointer;
+        typedef V& reference;
+
+        HashTableIterator(){
+            mCtrl = nullptr;
+            mSlots = nullptr;
+            mIdx = 0;
+            mCapacity = 0;
+        }
+
+        HashTableIterator(const signed char* ctrl, E* slots, int idx, int capacity){
+            mCtrl = ctrl;
+            mSlots = slots;
+            mIdx = idx;
+            mCapacity = capacity;
+            this->skipEmpty();
+        }
+
+        template<typename W>
+        HashTableIterator(const HashTableIterator<E, W>& o){
+            mCtrl = o.mCtrl;
+            mSlots = o.mSlots;
+            mIdx = o.mIdx;
+            mCapacity = o.mCapacity;
+        }
+
+        V& operator* () const{
+            return mSlots[mIdx];
+        }
+
+        V* operator-> () const{
+            return mSlots + mIdx;
+        }
+
+        HashTableIterator& operator++ (){
+            mIdx++;
+            this->skipEmpty();
+            return *this;
+        }
+
+        HashTableIterator operator++ (int){
+            HashTableIterator ret = *this;
+            ++(*this);
+            return ret;
+        }
+
+        bool operator== (const HashTableIterator& o) const{
+            return mIdx == o.mIdx;
+        }
+
+        bool operator!= (const HashTableIterator& o) const{
+            return mIdx != o.mIdx;
+        }
+
+        template<typename F, typename W>
+        friend class HashTableIterator;
+};
+
+template<typename E, typename K, typename KeyOf, typename Hash = std::hash<K>, typename Eq = std::equal_to<K> >
+class HashTable
+{
+    private:
+        signed char* mCtrl; //mCapacity + HASH_GROUP octets de contrôle (les HASH_GROUP derniers recopient les premiers)
+        E* mSlots; //Mémoire brute : seules les cases dont l'octet de contrôle n'est pas HASH_EMPTY contiennent un objet construit
+        int mCapacity; //Nombre de cases (puissance de 2)
+        int mCount; //Nombre d'éléments
+        int mGrowthLeft; //Nombre d'éléments que l'on peut encore ajouter avant de doubler la table
+        float mMaxLoad; //Taux de remplissage maximal
+        Hash mHash;
+        Eq mEq;
+
+        static int roundCapacity(int n){
+            int c = HASHTABLE_MIN_CAPACITY < HASH_GROUP ? HASH_GROUP : HASHTABLE_MIN_CAPACITY;
+            while(c < n)
+                c *= 2;
+            return c;
+        }
+
+        std::uint64_t hashOf(const K& k) const{
+            return hashMix((std::uint64_t)mHash(k));
+        }
+
+        static signed char h2(std::uint64_t h){
+            return (signed char)(h >> 57);
+        }
+
+        int home(std::uint64_t h) const{
+            return (int)(h & (std::uint64_t)(mCapacity - 1));
+        }
+
+        /**
+         * Écrit l'octet de contrôle de la case i (et sa copie si i fait partie du premier groupe)
+         */
+        void setCtrl(int i, signed char c){
+            mCtrl[i] = c;
+            if(i < HASH_GROUP)
+                mCtrl[mCapacity + i] = c;
+        }
+
+        /**
+         * Alloue une table vide de "capacity" cases (puissance de 2, au moins HASH_GROUP)
+         */
+        void init(int capacity){
+            mCapacity = capacity;
+            mCount = 0;
+            mCtrl = new signed char[capacity + HASH_GROUP];
+            std::memset(mCtrl, HASH_EMPTY, capacity + HASH_GROUP);
+            mSlots = std::allocator<E>().allocate(capacity);
+            this->resetGrowthLeft();
+        }
+
+        void resetGrowthLeft(){
+            int max = (int)(mCapacity * mMaxLoad);
+            if(max >= mCapacity)
+                max = mCapacity - 1; //Il doit toujours rester une case libre pour que les recherches s'arrêtent
+            mGrowthLeft = max - mCount;
+        }
+
+        /**
+         * Détruit les éléments et libère la table
+         */
+        void release(){
+            if(mSlots == nullptr)
+                return;
+            if(!std::is_trivially_destructible<E>::value){
+                for(int i = 0; i < mCapacity; i++){
+                    if(mCtrl[i] != HASH_EMPTY)
+                        mSlots[i].~E();
+                }
+            }
+            std::allocator<E>().deallocate(mSlots, mCapacity);
+            delete[] mCtrl;
+            mSlots = nullptr;
+            mCtrl = nullptr;
+        }
+
+        /**
+         * Première case libre à partir de la case de départ correspondant au hachage h
+         */
+        int findEmpty(std::uint64_t h) const{
+            int mask = mCapacity - 1;
+            int p = this->home(h);
+            for(;;){
+                unsigned m = HashGroup(mCtrl + p).matchEmpty();
+                if(m != 0)
+                    return (p + __builtin_ctz(m)) & mask;
+                p = (p + HASH_GROUP) & mask;
+            }
+        }
+
+        /**
+         * Case contenant la clé k (de hachage h), -1 si elle est absente
+         */
+        int find(const K& k, std::uint64_t h) const{
+            int mask = mCapacity - 1;
+            signed char tag = h2(h);
+            int p = this->home(h);
+            for(;;){
+                HashGroup g(mCtrl + p);
+                unsigned m = g.match(tag);
+                while(m != 0){
+                    int i = (p + __builtin_ctz(m)) & mask;
+                    if(mEq(KeyOf::key(mSlots[i]), k))
+                        return i;
+                    m &= m - 1;
+                }
+                if(g.matchEmpty() != 0)
+                    return -1;
+                p = (p + HASH_GROUP) & mask;
+            }
+        }
+
+        /**
+         * Remplace la table par une table de "capacity" cases dans laquelle on déplace les éléments
+         */
+        void rehash(int capacity){
+            signed char* oCtrl = mCtrl;
+            E* oSlots = mSlots;
+            int oCapacity = mCapacity;
+            int count = mCount;
+
+            this->init(capacity);
+            for(int i = 0; i < oCapacity; i++){
+                if(oCtrl[i] == HASH_EMPTY)
+                    continue;
+                std::uint64_t h = this->hashOf(KeyOf::key(oSlots[i]));
+                int j = this->findEmpty(h);
+                ::new(static_cast<void*>(mSlots + j)) E(std::move(oSlots[i]));
+                oSlots[i].~E();
+                this->setCtrl(j, h2(h));
+            }
+            mCount = count;
+            this->resetGrowthLeft();
+
+            std::allocator<E>().deallocate(oSlots, oCapacity);
+            delete[] oCtrl;
+        }
+
+        /**
+         * Case libre où ranger une nouvelle clé de hachage h (agrandit la table si nécessaire). L'appelant y construit l'élément.
+         */
+        int prepareInsert(std::uint64_t h){
+            if(mGrowthLeft <= 0)
+                this->rehash(mCapacity * 2);
+            int i = this->findEmpty(h);
+            this->setCtrl(i, h2(h));
+            mCount++;
+            mGrowthLeft--;
+            return i;
+        }
+
+    public:
+        typedef HashTableIterator<E, E> iterator;
+        typedef HashTableIterator<E, const E> const_iterator;
+
+        explicit HashTable(int capacity = HASHTABLE_MIN_CAPACITY, float maxLoad = HASHTABLE_MAX_LOAD){
+            mMaxLoad = maxLoad;
+            if(mMaxLoad <= 0 || mMaxLoad > 1)
+                mMaxLoad = HASHTABLE_MAX_LOAD;
+            this->init(roundCapacity((int)(capacity / mMaxLoad) + 1));
+        }
+
+        HashTable(const HashTable& o) : mHash(o.mHash), mEq(o.mEq){
+            mMaxLoad = o.mMaxLoad;
+            this->init(o.mCapacity);
+            std::memcpy(mCtrl, o.mCtrl, mCapacity + HASH_GROUP);
+            for(int i = 0; i < mCapacity; i++){
+                if(mCtrl[i] != HASH_EMPTY)
+                    ::new(static_cast<void*>(mSlots + i)) E(o.mSlots[i]);
+            }
+            mCount = o.mCount;
+            this->resetGrowthLeft();
+        }
+
+        HashTable(HashTable&& o) : mHash(std::move(o.mHash)), mEq(std::move(o.mEq)){
+            mCtrl = o.mCtrl;
+            mSlots = o.mSlots;
+            mCapacity = o.mCapacity;
+            mCount = o.mCount;
+            mGrowthLeft = o.mGrowthLeft;
+            mMaxLoad = o.mMaxLoad;
+            o.mCtrl = nullptr;
+            o.mSlots = nullptr;
+            o.init(roundCapacity(HASHTABLE_MIN_CAPACITY));
+        }
+
+        HashTable& operator= (HashTable o){
+            this->swap(o);
+            return *this;
+        }
+
+        ~HashTable(){
+            this->release();
+        }
+
+        void swap(HashTable& o){
+            std::swap(mCtrl, o.mCtrl);
+            std::swap(mSlots, o.mSlots);
+            std::swap(mCapacity, o.mCapacity);
+            std::swap(mCount, o.mCount);
+            std::swap(mGrowthLeft, o.mGrowthLeft);
+            std::swap(mMaxLoad, o.mMaxLoad);
+            std::swap(mHash, o.mHash);
+            std::swap(mEq, o.mEq);
+        }
+
+        int size() const{
+            return mCount;
+        }
+
+        /**
+         * Nombre de cases de la table
+         */
+        int capacity() const{
+            return mCapacity;
+        }
+
+        float loadFactor() const{
+            return (float)mCount / mCapacity;
+        }
+
+        float maxLoadFactor() const{
+            return mMaxLoad;
+        }
+
+        /**
+         * Change le taux de remplissage maximal (dans ]0, 1]) ; la table grandit immédiatement si elle le dépasse déjà
+         */
+        void setMaxLoadFactor(float maxLoad){
+            if(maxLoad <= 0 || maxLoad > 1)
+                return;
+            mMaxLoad = maxLoad;
+            this->resetGrowthLeft();
+            if(mGrowthLeft < 0)
+                this->reserve(mCount);
+        }
+
+        /**
+         * Agrandit la table de sorte qu'elle puisse recevoir n éléments sans nouvelle réallocation
+         */
+        void reserve(int n){
+            int capacity = roundCapacity((int)(n / mMaxLoad) + 1);
+            if(capacity > mCapacity)
+                this->rehash(capacity);
+        }
+
+        /**
+         * Détruit tous les éléments (la capacité est conservée)
+         */
+        void clear(){
+            if(!std::is_trivially_destructible<E>::value){
+                for(int i = 0; i < mCapacity; i++){
+                    if(mCtrl[i] != HASH_EMPTY)
+                        mSlots[i].~E();
+                }
+            }
+            std::memset(mCtrl, HASH_EMPTY, mCapacity + HASH_GROUP);
+            mCount = 0;
+            this->resetGrowthLeft();
+        }
+
+        /**
+         * Élément de clé k, nullptr s'il est absent
+         */
+        E* lookup(const K& k){
+            int i = this->find(k, this->hashOf(k));
+            return i == -1 ? nullptr : mSlots + i;
+        }
+
+        const E* lookup(const K& k) const{
+            int i = this->find(k, this->hashOf(k));
+            return i == -1 ? nullptr : mSlots + i;
+        }
+
+        /**
+         * Renvoie l'élément de clé k ; s'il est absent, le construit d'abord avec les arguments args (qui doivent produire la clé k). inserted indique si l'élément a été ajouté.
+         */
+        template<typename... Args>
+        E& findOrEmplace(const K& k, bool& inserted, Args&&... args){
+            std::uint64_t h = this->hashOf(k);
+            int i = this->find(k, h);
+            inserted = (i == -1);
+            if(inserted){
+                i = this->prepareInsert(h);
+                ::new(static_cast<void*>(mSlots + i)) E(std::forward<Args>(args)...);
+            }
+            return mSlots[i];
+        }
+
+        /**
+         * Supprime l'élément de clé k, renvoie false s'il était absent
+         */
+        bool erase(const K& k){
+            int i = this->find(k, this->hashOf(k));
+            if(i == -1)
+                return false;
+
+            //Suppression par décalage arrière : tout élément suivant (jusqu'à la prochaine case libre) dont la case de départ n'est pas située entre le trou et lui recule dans le trou
+            int mask = mCapacity - 1;
+            mSlots[i].~E();
+            for(int j = (i + 1) & mask; mCtrl[j] != HASH_EMPTY; j = (j + 1) & mask){
+                int h = this->home(this->hashOf(KeyOf::key(mSlots[j])));
+                if(((j - h) & mask) >= ((j - i) & mask)){
+                    ::new(static_cast<void*>(mSlots + i)) E(std::move(mSlots[j]));
+                    mSlots[j].~E();
+                    this->setCtrl(i, mCtrl[j]);
+                    i = j;
+                }
+            }
+            this->setCtrl(i, HASH_EMPTY);
+            mCount--;
+            mGrowthLeft++;
+            return true;
+        }
+
+        iterator begin(){
+            return iterator(mCtrl, mSlots, 0, mCapacity);
+        }
+
+        iterator end(){
+            return iterator(mCtrl, mSlots, mCapacity, mCapacity);
+        }
+
+        const_iterator begin() const{
+            return const_iterator(mCtrl, mSlots, 0, mCapacity);
+        }
+
+        const_iterator end() const{
+            return const_iterator(mCtrl, mSlots, mCapacity, mCapacity);
+        }
+};
+
+#endif
@@ -0,0 +1,239 @@
+#ifndef _HAZARDPOINTER_H_
+#define _HAZARDPOINTER_H_
+
+#include <atomic>
+#include <functional>
+
+#include "vector.hpp"
+#include "sort.hpp"
+
+/**
+ * Pointeurs de danger ("hazard pointers", M. Michael, 2004) : récupération sûre de la mémoire des structures sans verrou (voir ConcurrentLinkedQueue).
+ *
+ * Dans une structure sans verrou, un thread peut lire un noeud au moment même où un autre le retire de la structure : ce dernier ne peut donc pas le libérer immédiatement. Chaque thread dispose de HAZARD_SLOTS pointeurs de danger, visibles de tous, dans lesquels il publie les noeuds qu'il est en train de lire (protect()). Un noeud retiré de la structure est confié à retire() au lieu d'être libéré ; lorsque la liste des noeuds retirés d'un thread devient assez longue, il la parcourt et ne libère que les noeuds qu'aucun pointeur de danger ne désigne. Le nombre de noeuds en attente de libération reste ainsi borné (O(nombre de threads)), même si un thread est suspendu au milieu d'une opération.
+ *
+ * Les enregistrements (pointeurs de danger et noeuds retirés d'un thread) sont chaînés dans un domaine global, ne sont jamais libérés avant la fin du programme et sont réutilisés par les threads suivants lorsqu'un thread se termine.
+ */
+
+/**
+ * Nombre de pointeurs de danger par thread : les HAZARD_FIXED_SLOTS premiers sont des emplacements fixes (ceux de ConcurrentLinkedQueue), les suivants forment une pile pour les lectures qui peuvent s'imbriquer (voir hazardPush())
+ */
+#ifndef HAZARD_SLOTS
+#define HAZARD_SLOTS 10
+#endif
+
+#define HAZARD_FIXED_SLOTS 2
+
+static_assert(HAZARD_SLOTS > HAZARD_FIXED_SLOTS, "HAZARD_SLOTS doit laisser au moins un emplacement à la pile");
+
+/**
+ * Noeud retiré en attente de libération
+ */
+struct RetiredPtr{
+    void* ptr;
+    void (*deleter)(void*);
+};
+
+/**
+ * Enregistrement d'un thread : ses pointeurs de danger et ses noeuds retirés
+ */
+struct HazardRecord{
+    std::atomic<const void*> slots[HAZARD_SLOTS];
+    std::atomic<bool> active; //Enregistrement utilisé par un thread
+    int depth; //Emplacements de la pile occupés (seul le thread propriétaire y accède)
+    HazardRecord* next; //Enregistrement suivant du domaine (ne change plus une fois publié)
+    RetiredPtr* retired; //Noeuds retirés par le thread propriétaire (lui seul y accède)...
+    int retiredCount; //... leur nombre...
+    int retiredCapacity; //... et la taille du tableau retired
+
+    HazardRecord(){
+        for(int i = 0; i < HAZARD_SLOTS; i++)
+            slots[i] = nullptr;
+        active = true;
+        depth = 0;
+        next = nullptr;
+        retired = nullptr;
+        retiredCount = 0;
+        retiredCapacity = 0;
+    }
+
+    ~HazardRecord(){
+        delete[] retired;
+    }
+
+    void addRetired(RetiredPtr r){
+        if(retiredCount == retiredCapacity){
+            int capacity = retiredCapacity == 0 ? 64 : 2*retiredCapacity;
+            RetiredPtr* t = new RetiredPtr[capacity];
+            for(int i = 0; i < retiredCount; i++)
+                t[i] = retired[i];
+            delete[] retired;
+            retired = t;
+            retiredCapacity = capacity;
+        }
+        retired[retiredCount++] = r;
+    }
+};
+
+class HazardDomain
+{
+    private:
+        std::atomic<HazardRecord*> mHead; //Liste des enregistrements
+        std::atomic<int> mRecords; //Nombre d'enregistrements
+
+        /**
+         * Libère les noeuds retirés de rec qu'aucun pointeur de danger ne protège
+         */
+        void scan(HazardRecord* rec){
+            Vector<const void*> hazards(2*HAZARD_SLOTS*mRecords.load());
+            for(HazardRecord* r = mHead.load(); r != nullptr; r = r->next){
+                for(int i = 0; i < HAZARD_SLOTS; i++){
+                    const void* p = r->slots[i].load();
+                    if(p != nullptr)
+                        hazards.append(p);
+                }
+            }
+            std::less<const void*> less;
+            arraySort(hazards.data(), hazards.data() + hazards.size(), less);
+
+            RetiredPtr* t = rec->retired;
+            int kept = 0;
+            for(int i = 0; i < rec->retiredCount; i++){
+                const void* p = t[i].ptr;
+                const void* const* h = arrayLowerBound<const void*>(hazards.data(), hazards.data() + hazards.size(), p, less);
+                if(h != hazards.data() + hazards.size() && *h == p)
+                    t[kept++] = t[i]; //Encore protégé : on le garde pour plus tard
+                else
+                    t[i].deleter(t[i].ptr);
+            }
+            rec->retiredCount = kept;
+        }
+
+    public:
+        HazardDomain(){
+            mHead = nullptr;
+            mRecords = 0;
+        }
+
+        HazardDomain(const HazardDomain&) = delete;
+        HazardDomain& operator= (const HazardDomain&) = delete;
+
+        /**
+         * Destructeur (en fin de programme) : plus aucun thread n'accède aux structures, tous les noeuds retirés sont libérés
+         */
+        ~HazardDomain(){
+            HazardRecord* r = mHead.load();
+            while(r != nullptr){
+                HazardRecord* next = r->next;
+                for(int i = 0; i < r->retiredCount; i++)
+                    r->retired[i].deleter(r->retired[i].ptr);
+                delete r;
+                r = next;
+            }
+        }
+
+        static HazardDomain& global(){
+            static HazardDomain domain;
+            return domain;
+        }
+
+        /**
+         * Attribue un enregistrement au thread appelant : un enregistrement libéré s'il y en a un, sinon un nouveau
+         */
+        HazardRecord* acquire(){
+            for(HazardRecord* r = mHead.load(); r != nullptr; r = r->next){
+                bool expected = false;
+                if(!r->active.load() && r->active.compare_exchange_strong(expected, true))
+                    return r;
+            }
+            HazardRecord* r = new HazardRecord();
+            HazardRecord* head = mHead.load();
+            do{
+                r->next = head;
+            }while(!mHead.compare_exchange_weak(head, r));
+            mRecords++;
+            return r;
+        }
+
+        /**
+         * Rend l'enregistrement d'un thread qui se termine (ses noeuds retirés restants seront traités par le prochain propriétaire)
+         */
+        void release(HazardRecord* rec){
+            for(int i = 0; i < HAZARD_SLOTS; i++)
+                rec->slots[i] = nullptr;
+            rec->depth = 0;
+            if(rec->retiredCount > 0)
+                this->scan(rec);
+            rec->active = false;
+        }
+
+        /**
+         * Confie le noeud p, qui n'est plus accessible depuis la structure, au domaine : il sera libéré par deleter(p) lorsqu'aucun pointeur de danger ne le désignera plus
+         */
+        void retire(HazardRecord* rec, void* p, void (*deleter)(void*)){
+            rec->addRetired(RetiredPtr{p, deleter});
+            if(rec->retiredCount >= 2*HAZARD_SLOTS*mRecords.load() + 64)
+                this->scan(rec);
+        }
+};
+
+/**
+ * Enregistrement du thread courant dans le domaine global, rendu automatiquement à la fin du thread
+ */
+class HazardThread
+{
+    private:
+        HazardRecord* mRecord;
+
+        HazardThread(){
+            mRecord = HazardDomain::global().acquire();
+        }
+
+        ~HazardThread(){
+            HazardDomain::global().release(mRecord);
+        }
+
+    public:
+        static HazardRecord* record(){
+            static thread_local HazardThread t;
+            return t.mRecord;
+        }
+};
+
+/**
+ * Publie dans le pointeur de danger "slot" du thread la valeur courante de src, et recommence tant que src change entre la lecture et la publication. Au retour, le noeud renvoyé ne peut plus être libéré tant que le pointeur de danger le désigne.
+ */
+template<typename N>
+N* hazardProtect(HazardRecord* rec, int slot, const std::atomic<N*>& src){
+    N* p = src.load();
+    for(;;){
+        rec->slots[slot].store(p);
+        N* q = src.load();
+        if(q == p)
+            return p;
+        p = q;
+    }
+}
+
+inline void hazardClear(HazardRecord* rec, int slot){
+    rec->slots[slot].store(nullptr, std::memory_order_release);
+}
+
+/**
+ * Comme hazardProtect(), dans le premier emplacement libre de la pile du thread : une lecture faite au milieu d'une autre (CopyOnWriteVector::read() appelé depuis une autre lecture, ou une opération de ConcurrentLinkedQueue, qui n'utilise que les emplacements fixes) ne retire pas la protection de la première. Lance une UnsupportedOperationException au-delà de HAZARD_SLOTS - HAZARD_FIXED_SLOTS lectures imbriquées. Chaque hazardPush() réussi doit être suivi d'un hazardPop(), dans l'ordre inverse.
+ */
+template<typename N>
+N* hazardPush(HazardRecord* rec, const std::atomic<N*>& src){
+    if(HAZARD_FIXED_SLOTS + rec->depth == HAZARD_SLOTS)
+        throw UnsupportedOperationException();
+    return hazardProtect(rec, HAZARD_FIXED_SLOTS + rec->depth++, src);
+}
+
+/**
+ * Libère l'emplacement pris par le dernier hazardPush()
+ */
+inline void hazardPop(HazardRecord* rec){
+    hazardClear(rec, HAZARD_FIXED_SLOTS + --rec->depth);
+}
+
+#endif
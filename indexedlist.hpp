@@ -0,0 +1,498 @@
+#ifndef _INDEXEDLIST_H_
+#define _INDEXEDLIST_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "list.hpp"
+#include "vector.hpp"
+
+/**
+ * Liste indexée : enveloppe une liste C (Vector<T> par défaut, ou LinkedList<T>) et maintient à jour une table de hachage qui associe à chaque valeur ses positions dans la liste. pos(), indexOf(), contains() et la recherche de l'élément à supprimer dans remove() ne parcourent donc plus la liste.
+ *
+ * Principe : chaque élément reçoit à son insertion un numéro de séquence (croissant pour append, décroissant pour prepend) qui ne change plus ensuite, de sorte que l'ordre des numéros est l'ordre de la liste. La table de hachage (adressage ouvert, sondage linéaire, suppression par décalage arrière donc sans pierres tombales) associe chaque valeur aux numéros de ses occurrences, et un arbre de Fenwick sur les numéros de séquence donne en O(log n) la position d'un élément (le nombre d'éléments vivants de numéro inférieur) et, inversement, le numéro de l'élément situé à une position donnée.
+ *
+ * Complexités (n éléments, d occurrences de la valeur cherchée) :
+ *  - append, prepend : O(1) amorti (+ O(log n) pour l'arbre de Fenwick) ;
+ *  - contains : O(1 + d) en moyenne ; pos, indexOf : O(d + log n) ;
+ *  - remove : O(d + log n) pour trouver et désindexer l'élément, plus la suppression dans la liste sous-jacente elle-même (décalage mémoire pour un Vector, parcours jusqu'au noeud pour une LinkedList).
+ *
+ * Écritures : operator[] non constant renvoie une référence sur l'élément ; la liste indexée mémorise alors l'ancienne valeur et réindexe l'élément au prochain appel d'une autre méthode. Plusieurs références obtenues par operator[] peuvent servir en même temps (std::swap(l[i], l[j]) par exemple), mais aucune ne doit plus servir après un appel à une autre méthode de la liste. set(i, e) réindexe immédiatement. Les itérateurs non constants ne doivent pas servir à modifier les éléments.
+ *
+ * Comme le doigt de LinkedList, cette réindexation différée est faite par les méthodes const (indexOf(), contains(), count(), pos()...) : tant qu'une écriture par operator[] non constant est en attente, ces recherches modifient la table et ne doivent pas être faites en même temps depuis plusieurs threads. Toute autre méthode non constante (append(), set()...) prend les écritures en attente en compte ; après elle, et jusqu'au prochain appel de l'operator[] non constant, les recherches ne modifient plus rien et plusieurs threads peuvent en faire en même temps.
+ *
+ * Surcoût mémoire par élément, en plus de la liste elle-même : une entrée de table (sizeof(T) + 8 octets de numéro + 1 octet d'occupation, divisé par le taux de remplissage, compris entre 0.25 et 0.5, soit 2 à 4 fois cette taille) et 4 octets d'arbre de Fenwick (avec une marge de 2 à 3 fois). Pour des int, compter environ 40 à 80 octets par élément.
+ */
+
+template<typename T, typename C = Vector<T> >
+class IndexedList : public List<T>
+{
+    private:
+        /**
+         * Entrée de la table de hachage : une occurrence de key, de numéro de séquence seq
+         */
+        struct Entry{
+            T key;
+            long long seq;
+        };
+
+        C mData; //La liste elle-même
+
+        //L'index (table de hachage et écritures en attente) est un cache sur le contenu de la liste : il peut être mis à jour par les méthodes const
+        mutable Entry* mSlots; //Table de hachage (mémoire brute, seules les cases marquées dans mUsed sont construites)
+        mutable unsigned char* mUsed;
+        mutable int mCapacity; //Nombre de cases de la table (puissance de 2)
+        mutable int mCount; //Nombre d'entrées
+
+        int* mFen; //Arbre de Fenwick sur les numéros de séquence [mFenBase, mFenBase + mFenSize[ (1 si l'élément est vivant)
+        int mFenSize;
+        long long mFenBase;
+        long long mNextSeq; //Numéro du prochain élément ajouté en fin de liste
+        long long mPrevSeq; //Numéro du dernier élément ajouté en début de liste
+
+        mutable Vector<int> mPendingPos; //Positions livrées par operator[] depuis la dernière synchronisation...
+        mutable Vector<T> mPendingOld; //... et valeur qu'avait alors l'élément
+
+        /////// TABLE DE HACHAGE ///////
+
+        static size_t hashOf(const T& t){
+            size_t h = std::hash<T>()(t);
+            return (size_t)(((unsigned long long)h * 0x9E3779B97F4A7C15ULL) >> 16);
+        }
+
+        int home(const T& t) const{
+            return (int)(hashOf(t) & (size_t)(mCapacity - 1));
+        }
+
+        void allocTable(int capacity) const{
+            mCapacity = capacity;
+            mCount = 0;
+            mSlots = std::allocator<Entry>().allocate(capacity);
+            mUsed = new unsigned char[capacity]();
+        }
+
+        void freeTable() const{
+            for(int i = 0; i < mCapacity; i++){
+                if(mUsed[i])
+                    mSlots[i].~Entry();
+            }
+            std::allocator<Entry>().deallocate(mSlots, mCapacity);
+            delete[] mUsed;
+        }
+
+        void insertEntry(const T& key, long long seq) const{
+            if(2*(mCount + 1) > mCapacity)
+                this->growTable();
+            int i = this->home(key);
+            while(mUsed[i])
+                i = (i + 1) & (mCapacity - 1);
+            ::new(static_cast<void*>(mSlots + i)) Entry{key, seq};
+            mUsed[i] = 1;
+            mCount++;
+        }
+
+        void growTable() const{
+            Entry* oldSlots = mSlots;
+            unsigned char* oldUsed = mUsed;
+            int oldCapacity = mCapacity;
+            this->allocTable(2*oldCapacity);
+            for(int i = 0; i < oldCapacity; i++){
+                if(oldUsed[i]){
+                    int j = this->home(oldSlots[i].key);
+                    while(mUsed[j])
+                        j = (j + 1) & (mCapacity - 1);
+                    ::new(static_cast<void*>(mSlots + j)) Entry(std::move(oldSlots[i]));
+                    mUsed[j] = 1;
+                    mCount++;
+                    oldSlots[i].~Entry();
+                }
+            }
+            std::allocator<Entry>().deallocate(oldSlots, oldCapacity);
+            delete[] oldUsed;
+        }
+
+        /**
+         * Case de l'occurrence de key de plus petit numéro de séquence (la première dans la liste), -1 si key est absente. Toutes les occurrences se trouvent entre la case de départ et la première case vide.
+         */
+        int findFirst(const T& key) const{
+            int best = -1;
+            for(int i = this->home(key); mUsed[i]; i = (i + 1) & (mCapacity - 1)){
+                if(mSlots[i].key == key && (best == -1 || mSlots[i].seq < mSlots[best].seq))
+                    best = i;
+            }
+            return best;
+        }
+
+        int findAny(const T& key) const{
+            for(int i = this->home(key); mUsed[i]; i = (i + 1) & (mCapacity - 1)){
+                if(mSlots[i].key == key)
+                    return i;
+            }
+            return -1;
+        }
+
+        int findExact(const T& key, long long seq) const{
+            for(int i = this->home(key); mUsed[i]; i = (i + 1) & (mCapacity - 1)){
+                if(mSlots[i].seq == seq && mSlots[i].key == key)
+                    return i;
+            }
+            return -1;
+        }
+
+        /**
+         * Supprime l'entrée de la case i par décalage arrière : les entrées suivantes de la grappe qui peuvent remonter vers leur case de départ comblent le trou.
+         */
+        void eraseSlot(int i) const{
+            mSlots[i].~Entry();
+            mUsed[i] = 0;
+            mCount--;
+            int j = i;
+            while(true){
+                j = (j + 1) & (mCapacity - 1);
+                if(!mUsed[j])
+                    return;
+                int k = this->home(mSlots[j].key);
+                //L'entrée j peut aller en i si sa case de départ k n'est pas dans l'intervalle circulaire ]i, j]
+                bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+                if(!stays){
+                    ::new(static_cast<void*>(mSlots + i)) Entry(std::move(mSlots[j]));
+                    mSlots[j].~Entry();
+                    mUsed[i] = 1;
+                    mUsed[j] = 0;
+                    i = j;
+                }
+            }
+        }
+
+        /////// ARBRE DE FENWICK ///////
+
+        void fenAdd(long long seq, int delta){
+            for(int i = (int)(seq - mFenBase) + 1; i <= mFenSize; i += i & -i)
+                mFen[i] += delta;
+        }
+
+        /**
+         * Nombre d'éléments vivants de numéro strictement inférieur à seq, c'est à dire la position de l'élément seq
+         */
+        int rank(long long seq) const{
+            int r = 0;
+            for(int i = (int)(seq - mFenBase); i > 0; i -= i & -i)
+                r += mFen[i];
+            return r;
+        }
+
+        /**
+         * Numéro de séquence de l'élément en position p (descente dans l'arbre en O(log n))
+         */
+        long long seqAt(int p) const{
+            int idx = 0;
+            int rem = p + 1;
+            int step = 1;
+            while(2*step <= mFenSize)
+                step *= 2;
+            for(; step > 0; step /= 2){
+                if(idx + step <= mFenSize && mFen[idx + step] < rem){
+                    idx += step;
+                    rem -= mFen[idx];
+                }
+            }
+            return mFenBase + idx;
+        }
+
+        /**
+         * Renumérote les éléments 0..n-1 (décalés de n) et reconstruit l'arbre avec de la marge des deux côtés. Appelé lorsqu'un nouveau numéro sort de l'intervalle couvert par l'arbre : le coût O(n log n) est amorti par les n ajouts qui précèdent le prochain appel.
+         */
+        void renumber(){
+            int n = mData.size();
+            long long base = n + 16;
+            for(int i = 0; i < mCapacity; i++){
+                if(mUsed[i])
+                    mSlots[i].seq = base + this->rank(mSlots[i].seq);
+            }
+
+            delete[] mFen;
+            mFenSize = 3*n + 48;
+            mFenBase = 0;
+            mFen = new int[mFenSize + 1]();
+            for(int i = 0; i < n; i++)
+                mFen[(int)(base + i) + 1] = 1;
+            for(int k = 1; k <= mFenSize; k++){ //Construction en O(n) : chaque noeud transmet sa somme à son parent
+                int parent = k + (k & -k);
+                if(parent <= mFenSize)
+                    mFen[parent] += mFen[k];
+            }
+            mPrevSeq = base;
+            mNextSeq = base + n;
+        }
+
+        /**
+         * Prend en compte les écritures faites à travers les références livrées par operator[]
+         */
+        void sync() const{
+            if(mPendingPos.size() == 0)
+                return;
+            for(int k = 0; k < mPendingPos.size(); k++){
+                int p = mPendingPos[k];
+                T cur = mData[p];
+                if(cur == mPendingOld[k])
+                    continue;
+                long long seq = this->seqAt(p);
+                int slot = this->findExact(mPendingOld[k], seq);
+                if(slot == -1)
+                    continue; //Déjà réindexé par une entrée précédente de la même position
+                this->eraseSlot(slot);
+                this->insertEntry(cur, seq);
+            }
+            mPendingPos = Vector<int>(0);
+            mPendingOld = Vector<T>(0);
+        }
+
+        /**
+         * Reconstruit entièrement l'index après une réorganisation de la liste : les éléments sont renumérotés dans leur nouvel ordre
+         */
+        void reindex(){
+            int capacity = mCapacity;
+            this->freeTable();
+            this->allocTable(capacity);
+            this->renumber(); //La table est vide : seul l'arbre de Fenwick est reconstruit
+            long long seq = mPrevSeq;
+            for(const T& e : static_cast<const C&>(mData))
+                this->insertEntry(e, seq++);
+        }
+
+        void init(){
+            this->allocTable(16);
+            mFenSize = 48;
+            mFenBase = 0;
+            mFen = new int[mFenSize + 1]();
+            mPrevSeq = mNextSeq = 16;
+        }
+
+    public:
+        IndexedList() : mPendingPos(0), mPendingOld(0){
+            this->init();
+        }
+
+        IndexedList(const IndexedList<T, C>&) = delete;
+        IndexedList<T, C>& operator= (const IndexedList<T, C>&) = delete;
+
+        ~IndexedList(){
+            this->freeTable();
+            delete[] mFen;
+        }
+
+        int size() const{
+            return mData.size();
+        }
+
+        void append(T e){
+            this->sync();
+            if(mNextSeq - mFenBase >= mFenSize)
+                this->renumber();
+            long long seq = mNextSeq++;
+            this->insertEntry(e, seq);
+            this->fenAdd(seq, 1);
+            mData.append(std::move(e));
+        }
+
+        void prepend(T e){
+            this->sync();
+            if(mPrevSeq - 1 < mFenBase)
+                this->renumber();
+            long long seq = --mPrevSeq;
+            this->insertEntry(e, seq);
+            this->fenAdd(seq, 1);
+            mData.prepend(std::move(e));
+        }
+
+        /**
+         * Remplace le i-ème élément par e et le réindexe immédiatement (l'indice est toujours vérifié, quel que soit LIST_BOUNDS_CHECK)
+         */
+        void set(int i, T e){
+            this->sync();
+            if((unsigned)i >= (unsigned)mData.size())
+                listIndexError(mData.size());
+            T& cur = mData[i];
+            long long seq = this->seqAt(i);
+            this->eraseSlot(this->findExact(cur, seq));
+            this->insertEntry(e, seq);
+            cur = std::move(e);
+        }
+
+        T operator[] (int i) const{
+            return mData[i];
+        }
+
+        /**
+         * Accès en écriture : l'élément sera réindexé au prochain appel d'une autre méthode (pas de synchronisation ici, pour que les références livrées précédemment restent suivies)
+         */
+        T& operator[] (int i){
+            T& ref = mData[i];
+            mPendingPos.append(i);
+            mPendingOld.append(ref);
+            return ref;
+        }
+
+        int indexOf(const T& t) const{
+            this->sync();
+            int slot = this->findFirst(t);
+            return slot == -1 ? -1 : this->rank(mSlots[slot].seq);
+        }
+
+        bool contains(const T& t) const{
+            this->sync();
+            return this->findAny(t) != -1;
+        }
+
+        /**
+         * Nombre d'occurrences de t
+         */
+        int count(const T& t) const{
+            this->sync();
+            int c = 0;
+            for(int i = this->home(t); mUsed[i]; i = (i + 1) & (mCapacity - 1)){
+                if(mSlots[i].key == t)
+                    c++;
+            }
+            return c;
+        }
+
+        /**
+         * Tri de la liste sous-jacente, puis reconstruction de l'index en O(n)
+         */
+        template<typename Cmp>
+        void sort(Cmp cmp){
+            this->sync();
+            mData.sort(cmp);
+            this->reindex();
+        }
+
+        void sort(const typename List<T>::Comparator& cmp){
+            this->template sort<const typename List<T>::Comparator&>(cmp);
+        }
+
+        void sort(){
+            this->sort(std::less<T>());
+        }
+
+        /**
+         * Opérations par lots : elles sont faites sur la liste sous-jacente, puis l'index est reconstruit en O(n)
+         */
+        void insertRange(int i, const List<T>& o){
+            this->sync();
+            mData.insertRange(i, &o == this ? static_cast<const List<T>&>(mData) : o);
+            this->reindex();
+        }
+
+        void prependAll(const List<T>& o){
+            this->insertRange(0, o);
+        }
+
+        template<typename It>
+        void insertRange(int i, It first, It last){
+            this->sync();
+            mData.insertRange(i, first, last);
+            this->reindex();
+        }
+
+        template<typename It>
+        void prependAll(It first, It last){
+            this->insertRange(0, first, last);
+        }
+
+        int removeIf(const typename List<T>::Predicate& pred){
+            this->sync();
+            int removed = mData.removeIf(pred);
+            if(removed > 0)
+                this->reindex();
+            return removed;
+        }
+
+        template<typename Pred>
+        int removeIf(Pred pred){
+            return this->removeIf(typename List<T>::Predicate(pred));
+        }
+
+        void remove(T e){
+            if(mData.size() == 0)
+                throw EmptyContainerException();
+            if(!this->tryRemove(e))
+                throw ElementNotFoundException<T>(e);
+        }
+
+        /**
+         * Supprime la première occurrence de e (trouvée par la table de hachage), ou renvoie false si elle n'existe pas
+         */
+        bool tryRemove(const T& e){
+            this->sync();
+            int slot = this->findFirst(e);
+            if(slot == -1)
+                return false;
+            long long seq = mSlots[slot].seq;
+            int p = this->rank(seq);
+            this->eraseSlot(slot);
+            this->fenAdd(seq, -1);
+            mData.removeAt(p);
+            return true;
+        }
+
+        /**
+         * Supprime le i-ème élément de la liste et son entrée dans la table
+         */
+        void removeAt(int i){
+            this->sync();
+            if((unsigned)i >= (unsigned)mData.size())
+                listIndexError(mData.size());
+            long long seq = this->seqAt(i);
+            this->eraseSlot(this->findExact(mData[i], seq));
+            this->fenAdd(seq, -1);
+            mData.removeAt(i);
+        }
+
+        bool hasNext() const{
+            return mData.hasNext();
+        }
+
+        T next() const{
+            return mData.next();
+        }
+
+        T first() const{
+            return mData.first();
+        }
+
+        T last() const{
+            return mData.last();
+        }
+
+        void firstChunk(ListChunk<T>& c) const{
+            mData.firstChunk(c);
+        }
+
+        void nextChunk(ListChunk<T>& c) const{
+            mData.nextChunk(c);
+        }
+
+        /**
+         * Parcours en lecture seule de la liste sous-jacente
+         */
+        typename C::const_iterator begin() const{
+            return mData.begin();
+        }
+
+        typename C::const_iterator end() const{
+            return mData.end();
+        }
+
+        /**
+         * Liste sous-jacente (en lecture seule)
+         */
+        const C& data() const{
+            return mData;
+        }
+};
+
+#endif
@@ -1,42 +1,251 @@
 #ifndef _LINKEDLIST_H_
 #define _LINKEDLIST_H_
 
-#include "list.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
-#ifndef nullptr
-#define nullptr 0
-#endif
+#include "list.hpp"
+#include "listbase.hpp"
+#include "nodeallocator.hpp"
 
 /////////// ELEMENT DE LISTE ///////////
 
 /*
- * Structure intermédiaire définissant un élement de la liste comme le doublet composé d'un élément de type T et d'un pointeur sur l'élément suivant (ou nullptr si il n'y a pas d'élément suivant).
+ * Structure intermédiaire définissant un élement de la liste comme le triplet composé d'un élément de type T, d'un pointeur sur l'élément précédent et d'un pointeur sur l'élément suivant (nullptr si il n'y a pas d'élément précédent ou suivant).
  */
 
 template<typename T>
 struct ListElt{
     T val;
+    ListElt* prev;
     ListElt* next;
 
-    ListElt(T nVal, ListElt* nNext){
-        val = nVal;
-        next = nNext;
+    ListElt(T nVal, ListElt* nPrev, ListElt* nNext) : val(std::move(nVal)), prev(nPrev), next(nNext){
     }
 };
 
+/////////// ITÉRATEUR ///////////
+
+/*
+ * Itérateur externe sur une LinkedList (V vaut T ou const T) : un simple pointeur sur le noeud courant.
+ */
+template<typename T, typename V>
+class LinkedListIterator
+{
+    private:
+        ListElt<T>* mElt;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V* pointer;
+        typedef V& reference;
+
+        explicit LinkedListIterator(ListElt<T>* e = nullptr){
+            mElt = e;
+        }
+
+        template<typename W>
+        LinkedListIterator(const LinkedListIterator<T, W>& o){
+            mElt = o.mElt;
+        }
+
+        V& operator* () const{
+            return mElt->val;
+        }
+
+        V* operator-> () const{
+            return &mElt->val;
+        }
+
+        LinkedListIterator& operator++ (){
+            mElt = mElt->next;
+            return *this;
+        }
+
+        LinkedListIterator operator++ (int){
+            LinkedListIterator ret = *this;
+            mElt = mElt->next;
+            return ret;
+        }
+
+        bool operator== (const LinkedListIterator& o) const{
+            return mElt == o.mElt;
+        }
+
+        bool operator!= (const LinkedListIterator& o) const{
+            return mElt != o.mElt;
+        }
+
+        template<typename U, typename W>
+        friend class LinkedListIterator;
+};
+
 /////////////// LA LISTE ///////////////
 
-template<typename T>
-class LinkedList : public List<T>
+/*
+ * La liste est doublement chaînée et retient le dernier noeud atteint par indice (le "doigt") : operator[] et removeAt partent de la tête, de la queue ou du doigt, selon le plus proche. Une boucle "for(i...) l[i]", même à travers un List<T>*, ne fait donc qu'un pas par élément au lieu de repartir de la tête à chaque fois ; un accès proche du précédent (i-1, i+2...) ou une extrémité coûte O(1). Comme le curseur mCurs, le doigt est modifié par les méthodes const : plusieurs threads qui lisent la même liste doivent passer par les itérateurs externes plutôt que par operator[].
+ *
+ * Le paramètre Alloc définit la façon dont les noeuds ListElt<T> sont alloués (voir nodeallocator.hpp). Par défaut, chaque noeud est alloué avec new et libéré avec delete ; avec un SlabNodeAllocator (voir PooledLinkedList plus bas), les noeuds sont découpés dans de grands blocs contigus et recyclés.
+ */
+template<typename T, typename Alloc = HeapNodeAllocator< ListElt<T> > >
+class LinkedList : public List<T>, public ListBase<LinkedList<T, Alloc>, T>
 {    
     private:
 
+        Alloc mAlloc; //Allocateur des noeuds de la liste
+
         ListElt<T>* mFirst; //Pointeur sur le premier élément de la liste
         ListElt<T>* mLast; //Pointeur sur le dernier élément de la liste
         mutable ListElt<T>* mCurs; //Itérateur pointant sur un élément de la liste, le mot clef mutable signifie ici que l'on peut modifier mCurs, même dans une méthode déclarée "const" comme first par exemple.
+        mutable ListElt<T>* mFinger; //Dernier noeud atteint par indice (nullptr si aucun)...
+        mutable int mFingerIndex; //... et son indice
         int mSize; //Entier maintenu à jour au fil de l'évolution de la liste et contenant sa taille (évite d'avoir à recompter les éléments de la liste chaque fois qu'on veut sa taille).
+
+        /**
+         * Noeud d'indice i (0 <= i < mSize) : on part de la tête, de la queue ou du doigt, selon le plus proche, et le doigt est ensuite placé sur ce noeud
+         */
+        ListElt<T>* locate(int i) const{
+            ListElt<T>* elt = this->mFirst;
+            int k = 0;
+            if(this->mSize - 1 - i < i){
+                elt = this->mLast;
+                k = this->mSize - 1;
+            }
+            if(this->mFinger != nullptr && std::abs(i - this->mFingerIndex) < std::abs(i - k)){
+                elt = this->mFinger;
+                k = this->mFingerIndex;
+            }
+
+            LIST_STAT(TRAVERSAL_STEPS, std::abs(i - k));
+            for(; k < i; k++)
+                elt = elt->next;
+            for(; k > i; k--)
+                elt = elt->prev;
+
+            this->mFinger = elt;
+            this->mFingerIndex = i;
+            return elt;
+        }
+
+        /**
+         * Retire de la chaîne et libère le noeud t, d'indice i. Le doigt reste sur le même élément (ou passe sur le précédent si c'est t qui est retiré) et le curseur passe à l'élément suivant si il était sur t.
+         */
+        void unlink(ListElt<T>* t, int i){
+            if(t->prev == nullptr)
+                this->mFirst = t->next;
+            else
+                t->prev->next = t->next;
+
+            if(t->next == nullptr)
+                this->mLast = t->prev;
+            else
+                t->next->prev = t->prev;
+
+            if(this->mFinger == t)
+                this->mFinger = t->prev;
+            if(this->mFinger != nullptr && i <= this->mFingerIndex)
+                this->mFingerIndex--;
+            if(this->mCurs == t)
+                this->mCurs = t->next;
+
+            mAlloc.destroy(t);
+            LIST_STAT(NODE_FREES, 1);
+            mSize--;
+        }
+
+        /**
+         * Insère devant le i-ème élément (0 <= i <= mSize) une chaîne de noeuds construite à partir de [first, last[. La chaîne est entièrement construite avant d'être raccordée : l'intervalle peut donc porter sur cette liste, et si la construction d'un élément échoue, la liste n'est pas modifiée.
+         */
+        template<typename It>
+        void splice(int i, It first, It last){
+            ListElt<T>* head = nullptr;
+            ListElt<T>* tail = nullptr;
+            int n = 0;
+            try{
+                for(; first != last; ++first, n++){
+                    ListElt<T>* e = mAlloc.create(*first, tail, nullptr);
+                    if(tail == nullptr)
+                        head = e;
+                    else
+                        tail->next = e;
+                    tail = e;
+                }
+            }catch(...){
+                while(head != nullptr){
+                    ListElt<T>* next = head->next;
+                    mAlloc.destroy(head);
+                    head = next;
+                }
+                throw;
+            }
+            if(n == 0)
+                return;
+            LIST_STAT(NODE_ALLOCATIONS, n);
+
+            ListElt<T>* prev = i == 0 ? nullptr : (i == mSize ? mLast : this->locate(i - 1));
+            ListElt<T>* next = prev == nullptr ? mFirst : prev->next;
+            head->prev = prev;
+            tail->next = next;
+            if(prev == nullptr)
+                mFirst = head;
+            else
+                prev->next = head;
+            if(next == nullptr)
+                mLast = tail;
+            else
+                next->prev = tail;
+
+            if(mFinger != nullptr && i <= mFingerIndex)
+                mFingerIndex += n;
+            mSize += n;
+        }
+
+        /**
+         * Place c sur le bloc formé par le noeud elt (ou sur la fin de parcours si elt vaut nullptr)
+         */
+        static void chunkAt(ListChunk<T>& c, ListElt<T>* elt){
+            c.node = elt;
+            c.begin = elt == nullptr ? nullptr : &elt->val;
+            c.end = elt == nullptr ? nullptr : &elt->val + 1;
+        }
+
+        /**
+         * Fusion de deux chaînes triées a et b (terminées par nullptr, de derniers noeuds aTail et bTail) : renvoie la tête de la chaîne fusionnée et place son dernier noeud dans tail. À égalité, les noeuds de a passent en premier.
+         */
+        template<typename Cmp>
+        static ListElt<T>* merge(ListElt<T>* a, ListElt<T>* aTail, ListElt<T>* b, ListElt<T>* bTail, Cmp& cmp, ListElt<T>*& tail){
+            ListElt<T>* head;
+            ListElt<T>** link = &head;
+            while(a != nullptr && b != nullptr){
+                if(cmp(b->val, a->val)){
+                    *link = b;
+                    link = &b->next;
+                    b = b->next;
+                }else{
+                    *link = a;
+                    link = &a->next;
+                    a = a->next;
+                }
+            }
+            if(a != nullptr){
+                *link = a;
+                tail = aTail;
+            }else{
+                *link = b;
+                tail = bTail;
+            }
+            return head;
+        }
     
     public:
+        typedef LinkedListIterator<T, T> iterator;
+        typedef LinkedListIterator<T, const T> const_iterator;
 
         /**
          * Constructeur par défaut
@@ -45,19 +254,27 @@ class LinkedList : public List<T>
             mFirst = nullptr;
             mLast = nullptr;
             mCurs = nullptr;
+            mFinger = nullptr;
+            mFingerIndex = 0;
             mSize = 0;
         }
 
         /**
-         * Destructeur : parcours les éléments de la liste pour les supprimer un a un
+         * Destructeur : parcours les éléments de la liste pour les supprimer un a un. Si l'allocateur sait tout libérer d'un coup et que les éléments n'ont pas de destructeur à appeler, on se passe du parcours : la libération se fait en O(nombre de slabs).
          */
         ~LinkedList(){
+            LIST_STAT(NODE_FREES, mSize);
+            if(Alloc::releasesAll && std::is_trivially_destructible<T>::value){
+                mAlloc.releaseAll();
+                return;
+            }
+
             ListElt<T>* next = mFirst;
             ListElt<T>* prev = nullptr;
             while(next != nullptr){
                 prev = next;
                 next = prev->next;
-                delete prev;
+                mAlloc.destroy(prev);
             }
         }
 
@@ -65,7 +282,8 @@ class LinkedList : public List<T>
          * Ajout d'un élément en fin de liste
          */
         void append(T e){
-            ListElt<T>* nHead = new ListElt<T>(e, nullptr);
+            ListElt<T>* nHead = mAlloc.create(std::move(e), mLast, nullptr);
+            LIST_STAT(NODE_ALLOCATIONS, 1);
 
             if(mFirst == nullptr){
                 mFirst = nHead;
@@ -84,50 +302,80 @@ class LinkedList : public List<T>
         }
 
         /**
-         * Ajout d'un élément en début de liste
+         * Ajout d'un élément en début de liste (les indices sont décalés de un, doigt compris)
          */
         void prepend(T e){
-            ListElt<T>* nFirst = new ListElt<T>(e, mFirst);
+            ListElt<T>* nFirst = mAlloc.create(std::move(e), nullptr, mFirst);
+            LIST_STAT(NODE_ALLOCATIONS, 1);
+            if(mFirst != nullptr)
+                mFirst->prev = nFirst;
             mFirst = nFirst;
+            if(mLast == nullptr)
+                mLast = nFirst;
+            mFingerIndex++;
             mSize++;
         }
 
+        /**
+         * Itérateurs externes
+         */
+        iterator begin(){
+            return iterator(this->mFirst);
+        }
+
+        iterator end(){
+            return iterator();
+        }
+
+        const_iterator begin() const{
+            return const_iterator(this->mFirst);
+        }
+
+        const_iterator end() const{
+            return const_iterator();
+        }
+
+        /**
+         * Chaque noeud forme un bloc d'un élément
+         */
+        void firstChunk(ListChunk<T>& c) const{
+            this->chunkAt(c, this->mFirst);
+        }
+
+        void nextChunk(ListChunk<T>& c) const{
+            this->chunkAt(c, static_cast<const ListElt<T>*>(c.node)->next);
+        }
+
+        /**
+         * Allocateur des noeuds (permet notamment de consulter ses compteurs d'allocations)
+         */
+        const Alloc& allocator() const{
+            return this->mAlloc;
+        }
+
+        /**
+         * Nombre d'éléments de la liste
+         */
+        int size() const{
+            return this->mSize;
+        }
+
         /**
          * Accès en lecture à la valeur du i-ème élément de la liste. (La modification est inderdite à l'aide du mot-clef const et grace au fait que la valeur renvoyée est copiée en mémoire (TODO : à vérifier)
          */
         T operator[] (int i) const{
-            if(this->mSize == 0)
-                throw EmptyContainerException();
-
-            if(i < 0 || this->mSize <= i)
-                throw IndexOutOfBoundsException();
+            listCheckIndex(i, this->mSize);
 
-            int k = 0;
-            ListElt<T>* elt = mFirst;
-            while(k < i){
-                elt = elt->next;
-                k++;
-            }
-            return elt->val;
+            return this->locate(i)->val;
         }
 
         /**
          * Accès en écriture au i-ème élément de la liste. Une référence vers la valeur de ce i-ième élement est retournée ce qui en permet la modification
          */
         T& operator[] (int i){
-            if(this->mSize == 0)
-                throw EmptyContainerException();
-
-            if(i < 0 || this->mSize <= i)
-                throw IndexOutOfBoundsException();
+            listCheckIndex(i, this->mSize);
 
-            int k = 0;
-            ListElt<T>* elt = mFirst;
-            while(k < i){
-                elt = elt->next;
-                k++;
-            }
-            return elt->val;
+            return this->locate(i)->val;
         }
 
         /**
@@ -175,32 +423,206 @@ class LinkedList : public List<T>
             return this->mLast->val; 
         }
 
+        /**
+         * Recherche sans appel virtuel par élément (voir ListBase)
+         */
+        int indexOf(const T& t) const{
+            int i = ListBase<LinkedList<T, Alloc>, T>::indexOf(t);
+            LIST_STAT(TRAVERSAL_STEPS, i == -1 ? mSize : i + 1);
+            return i;
+        }
+
         void remove(T e){
             this->first();
-            ListElt<T>* prev = nullptr;
+            if(!this->tryRemove(e))
+                throw ElementNotFoundException<T>(e);
+        }
+
+        /**
+         * Supprime la première occurrence de e en un seul parcours, ou renvoie false si elle n'existe pas
+         */
+        bool tryRemove(const T& e){
             ListElt<T>* t = this->mFirst;
-    
-            while(t != nullptr){
+            for(int i = 0; t != nullptr; i++){
+                LIST_STAT(TRAVERSAL_STEPS, 1);
                 if(t->val == e){
-                    if(prev == nullptr){
-                        prev = this->mFirst;
-                        this->mFirst = t->next;
-                        delete prev;
-                    }else{
-                        prev->next = t->next;
-                        delete t;
-                    }
-                    return;
+                    this->unlink(t, i);
+                    return true;
                 }
-                prev = t;
                 t = t->next;
             }
+            return false;
+        }
+
+        /**
+         * Copie du i-ème élément, ou rien si i n'est pas un indice de la liste
+         */
+        std::optional<T> tryGet(int i) const{
+            if((unsigned)i >= (unsigned)this->mSize)
+                return std::nullopt;
+            return this->locate(i)->val;
+        }
+
+        /**
+         * Retrait en tête ou en queue en O(1)
+         */
+        T removeFirst(){
+            if(this->mFirst == nullptr)
+                throw EmptyContainerException();
+
+            T ret = std::move(this->mFirst->val);
+            this->unlink(this->mFirst, 0);
+            return ret;
+        }
+
+        T removeLast(){
+            if(this->mLast == nullptr)
+                throw EmptyContainerException();
+
+            T ret = std::move(this->mLast->val);
+            this->unlink(this->mLast, this->mSize - 1);
+            return ret;
+        }
+
+        /**
+         * Supprime le i-ème élément de la liste
+         */
+        void removeAt(int i){
+            if(this->mSize == 0)
+                throw EmptyContainerException();
+
+            if(i < 0 || this->mSize <= i)
+                throw IndexOutOfBoundsException();
+
+            this->unlink(this->locate(i), i);
+        }
+
+        /**
+         * Opérations par lots (voir List<T>) : les nouveaux noeuds forment une chaîne raccordée à la liste en une seule fois, sans appel virtuel par élément. La source peut être cette liste elle-même.
+         */
+        void appendAll(const List<T>& o){
+            this->splice(mSize, o.begin(), o.end());
+        }
+
+        template<typename It>
+        void appendAll(It first, It last){
+            this->splice(mSize, first, last);
+        }
+
+        void insertRange(int i, const List<T>& o){
+            if(i < 0 || mSize < i)
+                throw IndexOutOfBoundsException();
+            this->splice(i, o.begin(), o.end());
+        }
+
+        template<typename It>
+        void insertRange(int i, It first, It last){
+            if(i < 0 || mSize < i)
+                throw IndexOutOfBoundsException();
+            this->splice(i, first, last);
+        }
+
+        void prependAll(const List<T>& o){
+            this->splice(0, o.begin(), o.end());
+        }
+
+        template<typename It>
+        void prependAll(It first, It last){
+            this->splice(0, first, last);
+        }
+
+        /**
+         * Supprime les éléments qui vérifient pred en un seul parcours, chaque noeud supprimé étant retiré de la chaîne sur place : O(n) au total
+         */
+        template<typename Pred>
+        int removeIf(Pred pred){
+            int removed = 0;
+            ListElt<T>* t = this->mFirst;
+            for(int i = 0; t != nullptr; ){
+                ListElt<T>* next = t->next;
+                if(pred(t->val)){
+                    this->unlink(t, i);
+                    removed++;
+                }else
+                    i++;
+                t = next;
+            }
+            LIST_STAT(TRAVERSAL_STEPS, mSize + removed);
+            return removed;
+        }
 
-            throw ElementNotFoundException<T>(e);
+        int removeIf(const typename List<T>::Predicate& pred){
+            return this->template removeIf<const typename List<T>::Predicate&>(pred);
         }
 
+        /**
+         * Tri fusion ascendant ("bottom-up") qui rechaîne les noeuds : aucune valeur n'est copiée ni déplacée. Les noeuds sont pris un par un en tête de liste et versés dans des "bacs" : le bac i contient 0 ou 2^i noeuds triés. Un nouveau noeud est fusionné avec le bac 0, le résultat avec le bac 1 s'il est plein, etc. (comme une retenue dans une addition binaire). On fusionne enfin tous les bacs. Les fusions ne suivent que les pointeurs next : les pointeurs prev sont refaits en un dernier parcours. La mémoire supplémentaire se limite aux 64 bacs (O(1)), le tri coûte O(n log n) comparaisons et il est stable (deux éléments égaux gardent leur ordre). Contrairement aux passes successives sur toute la liste, les fusions portent surtout sur des chaînes courtes et récemment visitées, donc encore en cache. Le curseur est replacé en début de liste et le doigt est oublié.
+         */
+        template<typename Cmp>
+        void sort(Cmp cmp){
+            if(this->mSize < 2)
+                return;
+
+            ListElt<T>* bins[64]; //Tête de la chaîne du bac i (nullptr s'il est vide)...
+            ListElt<T>* binTails[64]; //... et son dernier noeud
+            int used = 0; //Nombre de bacs utilisés
+
+            ListElt<T>* rest = this->mFirst;
+            while(rest != nullptr){
+                ListElt<T>* chain = rest;
+                ListElt<T>* tail = rest;
+                rest = rest->next;
+                chain->next = nullptr;
+
+                int i = 0;
+                for(; i < used && bins[i] != nullptr; i++){
+                    chain = merge(bins[i], binTails[i], chain, tail, cmp, tail); //Le bac contient les noeuds les plus anciens : il passe en premier
+                    bins[i] = nullptr;
+                }
+                if(i == used)
+                    used++;
+                bins[i] = chain;
+                binTails[i] = tail;
+            }
+
+            ListElt<T>* chain = nullptr;
+            ListElt<T>* tail = nullptr;
+            for(int i = 0; i < used; i++){
+                if(bins[i] == nullptr)
+                    continue;
+                if(chain == nullptr){
+                    chain = bins[i];
+                    tail = binTails[i];
+                }else
+                    chain = merge(bins[i], binTails[i], chain, tail, cmp, tail);
+            }
+
+            ListElt<T>* prev = nullptr;
+            for(ListElt<T>* t = chain; t != nullptr; t = t->next){
+                t->prev = prev;
+                prev = t;
+            }
+
+            this->mFirst = chain;
+            this->mLast = tail;
+            this->mCurs = chain;
+            this->mFinger = nullptr;
+        }
+
+        void sort(const typename List<T>::Comparator& cmp){
+            this->template sort<const typename List<T>::Comparator&>(cmp);
+        }
+
+        void sort(){
+            this->sort(std::less<T>());
+        }
 
 };
 
+/**
+ * LinkedList dont les noeuds sont alloués par slabs
+ */
+template<typename T>
+using PooledLinkedList = LinkedList< T, SlabNodeAllocator< ListElt<T> > >;
 
 #endif
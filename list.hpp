@@ -7,6 +7,10 @@
  *
  * Le parcours d'élément se fait à l'aide d'itérateurs (tout comme en Java), cachés derrière les méthodes first(), next() et hasNext(). Contrairement au Java, ceux-ci ne sont pas définis dans une classe à part pour des raisons de simplicités. L'inconvénient de cette méthode est qu'il est impossible d'avoir plusieurs itérateurs simultanément sur la même liste. Si cela ne pose pas de problème pour l'écriture (il est fortement déconseillé de modifier une liste en cours de parcours, encore plus avec deux itérateurs différents), il peut arriver qu'on en ait besoin pour la lecture, notamment pour effectuer des tris.
  *
+ * Pour lever cette limitation, chaque liste fournit aussi de vrais itérateurs externes, compatibles avec la STL : begin() et end() (et donc la boucle "for(T& e : liste)"). Chaque itérateur porte son propre état, on peut donc en avoir plusieurs en même temps, y compris dans plusieurs threads qui lisent la même liste. Ils donnent accès aux éléments par référence (sans copie). Sur une implémentation concrète (Vector<T>, LinkedList<T>...), begin() renvoie un itérateur propre au conteneur dont toutes les méthodes peuvent être inlinées. À travers l'interface List<T>, l'itérateur parcourt la liste par blocs contigus d'éléments (voir ListChunk) : seul le passage d'un bloc au suivant coûte un appel virtuel (jamais pour un Vector, une fois par noeud pour une LinkedList).
+ *
+ * Les listes se trient en place avec sort() (ordre de l'opérateur <) ou sort(cmp) : Vector trie directement son tableau (voir sort.hpp), LinkedList réordonne ses noeuds sans copier les valeurs. isSorted() et binarySearch() complètent le tri.
+ *
  * Le mot "liste" ne doit pas induire en erreur, il ne présage en rien de la façon dont les données seront stockées en mémoire (ce conteneur ne doit en aucun cas être confondu avec la notion de liste en Caml, qui porte ici, tout comme en Java, le nom de "LinkedList" (liste chainée). 
  *
  * De cette classe abstraite vont hériter deux classes : LinkedList<T> qui représente une liste chainée d'éléments de type T et Vector<T> qui stocke les données sous forme de Vecteur (tout comme en Caml et en Java).
@@ -15,8 +19,6 @@
  *
  * Dernier point : l'implémentation que j'ai choisie pour LinkedList est itérative. Néanmoins une implémentation récursive est tout à fait envisageable (sous réserve de bonne gestion des questions de récursivité terminale ou non et des problèmes de complexité spatiale induite). 
  *
- * TODO : ajout d'une méthode de parcours par surcharge de l'opérateur *.
- *
  * 2014 - Etienne LAFARGE
  * École Nationale Supérieure des Mines de Paris
  * Mail : etienne.lafarge@gmail.com
@@ -25,23 +27,168 @@
 
 /* Classe d'abstraction pour un type de liste générique dont les deux implémentation seront un ArrayList et une LinkedList */
 
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <exception>
+#include <memory>
+#include <new>
+#include <optional>
 #include <string>
 #include <sstream>
+#include <utility>
+
+#include "sort.hpp"
+#include "liststats.hpp"
 
 template<typename T>
 class ElementNotFoundException; //Déclaration de la classe ElementNotFoundException (définie plus bas). Cette déclaration doit figurer ici car la classe ElementNotFoundException est utilisée dans la décalaration de la méthode "pos()" de List. Elle permet de dire au compilateur "Il y'a une classe ElementNotFoundException définie quelque part donc si tu lis ElementNotFoundException quelque part, ne t'inquiètes pas, tu trouvera la définition de cette classe plus loin, continues à lire jusqu'à ce qu'elle soit définie et ne renvoies pas d'erreur tout de suite s'il te plait".
 
+class EmptyContainerException; //Idem pour EmptyContainerException (lancée par pos() lorsque la liste est vide)
+class IndexOutOfBoundsException; //Et pour IndexOutOfBoundsException (lancée par insertRange())
+
+/**
+ * La variable de préprocesseur LIST_BOUNDS_CHECK définit la politique de vérification des indices de operator[] : à 1 (par défaut), un indice hors de la liste lance une IndexOutOfBoundsException (EmptyContainerException si la liste est vide) ; à 0, aucun indice n'est vérifié, comme pour un tableau C ou l'operator[] de std::vector. On peut ainsi compiler une version de production (-DLIST_BOUNDS_CHECK=0) dont les boucles chaudes sur operator[] ne font plus aucun test, en gardant les vérifications pendant la mise au point. Les autres méthodes (removeAt, tryGet...) vérifient toujours leurs indices.
+ */
+#ifndef LIST_BOUNDS_CHECK
+#define LIST_BOUNDS_CHECK 1
+#endif
+
+inline void listCheckIndex(int i, int size);
+
+template<typename T>
+class List;
+
+/**
+ * Bloc d'éléments contigus en mémoire [begin, end[ d'une liste. Les champs node et index sont à la disposition de l'implémentation pour retrouver le bloc suivant (noeud courant, numéro du bloc...). Le bloc qui suit le dernier a begin == end == nullptr.
+ */
+template<typename T>
+struct ListChunk{
+    T* begin;
+    T* end;
+    const void* node;
+    int index;
+};
+
+/**
+ * Itérateur générique sur une List<T> (V vaut T ou const T). À l'intérieur d'un bloc, l'avancée se résume à l'incrémentation d'un pointeur.
+ */
+template<typename T, typename V>
+class ListIterator
+{
+    private:
+        const List<T>* mList;
+        ListChunk<T> mChunk;
+        T* mCur; //Élément courant (nullptr en fin de parcours)
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V* pointer;
+        typedef V& reference;
+
+        /**
+         * Itérateur de fin de parcours
+         */
+        ListIterator(){
+            mList = nullptr;
+            mCur = nullptr;
+        }
+
+        /**
+         * Itérateur placé sur le premier élément de l
+         */
+        explicit ListIterator(const List<T>* l){
+            mList = l;
+            l->firstChunk(mChunk);
+            mCur = mChunk.begin;
+        }
+
+        /**
+         * Conversion d'un itérateur en itérateur constant
+         */
+        template<typename W>
+        ListIterator(const ListIterator<T, W>& o){
+            mList = o.mList;
+            mChunk = o.mChunk;
+            mCur = o.mCur;
+        }
+
+        V& operator* () const{
+            return *mCur;
+        }
+
+        V* operator-> () const{
+            return mCur;
+        }
+
+        ListIterator& operator++ (){
+            ++mCur;
+            if(mCur == mChunk.end){
+                mList->nextChunk(mChunk);
+                mCur = mChunk.begin;
+            }
+            return *this;
+        }
+
+        ListIterator operator++ (int){
+            ListIterator ret = *this;
+            ++(*this);
+            return ret;
+        }
+
+        bool operator== (const ListIterator& o) const{
+            return mCur == o.mCur;
+        }
+
+        bool operator!= (const ListIterator& o) const{
+            return mCur != o.mCur;
+        }
+
+        template<typename U, typename W>
+        friend class ListIterator;
+};
+
 template<typename T>
 class List
 {
-       
+#ifdef LIST_STATS
+    protected:
+        mutable ListStats mStats; //Compteurs d'instrumentation de cette liste (voir liststats.hpp)
+#endif
+
     public:
+        typedef ListIterator<T, T> iterator;
+        typedef ListIterator<T, const T> const_iterator;
+        typedef std::function<bool(const T&, const T&)> Comparator; //Relation d'ordre strict : cmp(a, b) vaut true si a doit être placé avant b
+        typedef std::function<bool(const T&)> Predicate; //Condition sur un élément (voir removeIf())
+
+        virtual ~List(){}
+
+        /**
+         * Compteurs d'instrumentation de cette liste (tous nuls si LIST_STATS n'est pas défini, voir liststats.hpp)
+         */
+        ListStats stats() const{
+#ifdef LIST_STATS
+            return mStats;
+#else
+            return ListStats();
+#endif
+        }
+
+        void resetStats(){
+#ifdef LIST_STATS
+            mStats.reset();
+#endif
+        }
+
         virtual void append(T e) = 0;
         virtual void prepend(T e) = 0;
         virtual T operator[] (int i) const = 0;
         virtual T& operator[] (int i) = 0; //Accès en écriture au i-ème élément de la liste 
+        virtual int size() const = 0; //Nombre d'éléments de la liste
         
         /////////////////////////////////////////
         ///////// MÉTHODES DE PARCOURS //////////
@@ -54,31 +201,347 @@ class List
         virtual void remove(T e) = 0;
 
         /**
-         * Renvoie la position de l'élément t dans la liste (ou -1 si il n'a pas été trouvé). La méthode de parcours utilisée par une implémentation donnée est cachée derrière les méthodes abstraites first(), next() et hasNext().
+         * Supprime le i-ème élément de la liste (IndexOutOfBoundsException si il n'existe pas)
          */
-        int pos(T t){
+        virtual void removeAt(int i) = 0;
+
+        /**
+         * Parcours par blocs contigus (utilisé par ListIterator) : firstChunk() place c sur le premier bloc de la liste, nextChunk() sur le bloc suivant. Les blocs renvoyés ne sont jamais vides.
+         */
+        virtual void firstChunk(ListChunk<T>& c) const = 0;
+        virtual void nextChunk(ListChunk<T>& c) const = 0;
+
+        /**
+         * Itérateurs externes (voir l'en-tête de ce fichier)
+         */
+        iterator begin(){
+            return iterator(this);
+        }
+
+        iterator end(){
+            return iterator();
+        }
+
+        const_iterator begin() const{
+            return const_iterator(this);
+        }
+
+        const_iterator end() const{
+            return const_iterator();
+        }
+
+        /**
+         * Renvoie la position de la première occurrence de t dans la liste, ou -1 si elle n'est pas présente. L'implémentation par défaut parcourt la liste avec un itérateur externe : aucun état partagé n'est modifié, plusieurs threads peuvent donc faire des recherches en même temps. Les implémentations la redéfinissent avec un parcours sans appel virtuel par élément (voire vectorisé, voir simdsearch.hpp).
+         */
+        virtual int indexOf(const T& t) const{
             int i = 0;
-            this->first();
-            while(this->hasNext()){
-                if(t == this->next())
+            for(const_iterator it = this->begin(); it != this->end(); ++it){
+                if(t == *it)
                     return i;
                 i++;
             }
-            throw ElementNotFoundException<T>(t);
             return -1;
         }
 
+        /**
+         * Renvoie la position de l'élément t dans la liste, ou lance une ElementNotFoundException si il n'a pas été trouvé (voir indexOf()).
+         */
+        int pos(T t) const{
+            if(this->size() == 0)
+                throw EmptyContainerException();
+            int i = this->indexOf(t);
+            if(i == -1)
+                throw ElementNotFoundException<T>(t);
+            return i;
+        }
+
+        /////////////////////////////////////////
+        //////// ACCÈS SANS EXCEPTION ///////////
+        /////////////////////////////////////////
+
+        /**
+         * Pour qui un élément absent ou un indice invalide n'a rien d'exceptionnel, les méthodes suivantes signalent l'échec par leur valeur de retour au lieu de lancer une exception (dont le déroulement de pile coûte bien plus cher qu'une recherche) : indexOf() renvoie -1, tryGet() et pollFirst()/pollLast() un std::optional vide, tryRemove() false.
+         */
+
+        /**
+         * Copie du i-ème élément, ou rien si i n'est pas un indice de la liste
+         */
+        virtual std::optional<T> tryGet(int i) const{
+            if((unsigned)i >= (unsigned)this->size())
+                return std::nullopt;
+            return (*this)[i];
+        }
+
+        /**
+         * Supprime la première occurrence de e et renvoie true, ou renvoie false si e n'est pas dans la liste (sans exception, contrairement à remove())
+         */
+        virtual bool tryRemove(const T& e){
+            int i = this->indexOf(e);
+            if(i == -1)
+                return false;
+            this->removeAt(i);
+            return true;
+        }
+
+        /**
+         * Retire et renvoie le premier (ou le dernier) élément de la liste, EmptyContainerException si elle est vide
+         */
+        virtual T removeFirst(){
+            if(this->size() == 0)
+                throw EmptyContainerException();
+            T ret = std::move((*this)[0]);
+            this->removeAt(0);
+            return ret;
+        }
+
+        virtual T removeLast(){
+            int n = this->size();
+            if(n == 0)
+                throw EmptyContainerException();
+            T ret = std::move((*this)[n - 1]);
+            this->removeAt(n - 1);
+            return ret;
+        }
+
+        /**
+         * Comme removeFirst() et removeLast(), mais renvoie un std::optional vide si la liste est vide (comme pollFirst() et pollLast() en Java)
+         */
+        std::optional<T> pollFirst(){
+            if(this->size() == 0)
+                return std::nullopt;
+            return this->removeFirst();
+        }
+
+        std::optional<T> pollLast(){
+            if(this->size() == 0)
+                return std::nullopt;
+            return this->removeLast();
+        }
+
+        /////////////////////////////////////////
+        ///////// OPÉRATIONS PAR LOTS ///////////
+        /////////////////////////////////////////
+
+        /**
+         * Ajout en fin de liste de tous les éléments de o (qui peut être cette liste elle-même). L'implémentation par défaut ajoute les éléments un à un ; Vector réserve la place une seule fois et copie chaque bloc contigu d'un coup.
+         */
+        virtual void appendAll(const List<T>& o){
+            if(&o == this){ //Les ajouts peuvent invalider un itérateur sur cette liste : on passe par les indices
+                int n = o.size();
+                for(int k = 0; k < n; k++)
+                    this->append(o[k]);
+                return;
+            }
+            for(const T& e : o)
+                this->append(e);
+        }
+
+        /**
+         * Ajout en fin de liste des éléments de [first, last[ (des std::move_iterator les déplacent au lieu de les copier). L'intervalle ne doit pas porter sur cette liste.
+         */
+        template<typename It>
+        void appendAll(It first, It last){
+            for(; first != last; ++first)
+                this->append(*first);
+        }
+
+        /**
+         * Insère les éléments de o (qui peut être cette liste elle-même) devant le i-ème élément, dans leur ordre (0 <= i <= size(), i == size() revient à appendAll()). L'implémentation par défaut retire la fin de la liste avec removeLast(), ajoute les nouveaux éléments puis remet la fin : O(size() - i + o.size()) opérations. Vector décale la fin une seule fois, LinkedList insère une chaîne de noeuds d'un coup.
+         */
+        virtual void insertRange(int i, const List<T>& o){
+            if(i < 0 || this->size() < i)
+                throw IndexOutOfBoundsException();
+
+            int n = o.size(); //Les éléments de o sont d'abord copiés : o peut être cette liste
+            std::allocator<T> alloc;
+            T* tmp = alloc.allocate(n > 0 ? n : 1);
+            int k = 0;
+            for(const T& e : o){
+                if(k == n)
+                    break;
+                ::new(static_cast<void*>(tmp + k++)) T(e);
+            }
+            this->insertRange(i, std::make_move_iterator(tmp), std::make_move_iterator(tmp + n));
+            for(k = 0; k < n; k++)
+                tmp[k].~T();
+            alloc.deallocate(tmp, n > 0 ? n : 1);
+        }
+
+        /**
+         * Insertion des éléments de [first, last[ devant le i-ème élément (l'intervalle ne doit pas porter sur cette liste)
+         */
+        template<typename It>
+        void insertRange(int i, It first, It last){
+            int n = this->size();
+            if(i < 0 || n < i)
+                throw IndexOutOfBoundsException();
+
+            int tail = n - i;
+            std::allocator<T> alloc;
+            T* tmp = alloc.allocate(tail > 0 ? tail : 1);
+            for(int k = tail - 1; k >= 0; k--)
+                ::new(static_cast<void*>(tmp + k)) T(this->removeLast());
+            for(; first != last; ++first)
+                this->append(*first);
+            for(int k = 0; k < tail; k++){
+                this->append(std::move(tmp[k]));
+                tmp[k].~T();
+            }
+            alloc.deallocate(tmp, tail > 0 ? tail : 1);
+        }
+
+        /**
+         * Ajout en début de liste de tous les éléments de o, dans leur ordre
+         */
+        virtual void prependAll(const List<T>& o){
+            this->insertRange(0, o);
+        }
+
+        template<typename It>
+        void prependAll(It first, It last){
+            this->insertRange(0, first, last);
+        }
+
+        /**
+         * Supprime tous les éléments qui vérifient pred et renvoie leur nombre. L'implémentation par défaut compacte la liste en un seul parcours (les éléments gardés sont déplacés vers l'avant avec les itérateurs externes) puis retire la fin avec removeLast() ; Vector et LinkedList font de même sans appel virtuel. Dans tous les cas, le coût est O(size()) appels à pred.
+         */
+        virtual int removeIf(const Predicate& pred){
+            iterator w = this->begin();
+            int kept = 0;
+            for(iterator r = this->begin(); r != this->end(); ++r){
+                if(pred(*r))
+                    continue;
+                if(&*w != &*r)
+                    *w = std::move(*r);
+                ++w;
+                kept++;
+            }
+            int removed = this->size() - kept;
+            for(int k = 0; k < removed; k++)
+                this->removeLast();
+            return removed;
+        }
+
+        template<typename Pred>
+        int removeIf(Pred pred){
+            return this->removeIf(Predicate(pred));
+        }
+
+        /**
+         * Supprime tous les éléments présents dans values (toutes leurs occurrences) et renvoie leur nombre. Chaque élément est cherché dans values avec indexOf() : O(size()) recherches en tout, en temps constant si values est une IndexedList.
+         */
+        int removeAll(const List<T>& values){
+            if(&values == this){
+                int n = this->size();
+                for(int k = 0; k < n; k++)
+                    this->removeLast();
+                return n;
+            }
+            return this->removeIf([&values](const T& e){ return values.indexOf(e) != -1; });
+        }
+
+        /**
+         * Ne garde que les éléments présents dans values et renvoie le nombre d'éléments supprimés
+         */
+        int retainAll(const List<T>& values){
+            if(&values == this)
+                return 0;
+            return this->removeIf([&values](const T& e){ return values.indexOf(e) == -1; });
+        }
+
+        /////////////////////////////////////////
+        ///////////////// TRI ///////////////////
+        /////////////////////////////////////////
+
+        /**
+         * Trie la liste en place selon cmp. L'implémentation par défaut déplace les éléments dans un tableau temporaire, le trie (voir sort.hpp) et les remet en place à l'aide des itérateurs externes. Les implémentations concrètes trient sans tableau intermédiaire, et leurs méthodes sort() template évitent en plus l'appel indirect à cmp à chaque comparaison.
+         */
+        virtual void sort(const Comparator& cmp){
+            int n = this->size();
+            if(n < 2)
+                return;
+            std::allocator<T> alloc;
+            T* tmp = alloc.allocate(n);
+            int i = 0;
+            for(T& e : *this)
+                ::new(static_cast<void*>(tmp + i++)) T(std::move(e));
+            arraySort(tmp, tmp + n, cmp);
+            i = 0;
+            for(T& e : *this){
+                e = std::move(tmp[i]);
+                tmp[i++].~T();
+            }
+            alloc.deallocate(tmp, n);
+        }
+
+        /**
+         * Tri selon l'opérateur <
+         */
+        void sort(){
+            this->sort(Comparator(std::less<T>()));
+        }
+
+        template<typename Cmp>
+        void sort(Cmp cmp){
+            this->sort(Comparator(cmp));
+        }
+
+        /**
+         * Renvoie true si la liste est triée selon cmp (opérateur < par défaut)
+         */
+        template<typename Cmp>
+        bool isSorted(Cmp cmp) const{
+            const_iterator it = this->begin();
+            if(it == this->end())
+                return true;
+            const T* prev = &*it;
+            for(++it; it != this->end(); ++it){
+                if(cmp(*it, *prev))
+                    return false;
+                prev = &*it;
+            }
+            return true;
+        }
+
+        bool isSorted() const{
+            return this->isSorted(std::less<T>());
+        }
+
+        /**
+         * Recherche dichotomique de key dans la liste, qui doit être triée selon cmp (opérateur < par défaut). Comme en Java, renvoie la position de key si elle est présente (n'importe laquelle si elle l'est plusieurs fois), et sinon -(point d'insertion) - 1, où le point d'insertion est la position du premier élément plus grand que key (size() s'il n'y en a pas) : le résultat est positif si et seulement si key a été trouvée.
+         *
+         * La recherche se fait par blocs contigus (voir ListChunk) : on compare key au dernier élément de chaque bloc jusqu'à trouver le bloc qui peut la contenir, puis on cherche par dichotomie dans ce bloc. Elle coûte donc O(log n) comparaisons sur un Vector, mais O(n) sur une LinkedList (un bloc par noeud).
+         */
+        template<typename Cmp>
+        int binarySearch(const T& key, Cmp cmp) const{
+            ListChunk<T> c;
+            int offset = 0;
+            for(this->firstChunk(c); c.begin != nullptr; this->nextChunk(c)){
+                if(!cmp(*(c.end - 1), key)){
+                    const T* p = arrayLowerBound<T>(c.begin, c.end, key, cmp);
+                    int i = offset + (int)(p - c.begin);
+                    return cmp(key, *p) ? -i - 1 : i;
+                }
+                offset += (int)(c.end - c.begin);
+            }
+            return -offset - 1;
+        }
+
+        int binarySearch(const T& key) const{
+            return this->binarySearch(key, std::less<T>());
+        }
+
     /**
      * Surcharge de l'opérateur binaire externe << pour afficher la liste.
      */
     friend std::ostream& operator<< (std::ostream& flux, List<T> const& l){
-        l.first();
         flux << "{";
-        while(l.hasNext()){
-            T e = l.next();
-            flux << e;
-            if(l.hasNext())
+        bool firstElt = true;
+        for(const T& e : l){
+            if(!firstElt)
                 flux << ", ";
+            flux << e;
+            firstElt = false;
         }
         flux << "}";
         return flux;
@@ -88,7 +551,7 @@ class List
 /**
  * Classes de gestion des exceptions : 
  *
- * On définit deux types d'exception possible : le conteneur est vide et on essaie d'accéder à un élément ; on essaie d'accéder à un élément donc l'indice n'est pas dépasse la taille du conteneur (ou est strictement négatif) ; on recherche un élément qui n'est pas présent dans la liste.
+ * On définit quatre types d'exception possible : le conteneur est vide et on essaie d'accéder à un élément ; on essaie d'accéder à un élément donc l'indice n'est pas dépasse la taille du conteneur (ou est strictement négatif) ; on recherche un élément qui n'est pas présent dans la liste ; on tente une opération que le conteneur ne permet pas (écriture dans un conteneur en lecture seule).
  *
  */
 class EmptyContainerException : public std::exception
@@ -96,6 +559,9 @@ class EmptyContainerException : public std::exception
     public:
         EmptyContainerException(){
             std::exception(); //Appel du constructeur de la classe mère
+#ifdef LIST_STATS
+            ListStatsThread::local().add(LIST_STAT_EXCEPTIONS, 1);
+#endif
         }
 
         /**
@@ -111,6 +577,9 @@ class IndexOutOfBoundsException : public std::exception
     public:
         IndexOutOfBoundsException(){
             std::exception(); //Appel du constructeur de la classe mère
+#ifdef LIST_STATS
+            ListStatsThread::local().add(LIST_STAT_EXCEPTIONS, 1);
+#endif
         }
 
         const char* what() const throw(){
@@ -118,22 +587,76 @@ class IndexOutOfBoundsException : public std::exception
         }
 };
 
+/**
+ * Opération interdite sur ce conteneur (écriture dans un conteneur en lecture seule...), comme l'UnsupportedOperationException de Java
+ */
+class UnsupportedOperationException : public std::exception
+{
+    public:
+        UnsupportedOperationException(){
+            std::exception(); //Appel du constructeur de la classe mère
+#ifdef LIST_STATS
+            ListStatsThread::local().add(LIST_STAT_EXCEPTIONS, 1);
+#endif
+        }
+
+        const char* what() const throw(){
+            return "This operation is not supported by the container (it may be read-only).";
+        }
+};
+
 template<typename T>
 class ElementNotFoundException : public std::exception
 {
     T el;
+    mutable std::string msg; //Message, construit au premier appel de what() : lancer l'exception ne coûte donc aucun formatage
 
     public:
         ElementNotFoundException(T el) : el(el){
             std::exception(); //Appel du constructeur de la classe mère
+#ifdef LIST_STATS
+            ListStatsThread::local().add(LIST_STAT_EXCEPTIONS, 1);
+#endif
         }
 
-        const char* what() const throw(){ //Notez le passage par un StringStream pour afficher l'élement this->el en appelant l'opérateur de signature "std::ostream& << (std::ostream&, const T&)"
-            std::stringstream msgstm;
-            msgstm << "The element you requested (" << this->el << ") wasn't found in the list.";
-            return msgstm.str().c_str();
+        /**
+         * Élément qui n'a pas été trouvé
+         */
+        const T& element() const{
+            return this->el;
+        }
+
+        const char* what() const throw(){ //Notez le passage par un StringStream pour afficher l'élement this->el en appelant l'opérateur de signature "std::ostream& << (std::ostream&, const T&)". Le message est gardé dans l'exception : le pointeur renvoyé reste valide aussi longtemps qu'elle.
+            if(this->msg.empty()){
+                std::stringstream msgstm;
+                msgstm << "The element you requested (" << this->el << ") wasn't found in the list.";
+                this->msg = msgstm.str();
+            }
+            return this->msg.c_str();
         }
 };
 
+/**
+ * Lance l'exception qui correspond à un indice invalide dans une liste de taille size. Elle est séparée de listCheckIndex() pour que le chemin normal de ce dernier se résume à une comparaison.
+ */
+[[noreturn]] __attribute__((noinline, cold)) inline void listIndexError(int size){
+    if(size == 0)
+        throw EmptyContainerException();
+    throw IndexOutOfBoundsException();
+}
+
+/**
+ * Vérification d'un indice par operator[] (rien du tout si LIST_BOUNDS_CHECK vaut 0). Une seule comparaison non signée couvre à la fois i < 0 et i >= size.
+ */
+inline void listCheckIndex(int i, int size){
+#if LIST_BOUNDS_CHECK
+    if((unsigned)i >= (unsigned)size)
+        listIndexError(size);
+#else
+    (void)i;
+    (void)size;
+#endif
+}
+
 
 #endif
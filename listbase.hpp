@@ -0,0 +1,94 @@
+#ifndef _LISTBASE_H_
+#define _LISTBASE_H_
+
+/**
+ * Couche de polymorphisme statique (CRTP, "Curiously Recurring Template Pattern") pour les listes.
+ *
+ * List<T> est une interface virtuelle : chaque appel à next(), hasNext() ou operator[] à travers un List<T>* est un appel indirect que le compilateur ne peut ni inliner ni vectoriser. ListBase<Derived, T> propose les mêmes algorithmes de parcours écrits une seule fois, mais résolus à la compilation : Derived est la classe concrète (Vector<T>, LinkedList<T>...) et ListBase appelle directement ses begin() et end(). Dans une boucle chaude ou un algorithme générique (template<typename L> ...), on obtient donc un code entièrement inliné.
+ *
+ * Une implémentation hérite à la fois de List<T> (qui reste disponible pour le polymorphisme dynamique) et de ListBase<Implementation<T>, T> :
+ *
+ *     template<typename T>
+ *     class Vector : public List<T>, public ListBase<Vector<T>, T>
+ */
+
+template<typename Derived, typename T>
+class ListBase
+{
+    protected:
+        Derived& self(){
+            return static_cast<Derived&>(*this);
+        }
+
+        const Derived& self() const{
+            return static_cast<const Derived&>(*this);
+        }
+
+    public:
+        /**
+         * Applique f à chaque élément (par référence) dans l'ordre de la liste
+         */
+        template<typename F>
+        void forEach(F f){
+            for(auto it = self().begin(), end = self().end(); it != end; ++it)
+                f(*it);
+        }
+
+        template<typename F>
+        void forEach(F f) const{
+            for(auto it = self().begin(), end = self().end(); it != end; ++it)
+                f(*it);
+        }
+
+        /**
+         * Réduction de la liste : renvoie op(...op(op(init, e0), e1)..., en-1)
+         */
+        template<typename U, typename Op>
+        U fold(U init, Op op) const{
+            for(auto it = self().begin(), end = self().end(); it != end; ++it)
+                init = op(init, *it);
+            return init;
+        }
+
+        /**
+         * Position du premier élément vérifiant le prédicat p, -1 si il n'y en a pas
+         */
+        template<typename P>
+        int findIf(P p) const{
+            int i = 0;
+            for(auto it = self().begin(), end = self().end(); it != end; ++it, ++i){
+                if(p(*it))
+                    return i;
+            }
+            return -1;
+        }
+
+        /**
+         * Nombre d'éléments vérifiant le prédicat p
+         */
+        template<typename P>
+        int countIf(P p) const{
+            int n = 0;
+            for(auto it = self().begin(), end = self().end(); it != end; ++it){
+                if(p(*it))
+                    n++;
+            }
+            return n;
+        }
+
+        /**
+         * Position de la première occurrence de t, -1 si elle n'est pas présente (équivalent de pos() sans exception ni appel virtuel)
+         */
+        int indexOf(const T& t) const{
+            return this->findIf([&t](const T& e){ return e == t; });
+        }
+
+        /**
+         * Appartenance de t à la liste (utilise la recherche la plus rapide de l'implémentation)
+         */
+        bool contains(const T& t) const{
+            return self().indexOf(t) != -1;
+        }
+};
+
+#endif
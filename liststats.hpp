@@ -0,0 +1,209 @@
+#ifndef _LISTSTATS_H_
+#define _LISTSTATS_H_
+
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/**
+ * Compteurs d'instrumentation des conteneurs, activés en définissant la variable de préprocesseur LIST_STATS avant d'inclure les en-têtes (-DLIST_STATS). Sans elle, les conteneurs n'ont aucun membre ni aucune instruction de plus : la macro LIST_STAT ne produit aucun code et stats() renvoie des compteurs nuls.
+ *
+ * Chaque conteneur (List<T>) compte ses réallocations, les éléments qu'il copie ou déplace, les octets décalés par les insertions et suppressions au milieu d'un tableau, ses allocations et libérations de noeuds et les pas de parcours (noeuds ou éléments traversés pour atteindre une position ou trouver un élément) : voir stats(). Les mêmes compteurs sont cumulés par thread (ListStats::thread()), sans synchronisation coûteuse : seul le thread propriétaire écrit ses compteurs, les autres se contentent de les lire. ListStats::global() fait la somme de tous les threads, y compris ceux qui sont terminés.
+ *
+ * Les exceptions lancées par les conteneurs (EmptyContainerException...) ne savent pas de quel conteneur elles viennent : elles ne sont comptées que par thread.
+ *
+ * Les compteurs s'affichent en texte (operator<<, "reallocations=3 copies=0 ...") ou en JSON (toJson()), par exemple pour être exposés par un service.
+ */
+
+/**
+ * Les différents compteurs
+ */
+enum ListStat{
+    LIST_STAT_REALLOCATIONS, //Réallocations du tableau
+    LIST_STAT_COPIES, //Éléments copiés
+    LIST_STAT_MOVES, //Éléments déplacés
+    LIST_STAT_BYTES_SHIFTED, //Octets décalés par les insertions et suppressions
+    LIST_STAT_NODE_ALLOCATIONS, //Noeuds alloués
+    LIST_STAT_NODE_FREES, //Noeuds libérés
+    LIST_STAT_TRAVERSAL_STEPS, //Noeuds ou éléments traversés
+    LIST_STAT_EXCEPTIONS, //Exceptions lancées (par thread seulement)
+    LIST_STAT_COUNT
+};
+
+/**
+ * Valeurs des compteurs (d'un conteneur, d'un thread ou de tout le programme)
+ */
+struct ListStats{
+    unsigned long long counts[LIST_STAT_COUNT];
+
+    ListStats(){
+        this->reset();
+    }
+
+    void reset(){
+        for(int i = 0; i < LIST_STAT_COUNT; i++)
+            counts[i] = 0;
+    }
+
+    unsigned long long operator[] (ListStat s) const{
+        return counts[s];
+    }
+
+    ListStats& operator+= (const ListStats& o){
+        for(int i = 0; i < LIST_STAT_COUNT; i++)
+            counts[i] += o.counts[i];
+        return *this;
+    }
+
+    static const char* name(int i){
+        static const char* names[LIST_STAT_COUNT] = {"reallocations", "copies", "moves", "bytes_shifted", "node_allocations", "node_frees", "traversal_steps", "exceptions"};
+        return names[i];
+    }
+
+    /**
+     * Objet JSON {"reallocations": 3, ...}
+     */
+    std::string toJson() const{
+        std::ostringstream out;
+        out << "{";
+        for(int i = 0; i < LIST_STAT_COUNT; i++)
+            out << (i == 0 ? "" : ", ") << "\"" << name(i) << "\": " << counts[i];
+        out << "}";
+        return out.str();
+    }
+
+    friend std::ostream& operator<< (std::ostream& flux, const ListStats& s){
+        for(int i = 0; i < LIST_STAT_COUNT; i++)
+            flux << (i == 0 ? "" : " ") << name(i) << "=" << s.counts[i];
+        return flux;
+    }
+
+    /**
+     * Compteurs cumulés du thread courant
+     */
+    static ListStats thread();
+
+    /**
+     * Compteurs cumulés de tous les threads (somme approximative si d'autres threads travaillent pendant l'appel)
+     */
+    static ListStats global();
+
+    /**
+     * Remet à zéro les compteurs du thread courant
+     */
+    static void resetThread();
+};
+
+/**
+ * Compteurs d'un thread. Ils sont atomiques pour que global() puisse les lire depuis un autre thread, mais seul leur propriétaire les écrit : une incrémentation est une simple lecture suivie d'une écriture (sans instruction verrouillée).
+ */
+class ListStatsThread
+{
+    private:
+        std::atomic<unsigned long long> mCounts[LIST_STAT_COUNT];
+        ListStatsThread* mPrev; //Liste des threads en cours (protégée par registryMutex())
+        ListStatsThread* mNext;
+
+        static std::mutex& registryMutex(){
+            static std::mutex m;
+            return m;
+        }
+
+        static ListStatsThread*& registryHead(){
+            static ListStatsThread* head = nullptr;
+            return head;
+        }
+
+        /**
+         * Compteurs des threads terminés
+         */
+        static ListStats& retired(){
+            static ListStats s;
+            return s;
+        }
+
+        ListStatsThread(){
+            for(int i = 0; i < LIST_STAT_COUNT; i++)
+                mCounts[i].store(0, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(registryMutex());
+            mPrev = nullptr;
+            mNext = registryHead();
+            if(mNext != nullptr)
+                mNext->mPrev = this;
+            registryHead() = this;
+        }
+
+        ~ListStatsThread(){
+            std::lock_guard<std::mutex> lock(registryMutex());
+            retired() += this->snapshot();
+            if(mPrev != nullptr)
+                mPrev->mNext = mNext;
+            else
+                registryHead() = mNext;
+            if(mNext != nullptr)
+                mNext->mPrev = mPrev;
+        }
+
+    public:
+        static ListStatsThread& local(){
+            static thread_local ListStatsThread t;
+            return t;
+        }
+
+        void add(ListStat s, unsigned long long n){
+            mCounts[s].store(mCounts[s].load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        ListStats snapshot() const{
+            ListStats s;
+            for(int i = 0; i < LIST_STAT_COUNT; i++)
+                s.counts[i] = mCounts[i].load(std::memory_order_relaxed);
+            return s;
+        }
+
+        void reset(){
+            for(int i = 0; i < LIST_STAT_COUNT; i++)
+                mCounts[i].store(0, std::memory_order_relaxed);
+        }
+
+        static ListStats sum(){
+            std::lock_guard<std::mutex> lock(registryMutex());
+            ListStats s = retired();
+            for(ListStatsThread* t = registryHead(); t != nullptr; t = t->mNext)
+                s += t->snapshot();
+            return s;
+        }
+};
+
+inline ListStats ListStats::thread(){
+    return ListStatsThread::local().snapshot();
+}
+
+inline ListStats ListStats::global(){
+    return ListStatsThread::sum();
+}
+
+inline void ListStats::resetThread(){
+    ListStatsThread::local().reset();
+}
+
+/**
+ * Ajoute n au compteur s d'un conteneur et à celui du thread courant
+ */
+inline void listStatAdd(ListStats& instance, ListStat s, unsigned long long n){
+    instance.counts[s] += n;
+    ListStatsThread::local().add(s, n);
+}
+
+/**
+ * LIST_STAT(MOVES, n) dans une méthode d'un conteneur ajoute n au compteur LIST_STAT_MOVES (rien du tout sans LIST_STATS : n n'est même pas évalué)
+ */
+#ifdef LIST_STATS
+#define LIST_STAT(stat, n) listStatAdd(this->mStats, LIST_STAT_##stat, (unsigned long long)(n))
+#else
+#define LIST_STAT(stat, n) ((void)0)
+#endif
+
+#endif
@@ -1,17 +1,18 @@
 #include <iostream>
+#include <string>
 
 #include "list.hpp"
 #include "vector.hpp"
 #include "linkedlist.hpp"
+#include "deque.hpp"
+#include "unrolledlist.hpp"
 
 using namespace std;
 
-int main(int argc, char** argv){
-    
-    /////// TEST DU TYPE LinkedList ///////
-
-    List<int>* v = new LinkedList<int>(); //Création d'une liste (remarquez au passage l'utilisation du polymorphisme)
-
+/**
+ * Série de tests commune à toutes les implémentations de List<int> (remarquez au passage l'utilisation du polymorphisme)
+ */
+void testList(List<int>* v){
     //Ajout d'éléments en début et en fin de liste
     for(int i = 1; i < 10; i++){
         v->append(i);
@@ -46,47 +47,57 @@ int main(int argc, char** argv){
     }
 
     cout << *v << endl;
+}
 
-    delete v; //Libération de la mémoire
-
-    v = new Vector<int>(); //Création d'une liste (remarquez au passage l'utilisation du polymorphisme)
-
-    //Ajout d'éléments en début et en fin de liste
-    for(int i = 1; i < 10; i++){
-        v->append(i);
-        v->prepend(-i);
-    }
-    (*v)[0] = 77; //Modification d'un élément à l'aide de l'opérateur []
-
-    cout << *v << endl; //Affichage (et donc preuve que les méthodes first(), hasNext() et next() fonctionnent comme prévu)
-
-    try{
-        cout << v->pos(2) << endl;
-        cout << v->pos(12) << endl; //Va renvoyer une ElementNotFoundException
-    }catch(ElementNotFoundException<int> e){
-        cout << e.what() << endl;
-    }
+int main(int argc, char** argv){
 
-    try{
-        cout << (*v)[128] << endl; //Va renvoyer une IndexOutOfBoundsException
-    }
-    catch(IndexOutOfBoundsException e){
-        cout << e.what() << endl;
-    }
+    /////// TEST DU TYPE LinkedList ///////
 
-    cout << v->last() << endl;
+    List<int>* v = new LinkedList<int>(); //Création d'une liste
+    testList(v);
+    delete v; //Libération de la mémoire
 
-    try{
-        v->remove(5);
-        v->remove(13);
-        v->remove(7); // Ne sera pas exécuté car la ligne au dessus lance une exception
-    }catch(ElementNotFoundException<int> e){
-        cout << e.what() << endl;
+    /////// TEST DU TYPE Vector ///////
+
+    v = new Vector<int>();
+    testList(v);
+    delete v;
+
+    /////// TEST DU TYPE Deque ///////
+
+    v = new Deque<int>();
+    testList(v);
+    delete v;
+
+    /////// TEST DU TYPE UnrolledList ///////
+
+    v = new UnrolledList<int>();
+    testList(v);
+    delete v;
+
+    //Suppressions pendant un parcours par first()/next() : le curseur doit suivre les noeuds vidés, fusionnés ou coupés
+    UnrolledList<string> u;
+    for(int i = 0; i < 3; i++)
+        u.append(to_string(i));
+    u.first();
+    for(int i = 0; i < 3; i++)
+        u.removeAt(0);
+    cout << (u.hasNext() ? "ERREUR" : "OK") << endl;
+
+    UnrolledList<int> w; //Plusieurs noeuds : on retire chaque élément pair juste après l'avoir lu
+    for(int i = 0; i < 200; i++)
+        w.append(i);
+    int visited = 0, expected = 0;
+    bool inOrder = true;
+    w.first();
+    while(w.hasNext()){
+        int x = w.next();
+        inOrder = inOrder && x == expected++;
+        visited++;
+        if(x % 2 == 0)
+            w.remove(x);
     }
-
-    cout << *v << endl;
-
-    delete v; //Libération de la mémoire
+    cout << (inOrder && visited == 200 && w.size() == 100 && w.first() == 1 ? "OK" : "ERREUR") << endl;
 
     return 0;
 }
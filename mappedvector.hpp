@@ -0,0 +1,553 @@
+#ifndef _MAPPEDVECTOR_H_
+#define _MAPPEDVECTOR_H_
+
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "list.hpp"
+#include "listbase.hpp"
+#include "simdsearch.hpp"
+#include "vector.hpp"
+
+/**
+ * Vecteur stocké dans un fichier projeté en mémoire (mmap, systèmes POSIX) : l'équivalent persistant de Vector<T> pour les gros jeux de données de types trivialement copiables (int, double, structures simples...).
+ *
+ * Le fichier commence par un en-tête de MAPPED_HEADER_SIZE octets (signature, version du format, taille et alignement des éléments, marqueur de boutisme, nombre d'éléments et capacité), suivi directement du tableau d'éléments tel qu'il est en mémoire. Ouvrir un fichier existant ne lit ni ne convertit rien : les pages sont chargées par le système à la première lecture, et l'ouverture coûte O(1) quelle que soit la taille des données. Un fichier écrit sur une machine de boutisme ou de format différent est refusé à l'ouverture (MappedFileException).
+ *
+ * La projection est partagée (MAP_SHARED) : les modifications sont visibles immédiatement des autres processus qui projettent le même fichier, et écrites sur le disque par le système quand il le décide, ou au plus tard lors d'un appel à flush(). Plusieurs processus peuvent ouvrir le même fichier en lecture seule (MAPPED_READ_ONLY) et partager ainsi les mêmes pages en mémoire. Une MappedVector en lecture seule lance une UnsupportedOperationException à toute tentative de modification par ses méthodes (append(), prepend(), remove()...) ; les accès directs aux éléments, en revanche, ne vérifient rien : lire par l'operator[] non constant, data() ou un itérateur non constant fonctionne, mais écrire par la référence ou le pointeur obtenu provoque une erreur de segmentation.
+ *
+ * Lorsque le tableau est plein, le fichier est agrandi (ftruncate) d'un facteur VECTOR_GROWTH_FACTOR puis reprojeté (mremap sous Linux, qui déplace la projection sans copier les pages) : comme pour Vector, les pointeurs et références sur les éléments sont alors invalidés. La capacité restée libre en fin de fichier est conservée à la fermeture (shrinkToFit() la rend).
+ *
+ * Le nombre d'éléments est lu à l'ouverture : une MappedVector ne voit pas les éléments ajoutés ensuite par un autre processus.
+ */
+
+/**
+ * Taille de l'en-tête du fichier, qui fixe aussi l'alignement maximal des éléments
+ */
+#define MAPPED_HEADER_SIZE 64
+
+/**
+ * Version du format de fichier
+ */
+#define MAPPED_FORMAT_VERSION 1
+
+/**
+ * Modes d'ouverture d'une MappedVector
+ */
+enum MappedMode{
+    MAPPED_READ_ONLY, //Fichier existant, en lecture seule
+    MAPPED_READ_WRITE, //Fichier existant, créé s'il n'existe pas
+    MAPPED_CREATE //Nouveau fichier vide (un fichier existant est écrasé)
+};
+
+/**
+ * En-tête d'un fichier de MappedVector
+ */
+struct MappedHeader{
+    char magic[8]; //"CJCMVEC"
+    std::uint32_t version;
+    std::uint32_t endian; //0x01020304 écrit dans le boutisme de la machine
+    std::uint32_t eltSize;
+    std::uint32_t eltAlign;
+    std::uint64_t size; //Nombre d'éléments
+    std::uint64_t capacity; //Nombre d'éléments que peut contenir le fichier
+};
+
+static_assert(sizeof(MappedHeader) <= MAPPED_HEADER_SIZE, "l'en-tête doit tenir dans MAPPED_HEADER_SIZE octets");
+
+/**
+ * Erreur d'ouverture ou d'agrandissement d'un fichier projeté (fichier absent, format incompatible, échec d'un appel système...)
+ */
+class MappedFileException : public std::exception
+{
+    std::string msg;
+
+    public:
+        MappedFileException(const std::string& path, const std::string& reason) : msg(path + " : " + reason){
+        }
+
+        const char* what() const throw(){
+            return this->msg.c_str();
+        }
+};
+
+template<typename T>
+class MappedVector : public List<T>, public ListBase<MappedVector<T>, T>
+{
+    static_assert(std::is_trivially_copyable<T>::value, "MappedVector ne peut contenir que des types trivialement copiables");
+    static_assert(alignof(T) <= MAPPED_HEADER_SIZE, "alignement des éléments trop grand pour l'en-tête");
+
+    private:
+        std::string mPath;
+        int mFd;
+        bool mReadOnly;
+        char* mBase; //Début de la projection (l'en-tête)
+        std::size_t mMapped; //Taille de la projection en octets
+        int mFilled; //Nombre d'éléments (recopié dans l'en-tête à chaque modification)
+        int mSize; //Capacité
+        mutable int mCursor; //Itérateur sur le tableau
+
+        MappedHeader* header() const{
+            return reinterpret_cast<MappedHeader*>(mBase);
+        }
+
+        T* tab() const{
+            return reinterpret_cast<T*>(mBase + MAPPED_HEADER_SIZE);
+        }
+
+        static std::string sysError(const char* what){
+            return std::string(what) + " : " + std::strerror(errno);
+        }
+
+        /**
+         * Échec à l'ouverture : on libère ce qui a déjà été obtenu avant de lancer l'exception
+         */
+        void fail(const char* what){
+            std::string reason = sysError(what);
+            this->unmap();
+            throw MappedFileException(mPath, reason);
+        }
+
+        void unmap(){
+            if(mBase != nullptr)
+                munmap(mBase, mMapped);
+            if(mFd != -1)
+                close(mFd);
+            mBase = nullptr;
+            mFd = -1;
+        }
+
+        /**
+         * Taille du fichier en octets pour une capacité donnée, arrondie à la taille des pages
+         */
+        static std::size_t bytesFor(int capacity){
+            std::size_t page = (std::size_t)sysconf(_SC_PAGESIZE);
+            std::size_t bytes = MAPPED_HEADER_SIZE + (std::size_t)capacity*sizeof(T);
+            return (bytes + page - 1) / page * page;
+        }
+
+        /**
+         * Donne au fichier la taille bytes et le reprojette ; la capacité devient le nombre d'éléments qui y tiennent. Si ftruncate() ou mremap() échoue (disque plein...), l'exception laisse le Vecteur intact.
+         */
+        void remap(std::size_t bytes){
+            LIST_STAT(REALLOCATIONS, 1);
+            if(bytes > mMapped && ftruncate(mFd, (off_t)bytes) != 0)
+                throw MappedFileException(mPath, sysError("ftruncate"));
+#ifdef __linux__
+            void* p = mremap(mBase, mMapped, bytes, MREMAP_MAYMOVE);
+            if(p == MAP_FAILED) //Le fichier a pu être agrandi, mais l'en-tête n'a pas changé : la place en plus est simplement inutilisée
+                throw MappedFileException(mPath, sysError("mremap"));
+#else
+            munmap(mBase, mMapped);
+            mBase = nullptr;
+            void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+            if(p == MAP_FAILED)
+                this->fail("mmap");
+#endif
+            mBase = static_cast<char*>(p);
+            if(bytes < mMapped && ftruncate(mFd, (off_t)bytes) != 0){
+                //Réduction : le fichier n'est raccourci qu'une fois la projection réduite, un échec lui laisse simplement de la place inutilisée
+            }
+            mMapped = bytes;
+            mSize = (int)((bytes - MAPPED_HEADER_SIZE) / sizeof(T));
+            this->header()->capacity = (std::uint64_t)mSize;
+        }
+
+        /**
+         * Agrandit le tableau pour qu'il puisse contenir au moins n éléments de plus (croissance géométrique, comme Vector)
+         */
+        void extendTab(int n){
+            this->checkWritable();
+            int need = mFilled + n;
+            if(need <= mSize)
+                return;
+            int grown = (int)(mSize * VECTOR_GROWTH_FACTOR);
+            if(grown < mSize + LIST_CLUSTER_SIZE)
+                grown = mSize + LIST_CLUSTER_SIZE;
+            this->remap(bytesFor(need > grown ? need : grown));
+        }
+
+        void checkWritable() const{
+            if(mReadOnly)
+                throw UnsupportedOperationException();
+        }
+
+        void setFilled(int n){
+            mFilled = n;
+            this->header()->size = (std::uint64_t)n;
+        }
+
+    public:
+        typedef T* iterator;
+        typedef const T* const_iterator;
+
+        /**
+         * Ouvre (ou crée, selon mode) le fichier path. Lance une MappedFileException si le fichier ne peut être ouvert ou n'est pas un fichier de MappedVector<T> écrit sur une machine compatible.
+         */
+        explicit MappedVector(const std::string& path, MappedMode mode = MAPPED_READ_WRITE) : mPath(path){
+            mFd = -1;
+            mBase = nullptr;
+            mMapped = 0;
+            mCursor = -1;
+            mReadOnly = mode == MAPPED_READ_ONLY;
+
+            int flags = mReadOnly ? O_RDONLY : O_RDWR | O_CREAT;
+            if(mode == MAPPED_CREATE)
+                flags |= O_TRUNC;
+            mFd = open(path.c_str(), flags, 0644);
+            if(mFd == -1)
+                this->fail("open");
+            struct stat st;
+            if(fstat(mFd, &st) != 0)
+                this->fail("fstat");
+
+            if(st.st_size == 0 && !mReadOnly){ //Nouveau fichier : on écrit l'en-tête
+                std::size_t bytes = bytesFor(LIST_CLUSTER_SIZE);
+                if(ftruncate(mFd, (off_t)bytes) != 0)
+                    this->fail("ftruncate");
+                void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+                if(p == MAP_FAILED)
+                    this->fail("mmap");
+                mBase = static_cast<char*>(p);
+                mMapped = bytes;
+                MappedHeader* h = this->header();
+                std::memcpy(h->magic, "CJCMVEC", 8);
+                h->version = MAPPED_FORMAT_VERSION;
+                h->endian = 0x01020304;
+                h->eltSize = sizeof(T);
+                h->eltAlign = alignof(T);
+                mSize = (int)((bytes - MAPPED_HEADER_SIZE) / sizeof(T));
+                h->capacity = (std::uint64_t)mSize;
+                this->setFilled(0);
+                return;
+            }
+
+            if((std::size_t)st.st_size < MAPPED_HEADER_SIZE){
+                this->unmap();
+                throw MappedFileException(path, "fichier trop court pour contenir un en-tête");
+            }
+            int prot = mReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+            void* p = mmap(nullptr, (std::size_t)st.st_size, prot, MAP_SHARED, mFd, 0);
+            if(p == MAP_FAILED)
+                this->fail("mmap");
+            mBase = static_cast<char*>(p);
+            mMapped = (std::size_t)st.st_size;
+
+            const MappedHeader* h = this->header();
+            const char* reason = nullptr;
+            if(std::memcmp(h->magic, "CJCMVEC", 8) != 0)
+                reason = "ce n'est pas un fichier de MappedVector";
+            else if(h->version != MAPPED_FORMAT_VERSION)
+                reason = "version du format non reconnue";
+            else if(h->endian != 0x01020304)
+                reason = "fichier écrit sur une machine de boutisme différent";
+            else if(h->eltSize != sizeof(T) || h->eltAlign != alignof(T))
+                reason = "taille ou alignement des éléments différents";
+            else if(h->size > h->capacity || h->capacity > (std::uint64_t)INT_MAX || MAPPED_HEADER_SIZE + h->capacity*sizeof(T) > mMapped)
+                reason = "fichier tronqué";
+            if(reason != nullptr){
+                this->unmap();
+                throw MappedFileException(path, reason);
+            }
+            mSize = (int)h->capacity;
+            mFilled = (int)h->size;
+        }
+
+        MappedVector(const MappedVector<T>&) = delete;
+        MappedVector<T>& operator= (const MappedVector<T>&) = delete;
+
+        /**
+         * Ferme le fichier. Les modifications restent dans le cache du système, qui les écrira sur le disque ; appeler flush() avant pour s'assurer qu'elles y sont.
+         */
+        ~MappedVector(){
+            this->unmap();
+        }
+
+        /**
+         * Écrit sur le disque les modifications faites jusqu'ici (msync). Si async vaut true, l'écriture est seulement programmée et flush() revient immédiatement.
+         */
+        void flush(bool async = false){
+            if(mReadOnly)
+                return;
+            if(msync(mBase, mMapped, async ? MS_ASYNC : MS_SYNC) != 0)
+                throw MappedFileException(mPath, std::string("msync : ") + std::strerror(errno));
+        }
+
+        const std::string& path() const{
+            return mPath;
+        }
+
+        bool isReadOnly() const{
+            return mReadOnly;
+        }
+
+        /**
+         * Nombre d'éléments présents dans le Vecteur
+         */
+        int size() const{
+            return mFilled;
+        }
+
+        int capacity() const{
+            return mSize;
+        }
+
+        /**
+         * Agrandit le fichier pour qu'il puisse contenir au moins n éléments
+         */
+        void reserve(int n){
+            this->checkWritable();
+            if(n > mSize)
+                this->remap(bytesFor(n));
+        }
+
+        /**
+         * Réduit le fichier au strict nécessaire (à la page près)
+         */
+        void shrinkToFit(){
+            this->checkWritable();
+            std::size_t bytes = bytesFor(mFilled);
+            if(bytes < mMapped)
+                this->remap(bytes);
+        }
+
+        /**
+         * Vide le Vecteur (la capacité du fichier est conservée)
+         */
+        void clear(){
+            this->checkWritable();
+            this->setFilled(0);
+        }
+
+        void resize(int n, const T& value = T()){
+            this->checkWritable();
+            if(n > mFilled){
+                this->extendTab(n - mFilled);
+                for(int i = mFilled; i < n; i++)
+                    this->tab()[i] = value;
+            }
+            this->setFilled(n < 0 ? 0 : n);
+        }
+
+        T* data(){
+            return this->tab();
+        }
+
+        const T* data() const{
+            return this->tab();
+        }
+
+        /**
+         * Itérateurs externes : de simples pointeurs sur le tableau projeté
+         */
+        iterator begin(){
+            return this->tab();
+        }
+
+        iterator end(){
+            return this->tab() + mFilled;
+        }
+
+        const_iterator begin() const{
+            return this->tab();
+        }
+
+        const_iterator end() const{
+            return this->tab() + mFilled;
+        }
+
+        /**
+         * Le Vecteur entier forme un seul bloc contigu
+         */
+        void firstChunk(ListChunk<T>& c) const{
+            c.begin = mFilled == 0 ? nullptr : this->tab();
+            c.end = mFilled == 0 ? nullptr : this->tab() + mFilled;
+            c.node = nullptr;
+            c.index = 0;
+        }
+
+        void nextChunk(ListChunk<T>& c) const{
+            c.begin = nullptr;
+            c.end = nullptr;
+        }
+
+        void append(T e){
+            this->checkWritable();
+            if(mFilled == mSize)
+                this->extendTab(1);
+            this->tab()[mFilled] = e;
+            this->setFilled(mFilled + 1);
+        }
+
+        /**
+         * Ajoute les n éléments de src en fin de tableau (une seule copie mémoire)
+         */
+        void append(const T* src, int n){
+            if(n <= 0)
+                return;
+            this->extendTab(n);
+            std::memcpy(static_cast<void*>(this->tab() + mFilled), static_cast<const void*>(src), n*sizeof(T));
+            this->setFilled(mFilled + n);
+        }
+
+        void prepend(T e){
+            this->checkWritable();
+            if(mFilled == mSize)
+                this->extendTab(1);
+            LIST_STAT(MOVES, mFilled);
+            LIST_STAT(BYTES_SHIFTED, mFilled*sizeof(T));
+            std::memmove(static_cast<void*>(this->tab() + 1), static_cast<const void*>(this->tab()), mFilled*sizeof(T));
+            this->tab()[0] = e;
+            this->setFilled(mFilled + 1);
+        }
+
+        T operator[] (int i) const{
+            listCheckIndex(i, mFilled);
+
+            return this->tab()[i];
+        }
+
+        /**
+         * Accès par référence : sur une MappedVector en lecture seule, la lecture fonctionne mais une écriture provoque une erreur de segmentation (comme par data() et les itérateurs)
+         */
+        T& operator[] (int i){
+            listCheckIndex(i, mFilled);
+
+            return this->tab()[i];
+        }
+
+        bool hasNext() const{
+            return mCursor+1 < mFilled;
+        }
+
+        T next() const{
+            if(hasNext()){
+                mCursor++;
+                return this->tab()[mCursor];
+            }
+
+            if(mFilled == 0)
+                throw EmptyContainerException();
+
+            throw IndexOutOfBoundsException();
+        }
+
+        T first() const{
+            if(mFilled == 0)
+               throw EmptyContainerException();
+
+            mCursor = -1;
+            return this->tab()[mCursor+1];
+        }
+
+        T last() const{
+            if(mFilled == 0)
+                throw EmptyContainerException();
+
+            return this->tab()[mFilled-1];
+        }
+
+        /**
+         * Recherches dans le tableau, vectorisées comme celles de Vector (voir simdsearch.hpp)
+         */
+        int indexOf(const T& t) const{
+            return arrayIndexOf(this->tab(), mFilled, t);
+        }
+
+        int lastIndexOf(const T& t) const{
+            return arrayLastIndexOf(this->tab(), mFilled, t);
+        }
+
+        int count(const T& t) const{
+            return arrayCount(this->tab(), mFilled, t);
+        }
+
+        bool contains(const T& t) const{
+            return this->indexOf(t) != -1;
+        }
+
+        void remove(T e){
+            this->checkWritable();
+            this->removeAt(this->pos(e));
+        }
+
+        /**
+         * Supprime le i-ème élément du Vecteur
+         */
+        void removeAt(int i){
+            this->checkWritable();
+            if(mFilled == 0)
+                throw EmptyContainerException();
+
+            if(i < 0 || mFilled <= i)
+                throw IndexOutOfBoundsException();
+
+            LIST_STAT(MOVES, mFilled - i - 1);
+            LIST_STAT(BYTES_SHIFTED, (mFilled - i - 1)*sizeof(T));
+            std::memmove(static_cast<void*>(this->tab() + i), static_cast<const void*>(this->tab() + i + 1), (mFilled - i - 1)*sizeof(T));
+            this->setFilled(mFilled - 1);
+        }
+
+        /**
+         * Supprime les éléments qui vérifient pred en un seul parcours (compactage du tableau projeté, voir Vector::removeIf). Si pred lance une exception, les éléments qui restaient à examiner sont gardés et le fichier reste cohérent.
+         */
+        template<typename Pred>
+        int removeIf(Pred pred){
+            this->checkWritable();
+            T* t = this->tab();
+            int w = 0;
+            int r = 0;
+            try{
+                for(; r < mFilled; r++){
+                    if(pred(t[r]))
+                        continue;
+                    if(w != r){
+                        t[w] = t[r];
+                        LIST_STAT(MOVES, 1);
+                    }
+                    w++;
+                }
+            }catch(...){
+                if(w != r)
+                    std::memmove(static_cast<void*>(t + w), static_cast<const void*>(t + r), (mFilled - r)*sizeof(T));
+                this->setFilled(w + mFilled - r);
+                throw;
+            }
+            int removed = mFilled - w;
+            this->setFilled(w);
+            return removed;
+        }
+
+        int removeIf(const typename List<T>::Predicate& pred){
+            return this->template removeIf<const typename List<T>::Predicate&>(pred);
+        }
+
+        /**
+         * Tri en place du tableau projeté (voir sort.hpp)
+         */
+        template<typename Cmp>
+        void sort(Cmp cmp){
+            this->checkWritable();
+            arraySort(this->tab(), this->tab() + mFilled, cmp);
+        }
+
+        void sort(const typename List<T>::Comparator& cmp){
+            this->checkWritable();
+            arraySort(this->tab(), this->tab() + mFilled, cmp);
+        }
+
+        void sort(){
+            this->sort(std::less<T>());
+        }
+};
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef _NODEALLOCATOR_H_
+#define _NODEALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * Allocateurs de noeuds pour les conteneurs chaînés (LinkedList). Un allocateur de noeuds fournit :
+ *  - Node* create(args...) : alloue et construit un noeud ;
+ *  - void destroy(Node*) : détruit et libère un noeud ;
+ *  - void releaseAll() : libère d'un coup tous les noeuds encore alloués SANS appeler leur destructeur (n'a de sens que si releasesAll vaut true) ;
+ *  - des compteurs d'allocations et de libérations.
+ *
+ * HeapNodeAllocator fait un new/delete par noeud (comportement historique de LinkedList). SlabNodeAllocator découpe les noeuds dans de grands blocs contigus (les "slabs") et recycle les noeuds libérés à l'aide d'une liste chaînée intrusive de cases libres : on évite ainsi un appel à malloc par ajout et les noeuds d'une même liste restent proches en mémoire.
+ */
+
+/**
+ * Taille en octets d'un slab de SlabNodeAllocator
+ */
+#ifndef NODE_SLAB_BYTES
+#define NODE_SLAB_BYTES 65536
+#endif
+
+template<typename Node>
+class HeapNodeAllocator
+{
+    private:
+        long mAllocs; //Nombre de noeuds alloués depuis la création de l'allocateur
+        long mFrees; //Nombre de noeuds libérés
+
+    public:
+        static const bool releasesAll = false;
+
+        HeapNodeAllocator(){
+            mAllocs = 0;
+            mFrees = 0;
+        }
+
+        template<typename... Args>
+        Node* create(Args&&... args){
+            mAllocs++;
+            return new Node(std::forward<Args>(args)...);
+        }
+
+        void destroy(Node* n){
+            mFrees++;
+            delete n;
+        }
+
+        void releaseAll(){
+        }
+
+        long allocCount() const{
+            return this->mAllocs;
+        }
+
+        long freeCount() const{
+            return this->mFrees;
+        }
+};
+
+template<typename Node>
+class SlabNodeAllocator
+{
+    private:
+        /**
+         * Case d'un slab : contient soit un noeud, soit (lorsqu'elle est libre) un pointeur vers la case libre suivante.
+         */
+        union Cell{
+            Cell* nextFree;
+            alignas(Node) unsigned char storage[sizeof(Node)];
+        };
+
+        /**
+         * Un slab est un en-tête (chaînage des slabs) suivi d'un tableau de cases contigues
+         */
+        struct Slab{
+            Slab* next;
+            Cell cells[1];
+        };
+
+        static constexpr int FITTING_CELLS = (int)((NODE_SLAB_BYTES - sizeof(Slab)) / sizeof(Cell)) + 1;
+        static constexpr int CELLS_PER_SLAB = FITTING_CELLS > 16 ? FITTING_CELLS : 16; //Au moins 16 noeuds par slab, même pour de gros éléments
+
+        Slab* mSlabs; //Liste chaînée des slabs alloués (le plus récent en tête)
+        int mBump; //Nombre de cases déjà distribuées dans le slab de tête
+        Cell* mFree; //Liste chaînée intrusive des cases libérées
+        long mAllocs;
+        long mFrees;
+        long mSlabCount; //Nombre de slabs actuellement alloués
+
+        void newSlab(){
+            void* raw = ::operator new(sizeof(Slab) + (CELLS_PER_SLAB - 1)*sizeof(Cell));
+            Slab* s = static_cast<Slab*>(raw);
+            s->next = mSlabs;
+            mSlabs = s;
+            mBump = 0;
+            mSlabCount++;
+        }
+
+    public:
+        static const bool releasesAll = true;
+
+        SlabNodeAllocator(){
+            mSlabs = nullptr;
+            mBump = CELLS_PER_SLAB;
+            mFree = nullptr;
+            mAllocs = 0;
+            mFrees = 0;
+            mSlabCount = 0;
+        }
+
+        SlabNodeAllocator(const SlabNodeAllocator<Node>&) = delete;
+        SlabNodeAllocator<Node>& operator= (const SlabNodeAllocator<Node>&) = delete;
+
+        /**
+         * Libère les slabs (les noeuds doivent avoir été détruits ou être trivialement destructibles).
+         */
+        ~SlabNodeAllocator(){
+            this->releaseAll();
+        }
+
+        template<typename... Args>
+        Node* create(Args&&... args){
+            Cell* c;
+            if(mFree != nullptr){
+                c = mFree;
+                mFree = c->nextFree;
+            }else{
+                if(mBump == CELLS_PER_SLAB)
+                    this->newSlab();
+                c = &mSlabs->cells[mBump++];
+            }
+            mAllocs++;
+            return ::new(static_cast<void*>(c->storage)) Node(std::forward<Args>(args)...);
+        }
+
+        void destroy(Node* n){
+            n->~Node();
+            Cell* c = reinterpret_cast<Cell*>(n);
+            c->nextFree = mFree;
+            mFree = c;
+            mFrees++;
+        }
+
+        /**
+         * Rend tous les slabs au système en O(nombre de slabs). Aucun destructeur de noeud n'est appelé.
+         */
+        void releaseAll(){
+            while(mSlabs != nullptr){
+                Slab* next = mSlabs->next;
+                ::operator delete(static_cast<void*>(mSlabs));
+                mSlabs = next;
+            }
+            mBump = CELLS_PER_SLAB;
+            mFree = nullptr;
+            mFrees = mAllocs;
+            mSlabCount = 0;
+        }
+
+        long allocCount() const{
+            return this->mAllocs;
+        }
+
+        long freeCount() const{
+            return this->mFrees;
+        }
+
+        long slabCount() const{
+            return this->mSlabCount;
+        }
+};
+
+#endif
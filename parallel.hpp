@@ -0,0 +1,359 @@
+#ifndef _PARALLEL_H_
+#define _PARALLEL_H_
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "vector.hpp"
+#include "sort.hpp"
+#include "threadpool.hpp"
+
+/**
+ * Algorithmes parallèles sur les listes, exécutés par une réserve de threads (ThreadPool::global() par défaut) : parallelForEach, parallelTransform, parallelMap, parallelReduce, parallelCountIf et parallelSort.
+ *
+ * Sur un Vector, le tableau est découpé en blocs contigus, quelques-uns par thread pour équilibrer la charge (un thread en avance vole les blocs d'un autre). Les frontières des blocs sont alignées sur les lignes de cache (PARALLEL_CACHE_LINE octets) : deux threads n'écrivent jamais dans la même ligne, ce qui évite les invalidations de cache croisées ("false sharing"). En dessous de PARALLEL_MIN_SIZE éléments, le coût de la distribution des tâches dépasse le gain et l'algorithme s'exécute simplement dans le thread appelant.
+ *
+ * Les autres listes (LinkedList...) sont parcourues une première fois pour repérer, par leurs itérateurs, les frontières de blocs de même taille, puis chaque bloc est parcouru en parallèle. Ce premier parcours est séquentiel : le gain n'est réel que si le traitement de chaque élément coûte nettement plus cher que le passage au suivant.
+ *
+ * Les fonctions passées doivent pouvoir être appelées depuis plusieurs threads en même temps. parallelReduce réduit chaque bloc à partir d'un élément neutre (identity), puis combine les résultats des blocs dans l'ordre de la liste : l'opération doit être associative, et identity neutre pour elle (0 pour une somme, 1 pour un produit...).
+ */
+
+/**
+ * Nombre d'éléments en dessous duquel les algorithmes restent séquentiels
+ */
+#ifndef PARALLEL_MIN_SIZE
+#define PARALLEL_MIN_SIZE 32768
+#endif
+
+/**
+ * Nombre de blocs par thread
+ */
+#ifndef PARALLEL_CHUNKS_PER_THREAD
+#define PARALLEL_CHUNKS_PER_THREAD 4
+#endif
+
+/**
+ * Taille d'une ligne de cache en octets
+ */
+#ifndef PARALLEL_CACHE_LINE
+#define PARALLEL_CACHE_LINE 64
+#endif
+
+/**
+ * Indice de la k-ième des "chunks" frontières de blocs du tableau p[0..n[, arrondi au début de ligne de cache suivant lorsque les éléments divisent exactement les lignes
+ */
+template<typename T>
+long chunkBound(const T* p, long n, int chunks, int k){
+    long i = (long)((double)n * k / chunks);
+    if(k == 0 || k == chunks || PARALLEL_CACHE_LINE % sizeof(T) != 0)
+        return k == chunks ? n : i;
+    std::uintptr_t a = reinterpret_cast<std::uintptr_t>(p + i);
+    std::uintptr_t aligned = (a + PARALLEL_CACHE_LINE - 1) & ~(std::uintptr_t)(PARALLEL_CACHE_LINE - 1);
+    if((aligned - a) % sizeof(T) != 0)
+        return i;
+    i += (long)((aligned - a) / sizeof(T));
+    return i < n ? i : n;
+}
+
+/**
+ * Nombre de blocs à utiliser pour n éléments (1 : exécution séquentielle)
+ */
+inline int chunkCount(long n, ThreadPool& pool){
+    if(n < PARALLEL_MIN_SIZE || pool.parallelism() == 1)
+        return 1;
+    long c = (long)pool.parallelism() * PARALLEL_CHUNKS_PER_THREAD;
+    long max = n / (PARALLEL_MIN_SIZE / 8); //Pas de bloc trop petit
+    if(c > max)
+        c = max;
+    return c < 1 ? 1 : (int)c;
+}
+
+/**
+ * Appelle f(k, début, fin) pour chacun des blocs [début, fin[ du tableau p[0..n[, en parallèle
+ */
+template<typename T, typename F>
+void forEachChunk(T* p, long n, int chunks, ThreadPool& pool, F f){
+    if(chunks == 1){
+        f(0, 0L, n);
+        return;
+    }
+    TaskGroup g(pool);
+    for(int k = 0; k < chunks; k++){
+        long b = chunkBound(p, n, chunks, k);
+        long e = chunkBound(p, n, chunks, k + 1);
+        g.run([&f, k, b, e]{ f(k, b, e); });
+    }
+    g.wait();
+}
+
+/////////// VECTOR ///////////
+
+/**
+ * Applique f à chaque élément (par référence)
+ */
+template<typename T, typename F>
+void parallelForEach(Vector<T>& v, F f, ThreadPool& pool = ThreadPool::global()){
+    T* p = v.data();
+    forEachChunk(p, v.size(), chunkCount(v.size(), pool), pool, [p, &f](int, long b, long e){
+        for(long i = b; i < e; i++)
+            f(p[i]);
+    });
+}
+
+/**
+ * Remplace chaque élément e par f(e)
+ */
+template<typename T, typename F>
+void parallelTransform(Vector<T>& v, F f, ThreadPool& pool = ThreadPool::global()){
+    T* p = v.data();
+    forEachChunk(p, v.size(), chunkCount(v.size(), pool), pool, [p, &f](int, long b, long e){
+        for(long i = b; i < e; i++)
+            p[i] = f(p[i]);
+    });
+}
+
+/**
+ * Nouveau Vector des f(e) pour chaque élément e de v (le type des éléments est celui que renvoie f)
+ */
+template<typename T, typename F>
+auto parallelMap(const Vector<T>& v, F f, ThreadPool& pool = ThreadPool::global()) -> Vector<typename std::decay<decltype(f(std::declval<const T&>()))>::type>{
+    typedef typename std::decay<decltype(f(std::declval<const T&>()))>::type R;
+    Vector<R> r(v.size());
+    r.resize(v.size());
+    const T* p = v.data();
+    R* q = r.data();
+    forEachChunk(q, v.size(), chunkCount(v.size(), pool), pool, [p, q, &f](int, long b, long e){
+        for(long i = b; i < e; i++)
+            q[i] = f(p[i]);
+    });
+    return r;
+}
+
+/**
+ * Réduction op(...op(op(identity, e0), e1)..., en-1) : chaque bloc est réduit par op à partir de identity, puis les résultats des blocs sont combinés par combine(U, U), en partant de identity. Il faut donc que op(op(u, e1), e2) == combine(u, op(op(identity, e1), e2)) ; par exemple, pour une somme des carrés, op(a, x) = a + x*x et combine(a, b) = a + b.
+ */
+template<typename T, typename U, typename Op, typename Combine, typename = typename std::enable_if<!std::is_base_of<ThreadPool, typename std::decay<Combine>::type>::value>::type>
+U parallelReduce(const Vector<T>& v, U identity, Op op, Combine combine, ThreadPool& pool = ThreadPool::global()){
+    const T* p = v.data();
+    long n = v.size();
+    int chunks = chunkCount(n, pool);
+    if(chunks == 1){
+        for(long i = 0; i < n; i++)
+            identity = op(std::move(identity), p[i]);
+        return identity;
+    }
+
+    std::allocator<U> alloc;
+    U* partial = alloc.allocate(chunks);
+    forEachChunk(p, n, chunks, pool, [p, partial, &identity, &op](int k, long b, long e){
+        U acc = identity;
+        for(long i = b; i < e; i++)
+            acc = op(std::move(acc), p[i]);
+        ::new(static_cast<void*>(partial + k)) U(std::move(acc));
+    });
+    U r = identity;
+    for(int k = 0; k < chunks; k++){
+        r = combine(std::move(r), partial[k]);
+        partial[k].~U();
+    }
+    alloc.deallocate(partial, chunks);
+    return r;
+}
+
+/**
+ * Réduction par une opération op(U, U) qui sert aussi à combiner les blocs (somme, produit, maximum...)
+ */
+template<typename T, typename U, typename Op>
+U parallelReduce(const Vector<T>& v, U identity, Op op, ThreadPool& pool = ThreadPool::global()){
+    return parallelReduce(v, std::move(identity), op, op, pool);
+}
+
+/**
+ * Nombre d'éléments vérifiant le prédicat pred
+ */
+template<typename T, typename P>
+long parallelCountIf(const Vector<T>& v, P pred, ThreadPool& pool = ThreadPool::global()){
+    const T* p = v.data();
+    long n = v.size();
+    int chunks = chunkCount(n, pool);
+    struct alignas(PARALLEL_CACHE_LINE) Counter{ long value; }; //Un compteur par ligne de cache
+    Counter* counts = new Counter[chunks];
+    forEachChunk(p, n, chunks, pool, [p, counts, &pred](int k, long b, long e){
+        long c = 0;
+        for(long i = b; i < e; i++){
+            if(pred(p[i]))
+                c++;
+        }
+        counts[k].value = c;
+    });
+    long total = 0;
+    for(int k = 0; k < chunks; k++)
+        total += counts[k].value;
+    delete[] counts;
+    return total;
+}
+
+/**
+ * Fusionne [a, aEnd[ et [b, bEnd[ (triés) dans la zone brute out en y déplaçant les éléments, qui sont détruits à leur place d'origine
+ */
+template<typename T, typename Cmp>
+void mergeMove(T* a, T* aEnd, T* b, T* bEnd, T* out, Cmp& cmp){
+    while(a != aEnd && b != bEnd){
+        T* src = cmp(*b, *a) ? b++ : a++;
+        ::new(static_cast<void*>(out++)) T(std::move(*src));
+        src->~T();
+    }
+    for(; a != aEnd; ++a, ++out){
+        ::new(static_cast<void*>(out)) T(std::move(*a));
+        a->~T();
+    }
+    for(; b != bEnd; ++b, ++out){
+        ::new(static_cast<void*>(out)) T(std::move(*b));
+        b->~T();
+    }
+}
+
+/**
+ * Tri parallèle : chaque bloc est trié (introsort, voir sort.hpp) par un thread, puis les blocs triés sont fusionnés deux à deux, en parallèle, jusqu'à n'en former plus qu'un. Les fusions se font à travers un tableau temporaire de la taille de v. Comme arraySort, le tri n'est pas stable.
+ */
+template<typename T, typename Cmp>
+void parallelSort(Vector<T>& v, Cmp cmp, ThreadPool& pool = ThreadPool::global()){
+    T* p = v.data();
+    long n = v.size();
+    int chunks = chunkCount(n, pool);
+    if(chunks == 1){
+        arraySort(p, p + n, cmp);
+        return;
+    }
+
+    long* bounds = new long[chunks + 1];
+    for(int k = 0; k <= chunks; k++)
+        bounds[k] = chunkBound(p, n, chunks, k);
+    forEachChunk(p, n, chunks, pool, [p, &cmp](int, long b, long e){
+        arraySort(p + b, p + e, cmp);
+    });
+
+    //Fusions : à chaque tour, les éléments passent de src (construit) à dst (brut) et le nombre de blocs est divisé par deux
+    std::allocator<T> alloc;
+    T* tmp = alloc.allocate(n);
+    T* src = p;
+    T* dst = tmp;
+    for(int width = 1; width < chunks; width *= 2){
+        TaskGroup g(pool);
+        for(int k = 0; k < chunks; k += 2*width){
+            long b = bounds[k];
+            long m = bounds[k + width < chunks ? k + width : chunks];
+            long e = bounds[k + 2*width < chunks ? k + 2*width : chunks];
+            g.run([src, dst, b, m, e, &cmp]{ mergeMove(src + b, src + m, src + m, src + e, dst + b, cmp); });
+        }
+        g.wait();
+        std::swap(src, dst);
+    }
+    if(src != p){ //Le résultat est dans le tableau temporaire : on le ramène dans v, en parallèle
+        forEachChunk(p, n, chunks, pool, [p, src](int, long b, long e){
+            for(long i = b; i < e; i++){
+                ::new(static_cast<void*>(p + i)) T(std::move(src[i]));
+                src[i].~T();
+            }
+        });
+    }
+    alloc.deallocate(tmp, n);
+    delete[] bounds;
+}
+
+template<typename T>
+void parallelSort(Vector<T>& v, ThreadPool& pool = ThreadPool::global()){
+    parallelSort(v, std::less<T>(), pool);
+}
+
+/////////// AUTRES LISTES ///////////
+
+/**
+ * Appelle f(k, début, fin) pour "chunks" intervalles d'itérateurs de même taille couvrant la liste l, en parallèle (le découpage se fait en un parcours séquentiel)
+ */
+template<typename L, typename F>
+void forEachRange(L& l, int chunks, ThreadPool& pool, F f){
+    typedef decltype(l.begin()) It;
+    long n = l.size();
+    if(chunks == 1){
+        f(0, l.begin(), l.end());
+        return;
+    }
+    TaskGroup g(pool);
+    It b = l.begin();
+    long pos = 0;
+    for(int k = 0; k < chunks; k++){
+        long next = (long)((double)n * (k + 1) / chunks);
+        It e = b;
+        for(; pos < next; pos++)
+            ++e;
+        g.run([&f, k, b, e]{ f(k, b, e); });
+        b = e;
+    }
+    g.wait();
+}
+
+/**
+ * Applique f à chaque élément d'une liste quelconque (par référence)
+ */
+template<typename L, typename F>
+void parallelForEach(L& l, F f, ThreadPool& pool = ThreadPool::global()){
+    typedef decltype(l.begin()) It;
+    forEachRange(l, chunkCount(l.size(), pool), pool, [&f](int, It b, It e){
+        for(; b != e; ++b)
+            f(*b);
+    });
+}
+
+template<typename L, typename U, typename Op, typename Combine, typename = typename std::enable_if<!std::is_base_of<ThreadPool, typename std::decay<Combine>::type>::value>::type>
+U parallelReduce(const L& l, U identity, Op op, Combine combine, ThreadPool& pool = ThreadPool::global()){
+    typedef decltype(l.begin()) It;
+    int chunks = chunkCount(l.size(), pool);
+    std::allocator<U> alloc;
+    U* partial = alloc.allocate(chunks);
+    forEachRange(l, chunks, pool, [partial, &identity, &op](int k, It b, It e){
+        U acc = identity;
+        for(; b != e; ++b)
+            acc = op(std::move(acc), *b);
+        ::new(static_cast<void*>(partial + k)) U(std::move(acc));
+    });
+    U r = identity;
+    for(int k = 0; k < chunks; k++){
+        r = combine(std::move(r), partial[k]);
+        partial[k].~U();
+    }
+    alloc.deallocate(partial, chunks);
+    return r;
+}
+
+template<typename L, typename U, typename Op>
+U parallelReduce(const L& l, U identity, Op op, ThreadPool& pool = ThreadPool::global()){
+    return parallelReduce(l, std::move(identity), op, op, pool);
+}
+
+template<typename L, typename P>
+long parallelCountIf(const L& l, P pred, ThreadPool& pool = ThreadPool::global()){
+    typedef decltype(l.begin()) It;
+    int chunks = chunkCount(l.size(), pool);
+    struct alignas(PARALLEL_CACHE_LINE) Counter{ long value; };
+    Counter* counts = new Counter[chunks];
+    forEachRange(l, chunks, pool, [counts, &pred](int k, It b, It e){
+        long c = 0;
+        for(; b != e; ++b){
+            if(pred(*b))
+                c++;
+        }
+        counts[k].value = c;
+    });
+    long total = 0;
+    for(int k = 0; k < chunks; k++)
+        total += counts[k].value;
+    delete[] counts;
+    return total;
+}
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef _PERSISTENTLIST_H_
+#define _PERSISTENTLIST_H_
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <utility>
+
+#include "list.hpp"
+#include "listbase.hpp"
+
+/**
+ * Liste persistante, au sens des listes de Caml : une PersistentList n'est jamais modifiée, prepend(e) renvoie en O(1) une nouvelle liste dont le premier noeud contient e et dont la suite est la liste d'origine, partagée et non copiée. Les deux listes restent valides et indépendantes l'une de l'autre. On obtient ainsi des instantanés gratuits d'un historique qui grandit : chaque version est une PersistentList de quelques octets, et toutes les versions partagent leurs noeuds communs.
+ *
+ * Chaque noeud porte un compteur de références (les listes et les noeuds qui pointent sur lui). Les compteurs sont atomiques : des listes qui partagent des noeuds peuvent être copiées, parcourues et détruites en même temps dans des threads différents, sans verrou. Comme pour un std::shared_ptr, c'est un même objet PersistentList qui ne doit pas être réaffecté (operator=, push()) pendant qu'un autre thread le lit ou le copie. Pour donner la version courante d'un historique à des lecteurs, il suffit donc de leur en passer une copie (par une file, ou par une variable protégée par un verrou) : elle ne coûte qu'une incrémentation atomique, quelle que soit la longueur de la liste. Un noeud qui n'est référencé qu'une fois est libéré sans instruction atomique.
+ *
+ * Libérer une liste libère, de proche en proche, tous les noeuds qui ne sont plus référencés : la libération se fait par une boucle et non par des destructeurs récursifs, elle ne peut donc pas faire déborder la pile, quelle que soit la longueur de la chaîne.
+ *
+ * Accès au i-ème élément et append() en O(i) et O(n) : comme en Caml, on construit une liste par la tête et on la parcourt avec ses itérateurs (reverse() remet un historique dans l'ordre chronologique).
+ */
+
+/**
+ * Noeud d'une PersistentList : la valeur, le noeud suivant, le nombre de noeuds de la liste qui commence ici et le nombre de références
+ */
+template<typename T>
+struct PersistentNode{
+    std::atomic<int> refs;
+    int size;
+    PersistentNode* next;
+    T val;
+
+    PersistentNode(T nVal, PersistentNode* nNext) : size(nNext == nullptr ? 1 : nNext->size + 1), next(nNext), val(std::move(nVal)){
+        refs.store(1, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Itérateur externe (constant) sur une PersistentList
+ */
+template<typename T>
+class PersistentListIterator
+{
+    private:
+        const PersistentNode<T>* mNode;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        explicit PersistentListIterator(const PersistentNode<T>* n = nullptr){
+            mNode = n;
+        }
+
+        const T& operator* () const{
+            return mNode->val;
+        }
+
+        const T* operator-> () const{
+            return &mNode->val;
+        }
+
+        PersistentListIterator& operator++ (){
+            mNode = mNode->next;
+            return *this;
+        }
+
+        PersistentListIterator operator++ (int){
+            PersistentListIterator ret = *this;
+            mNode = mNode->next;
+            return ret;
+        }
+
+        bool operator== (const PersistentListIterator& o) const{
+            return mNode == o.mNode;
+        }
+
+        bool operator!= (const PersistentListIterator& o) const{
+            return mNode != o.mNode;
+        }
+};
+
+template<typename T>
+class PersistentList : public ListBase<PersistentList<T>, T>
+{
+    private:
+        typedef PersistentNode<T> Node;
+
+        Node* mHead; //Premier noeud (nullptr pour la liste vide), dont la liste détient une référence
+
+        explicit PersistentList(Node* head){
+            mHead = head;
+        }
+
+        static Node* retain(Node* n){
+            if(n != nullptr)
+                n->refs.fetch_add(1, std::memory_order_relaxed);
+            return n;
+        }
+
+        /**
+         * Retire une référence à n et libère, de proche en proche, les noeuds qui ne sont plus référencés. Si l'on détient la seule référence, personne d'autre ne peut plus lire ni modifier le compteur : on libère le noeud sans instruction atomique.
+         */
+        static void release(Node* n){
+            while(n != nullptr){
+                if(n->refs.load(std::memory_order_acquire) != 1 && n->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    return;
+                Node* next = n->next;
+                delete n;
+                n = next;
+            }
+        }
+
+    public:
+        typedef PersistentListIterator<T> iterator;
+        typedef PersistentListIterator<T> const_iterator;
+
+        /**
+         * Liste vide
+         */
+        PersistentList(){
+            mHead = nullptr;
+        }
+
+        /**
+         * Liste des éléments de [first, last[, dans le même ordre (O(n) : la liste est construite à l'envers, puis retournée)
+         */
+        template<typename It>
+        PersistentList(It first, It last){
+            mHead = nullptr;
+            PersistentList<T> reversed;
+            for(; first != last; ++first)
+                reversed.push(*first);
+            *this = reversed.reverse();
+        }
+
+        /**
+         * Copie en O(1) : les deux listes partagent tous leurs noeuds
+         */
+        PersistentList(const PersistentList<T>& o){
+            mHead = retain(o.mHead);
+        }
+
+        PersistentList(PersistentList<T>&& o) noexcept{
+            mHead = o.mHead;
+            o.mHead = nullptr;
+        }
+
+        PersistentList<T>& operator= (PersistentList<T> o){
+            std::swap(mHead, o.mHead);
+            return *this;
+        }
+
+        ~PersistentList(){
+            release(mHead);
+        }
+
+        int size() const{
+            return mHead == nullptr ? 0 : mHead->size;
+        }
+
+        bool isEmpty() const{
+            return mHead == nullptr;
+        }
+
+        /**
+         * Nouvelle liste formée de e suivi des éléments de cette liste (qui ne change pas), en O(1)
+         */
+        PersistentList<T> prepend(T e) const{
+            return PersistentList<T>(new Node(std::move(e), retain(mHead)));
+        }
+
+        /**
+         * Remplace cette liste par prepend(e). La référence de cette liste sur son ancien premier noeud passe au nouveau noeud : aucune opération atomique. Les copies faites auparavant ne changent pas.
+         */
+        void push(T e){
+            mHead = new Node(std::move(e), mHead);
+        }
+
+        /**
+         * Premier élément (EmptyContainerException si la liste est vide)
+         */
+        const T& first() const{
+            if(mHead == nullptr)
+                throw EmptyContainerException();
+            return mHead->val;
+        }
+
+        /**
+         * Liste privée de son premier élément, en O(1) (elle partage tous ses noeuds avec cette liste)
+         */
+        PersistentList<T> tail() const{
+            if(mHead == nullptr)
+                throw EmptyContainerException();
+            return PersistentList<T>(retain(mHead->next));
+        }
+
+        /**
+         * Accès au i-ème élément en O(i)
+         */
+        const T& operator[] (int i) const{
+            listCheckIndex(i, this->size());
+            const Node* n = mHead;
+            for(; i > 0; i--)
+                n = n->next;
+            return n->val;
+        }
+
+        const_iterator begin() const{
+            return const_iterator(mHead);
+        }
+
+        const_iterator end() const{
+            return const_iterator();
+        }
+
+        /**
+         * Nouvelle liste formée des éléments de cette liste suivis de e : tous les noeuds sont copiés (O(n))
+         */
+        PersistentList<T> append(T e) const{
+            return this->reverse().prependAllReversed(PersistentList<T>().prepend(std::move(e)));
+        }
+
+        /**
+         * Nouvelle liste privée de la première occurrence de e : les noeuds qui la précèdent sont copiés, ceux qui la suivent sont partagés. Si e n'est pas présent, renvoie une copie (O(1)) de cette liste.
+         */
+        PersistentList<T> remove(const T& e) const{
+            PersistentList<T> prefix; //Éléments qui précèdent e, du plus proche au plus lointain
+            for(const Node* n = mHead; n != nullptr; n = n->next){
+                if(n->val == e)
+                    return prefix.prependAllReversed(PersistentList<T>(retain(n->next)));
+                prefix.push(n->val);
+            }
+            return *this;
+        }
+
+        /**
+         * Liste des mêmes éléments dans l'ordre inverse (O(n), tous les noeuds sont copiés)
+         */
+        PersistentList<T> reverse() const{
+            PersistentList<T> r;
+            for(const T& x : *this)
+                r.push(x);
+            return r;
+        }
+
+        /**
+         * Ajoute en tête de rest les éléments de cette liste, du dernier au premier, et renvoie le résultat : {a, b}.prependAllReversed({c}) vaut {b, a, c}
+         */
+        PersistentList<T> prependAllReversed(PersistentList<T> rest) const{
+            for(const T& x : *this)
+                rest.push(x);
+            return rest;
+        }
+
+        /**
+         * Vrai si les deux listes commencent par le même noeud (elles sont alors identiques), en O(1)
+         */
+        bool sameAs(const PersistentList<T>& o) const{
+            return mHead == o.mHead;
+        }
+
+        friend std::ostream& operator<< (std::ostream& flux, const PersistentList<T>& l){
+            flux << "{";
+            bool firstElt = true;
+            for(const T& e : l){
+                if(!firstElt)
+                    flux << ", ";
+                flux << e;
+                firstElt = false;
+            }
+            flux << "}";
+            return flux;
+        }
+};
+
+#endif
@@ -0,0 +1,436 @@
+#ifndef _SERIALIZATION_H_
+#define _SERIALIZATION_H_
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "list.hpp"
+#include "vector.hpp"
+
+/**
+ * Sérialisation binaire des listes : writeList() écrit n'importe quelle List<T> dans un flux, ListReader la relit en ajoutant les éléments à une liste (de n'importe quel type, pas forcément celui d'origine). saveList() et loadList() font de même avec un fichier.
+ *
+ * Format : un en-tête de 32 octets (signature "CJCLIST", version, marqueur de boutisme, taille d'un élément, drapeaux, nombre d'éléments), puis les éléments.
+ *
+ * Le codage des éléments est celui de Serializer<T> :
+ * - pour un type trivialement copiable (int, double, structures simples...), les éléments sont écrits tels qu'ils sont en mémoire ("bruts"). Un Vector est alors écrit et relu en un seul appel à write() / read(), les autres listes bloc par bloc (voir ListChunk) à travers un tampon de SERIAL_BUFFER_BYTES octets. Un fichier écrit sur une machine de boutisme différent est relu en inversant les octets si T est un type arithmétique ;
+ * - pour les autres types, Serializer<T> doit être spécialisé (voir celui de std::string plus bas) : ses fonctions write() et read() écrivent et lisent un élément à la fois.
+ *
+ * ListReader relit les éléments par paquets de taille bornée (readInto()) : un fichier plus gros que la mémoire disponible peut ainsi être traité morceau par morceau. readAll() réserve d'abord la place nécessaire dans la liste lorsqu'elle le permet (reserve()).
+ *
+ * Toute erreur (flux tronqué, en-tête invalide, format incompatible) lance une SerializationException.
+ */
+
+/**
+ * Taille du tampon utilisé pour les listes non contiguës et la relecture par paquets
+ */
+#ifndef SERIAL_BUFFER_BYTES
+#define SERIAL_BUFFER_BYTES 65536
+#endif
+
+/**
+ * Version du format
+ */
+#define SERIAL_FORMAT_VERSION 1
+
+/**
+ * Drapeaux de l'en-tête
+ */
+#define SERIAL_RAW 1 //Éléments bruts (Serializer<T>::raw)
+
+/**
+ * En-tête d'une liste sérialisée
+ */
+struct SerialHeader{
+    char magic[8]; //"CJCLIST"
+    std::uint32_t version;
+    std::uint32_t endian; //0x01020304 écrit dans le boutisme de la machine
+    std::uint32_t eltSize; //sizeof(T) pour des éléments bruts, 0 sinon
+    std::uint32_t flags;
+    std::uint64_t count; //Nombre d'éléments
+};
+
+static_assert(sizeof(SerialHeader) == 32, "l'en-tête doit faire 32 octets");
+
+/**
+ * Erreur de lecture ou d'écriture d'une liste sérialisée
+ */
+class SerializationException : public std::exception
+{
+    std::string msg;
+
+    public:
+        explicit SerializationException(const std::string& msg) : msg(msg){
+        }
+
+        const char* what() const throw(){
+            return this->msg.c_str();
+        }
+};
+
+/**
+ * Inverse l'ordre des octets de v
+ */
+template<typename T>
+inline void byteSwap(T& v){
+    unsigned char* p = reinterpret_cast<unsigned char*>(&v);
+    for(std::size_t i = 0; i < sizeof(T)/2; i++)
+        std::swap(p[i], p[sizeof(T) - 1 - i]);
+}
+
+/**
+ * Écriture et lecture de bytes octets bruts à travers les flux standards (lance une SerializationException si le flux est tronqué)
+ */
+inline void serialWrite(std::ostream& out, const void* p, std::size_t bytes){
+    out.write(static_cast<const char*>(p), (std::streamsize)bytes);
+    if(!out)
+        throw SerializationException("échec de l'écriture");
+}
+
+inline void serialRead(std::istream& in, void* p, std::size_t bytes){
+    in.read(static_cast<char*>(p), (std::streamsize)bytes);
+    if((std::size_t)in.gcount() != bytes)
+        throw SerializationException("flux tronqué");
+}
+
+/**
+ * Nombre d'octets qui restent à lire dans le flux, -1 si on ne peut pas le savoir (flux sans positionnement : tube, socket...)
+ */
+inline long serialAvailable(std::istream& in){
+    std::istream::pos_type pos = in.tellg();
+    if(pos == std::istream::pos_type(-1))
+        return -1;
+    in.seekg(0, std::ios::end);
+    std::istream::pos_type end = in.tellg();
+    in.seekg(pos);
+    if(end == std::istream::pos_type(-1) || !in)
+        return -1;
+    return (long)(end - pos);
+}
+
+/**
+ * Codage d'un élément de type T. Par défaut, T doit être trivialement copiable et ses octets sont écrits tels quels (raw vaut true). Pour un autre type, spécialiser Serializer<T> avec raw = false et les fonctions write() et read().
+ */
+template<typename T>
+struct Serializer{
+    static_assert(std::is_trivially_copyable<T>::value, "T n'est pas trivialement copiable : spécialiser Serializer<T>");
+
+    static const bool raw = true;
+
+    static void write(std::ostream& out, const T& e){
+        serialWrite(out, &e, sizeof(T));
+    }
+
+    static T read(std::istream& in){
+        T e;
+        serialRead(in, &e, sizeof(T));
+        return e;
+    }
+};
+
+/**
+ * Chaînes de caractères : longueur sur 32 bits puis caractères
+ */
+template<>
+struct Serializer<std::string>{
+    static const bool raw = false;
+
+    static void write(std::ostream& out, const std::string& e){
+        std::uint32_t n = (std::uint32_t)e.size();
+        serialWrite(out, &n, sizeof(n));
+        serialWrite(out, e.data(), n);
+    }
+
+    /**
+     * La longueur lue n'est pas sûre (fichier tronqué ou corrompu) : la chaîne grandit par morceaux d'au plus SERIAL_BUFFER_BYTES octets au fil de la lecture, au lieu d'allouer d'emblée jusqu'à 4 Go
+     */
+    static std::string read(std::istream& in){
+        std::uint32_t n;
+        serialRead(in, &n, sizeof(n));
+        std::string e;
+        std::size_t done = 0;
+        while(done < n){
+            std::size_t piece = n - done < SERIAL_BUFFER_BYTES ? n - done : SERIAL_BUFFER_BYTES;
+            e.resize(done + piece);
+            serialRead(in, &e[done], piece);
+            done += piece;
+        }
+        return e;
+    }
+};
+
+/**
+ * Écrit la liste l dans le flux out
+ */
+template<typename T>
+void writeList(std::ostream& out, const List<T>& l){
+    typedef Serializer<T> S;
+    SerialHeader h;
+    std::memcpy(h.magic, "CJCLIST", 8);
+    h.version = SERIAL_FORMAT_VERSION;
+    h.endian = 0x01020304;
+    h.eltSize = S::raw ? (std::uint32_t)sizeof(T) : 0;
+    h.flags = S::raw ? SERIAL_RAW : 0;
+    h.count = (std::uint64_t)l.size();
+    serialWrite(out, &h, sizeof(h));
+
+    ListChunk<T> c;
+    if constexpr(!S::raw){
+        for(l.firstChunk(c); c.begin != nullptr; l.nextChunk(c)){
+            for(const T* p = c.begin; p != c.end; ++p)
+                S::write(out, *p);
+        }
+    }else{
+        //Éléments bruts : les gros blocs (tout un Vector) sont écrits directement, les petits (noeuds de LinkedList...) regroupés dans un tampon
+        char* buffer = nullptr;
+        std::size_t filled = 0;
+        try{
+            for(l.firstChunk(c); c.begin != nullptr; l.nextChunk(c)){
+                std::size_t bytes = (std::size_t)(c.end - c.begin)*sizeof(T);
+                if(filled + bytes > SERIAL_BUFFER_BYTES && filled > 0){
+                    serialWrite(out, buffer, filled);
+                    filled = 0;
+                }
+                if(bytes >= SERIAL_BUFFER_BYTES){
+                    serialWrite(out, c.begin, bytes);
+                    continue;
+                }
+                if(buffer == nullptr)
+                    buffer = new char[SERIAL_BUFFER_BYTES];
+                std::memcpy(buffer + filled, static_cast<const void*>(c.begin), bytes);
+                filled += bytes;
+            }
+            if(filled > 0)
+                serialWrite(out, buffer, filled);
+        }catch(...){
+            delete[] buffer;
+            throw;
+        }
+        delete[] buffer;
+    }
+}
+
+/**
+ * Écrit la liste l dans le fichier path (écrasé s'il existe)
+ */
+template<typename T>
+void saveList(const std::string& path, const List<T>& l){
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if(!out)
+        throw SerializationException(path + " : impossible d'ouvrir le fichier en écriture");
+    writeList(out, l);
+    out.flush();
+    if(!out)
+        throw SerializationException(path + " : échec de l'écriture");
+}
+
+/**
+ * Réserve de la place pour n éléments dans l si elle le permet (méthode reserve())
+ */
+template<typename L>
+auto serialReserve(L& l, int n, int) -> decltype(l.reserve(n), void()){
+    l.reserve(n);
+}
+
+template<typename L>
+void serialReserve(L&, int, long){
+}
+
+/**
+ * Ajoute les n éléments de p à l : en une seule copie si l le permet (méthode append(const T*, int), voir MappedVector), élément par élément sinon
+ */
+template<typename L, typename T>
+auto serialAppend(L& l, const T* p, int n, int) -> decltype(l.append(p, n), void()){
+    l.append(p, n);
+}
+
+template<typename L, typename T>
+void serialAppend(L& l, const T* p, int n, long){
+    for(int i = 0; i < n; i++)
+        l.append(p[i]);
+}
+
+/**
+ * Lecture d'une liste sérialisée par writeList(). Le constructeur lit et vérifie l'en-tête ; les éléments sont ensuite ajoutés à une liste par readInto() (un paquet borné) ou readAll() (tous les éléments restants).
+ */
+template<typename T>
+class ListReader
+{
+    private:
+        typedef Serializer<T> S;
+
+        std::istream& mIn;
+        long mCount; //Nombre total d'éléments
+        long mRemaining; //Nombre d'éléments restant à lire
+        bool mSwap; //Fichier écrit dans l'autre boutisme
+
+        /**
+         * Lecture de n éléments bruts dans la zone p
+         */
+        void readRaw(T* p, int n){
+            serialRead(mIn, p, (std::size_t)n*sizeof(T));
+            if(mSwap){
+                for(int i = 0; i < n; i++)
+                    byteSwap(p[i]);
+            }
+            mRemaining -= n;
+        }
+
+        /**
+         * Nombre d'éléments bruts d'un paquet de SERIAL_BUFFER_BYTES octets
+         */
+        static int blockSize(){
+            int block = (int)(SERIAL_BUFFER_BYTES / sizeof(T));
+            return block < 1 ? 1 : block;
+        }
+
+        /**
+         * Un Vector est agrandi puis rempli directement par le flux, par paquets dont la taille double à chaque fois (la place déjà réservée, au moins un paquet de SERIAL_BUFFER_BYTES octets, puis autant que ce qui a déjà été lu) : le nombre d'appels à read() est logarithmique, et un en-tête qui annonce plus d'éléments que le flux n'en contient ne fait pas allouer plus de deux fois ce qui a réellement été lu. La capacité croît géométriquement (voir Vector::growthFactor()), des appels successifs à readInto() ne recopient donc pas le tableau à chaque fois. Si le flux est tronqué, le Vector retrouve sa taille d'origine avant que la SerializationException ne soit propagée.
+         */
+        int readRawInto(Vector<T>& l, int n){
+            int old = l.size();
+            try{
+                for(int done = 0; done < n;){
+                    int k = done > blockSize() ? done : blockSize();
+                    if(k < l.capacity() - l.size())
+                        k = l.capacity() - l.size(); //La place déjà réservée est remplie en une fois
+                    if(k > n - done)
+                        k = n - done;
+                    int size = l.size() + k;
+                    if(size > l.capacity()){
+                        int grown = (int)(l.capacity() * l.growthFactor());
+                        l.reserve(grown > size ? grown : size);
+                    }
+                    l.resize(size);
+                    this->readRaw(l.data() + size - k, k);
+                    done += k;
+                }
+            }catch(...){
+                l.resize(old);
+                throw;
+            }
+            return n;
+        }
+
+        /**
+         * Autres listes : lecture par paquets de SERIAL_BUFFER_BYTES octets dans un tampon
+         */
+        template<typename L>
+        int readRawInto(L& l, int n){
+            int block = blockSize();
+            if(block > n)
+                block = n;
+            std::allocator<T> alloc;
+            T* buffer = alloc.allocate(block);
+            try{
+                for(int done = 0; done < n; done += block){
+                    int k = n - done < block ? n - done : block;
+                    this->readRaw(buffer, k);
+                    serialAppend(l, static_cast<const T*>(buffer), k, 0);
+                }
+            }catch(...){
+                alloc.deallocate(buffer, block);
+                throw;
+            }
+            alloc.deallocate(buffer, block);
+            return n;
+        }
+
+    public:
+        explicit ListReader(std::istream& in) : mIn(in){
+            SerialHeader h;
+            serialRead(in, &h, sizeof(h));
+            if(std::memcmp(h.magic, "CJCLIST", 8) != 0)
+                throw SerializationException("ce n'est pas une liste sérialisée");
+            mSwap = h.endian != 0x01020304;
+            if(mSwap){
+                byteSwap(h.endian);
+                byteSwap(h.version);
+                byteSwap(h.eltSize);
+                byteSwap(h.flags);
+                byteSwap(h.count);
+                if(h.endian != 0x01020304)
+                    throw SerializationException("marqueur de boutisme invalide");
+                if(!S::raw || !std::is_arithmetic<T>::value)
+                    throw SerializationException("liste écrite dans l'autre boutisme : seuls les types arithmétiques peuvent être convertis");
+            }
+            if(h.version != SERIAL_FORMAT_VERSION)
+                throw SerializationException("version du format non reconnue");
+            if(((h.flags & SERIAL_RAW) != 0) != S::raw || (S::raw && h.eltSize != sizeof(T)))
+                throw SerializationException("codage des éléments différent de celui de Serializer<T>");
+            if(h.count > (std::uint64_t)INT_MAX)
+                throw SerializationException("trop d'éléments");
+            mCount = (long)h.count;
+            mRemaining = mCount;
+        }
+
+        ListReader(const ListReader<T>&) = delete;
+        ListReader<T>& operator= (const ListReader<T>&) = delete;
+
+        /**
+         * Nombre d'éléments de la liste sérialisée
+         */
+        long size() const{
+            return mCount;
+        }
+
+        long remaining() const{
+            return mRemaining;
+        }
+
+        /**
+         * Ajoute à l au plus max éléments lus dans le flux et renvoie leur nombre (0 lorsque tout a été lu). Pour des éléments bruts, au plus SERIAL_BUFFER_BYTES octets sont en mémoire en dehors de l (hors Vector, rempli directement).
+         */
+        template<typename L>
+        int readInto(L& l, int max){
+            int n = mRemaining < max ? (int)mRemaining : max;
+            if(n <= 0)
+                return 0;
+            if constexpr(S::raw)
+                return this->readRawInto(l, n);
+            else{
+                for(int i = 0; i < n; i++){
+                    l.append(S::read(mIn));
+                    mRemaining--;
+                }
+                return n;
+            }
+        }
+
+        /**
+         * Ajoute à l tous les éléments restants. Le nombre d'éléments vient du fichier, on ne lui fait donc pas confiance pour réserver la place d'avance : pour des éléments bruts lus dans un flux dont on connaît la fin (fichier, chaîne), la réservation est bornée par le nombre d'éléments que contiennent réellement les octets restants ; sinon, à un paquet de SERIAL_BUFFER_BYTES octets, et l grossit au fur et à mesure que les données arrivent.
+         */
+        template<typename L>
+        void readAll(L& l){
+            long reserved = mRemaining < blockSize() ? mRemaining : blockSize();
+            if constexpr(S::raw){
+                long available = serialAvailable(mIn);
+                if(available >= 0)
+                    reserved = mRemaining < available / (long)sizeof(T) ? mRemaining : available / (long)sizeof(T);
+            }
+            serialReserve(l, l.size() + (int)reserved, 0);
+            this->readInto(l, (int)mRemaining);
+        }
+};
+
+/**
+ * Ajoute à l les éléments de la liste sérialisée dans le fichier path
+ */
+template<typename L>
+void loadList(const std::string& path, L& l){
+    typedef typename std::decay<decltype(*l.begin())>::type T;
+    std::ifstream in(path, std::ios::binary);
+    if(!in)
+        throw SerializationException(path + " : impossible d'ouvrir le fichier en lecture");
+    ListReader<T> r(in);
+    r.readAll(l);
+}
+
+#endif
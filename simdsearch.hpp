@@ -0,0 +1,288 @@
+#ifndef _SIMDSEARCH_H_
+#define _SIMDSEARCH_H_
+
+#include <type_traits>
+
+/**
+ * Noyaux de recherche dans un tableau contigu (utilisés par Vector, Deque et UnrolledList) : arrayIndexOf, arrayLastIndexOf et arrayCount.
+ *
+ * Pour les types arithmétiques de 1, 2, 4 ou 8 octets, la comparaison se fait par blocs de 16 octets (SSE2) ou 32 octets (AVX2) : on compare tout un registre à la valeur recherchée puis on extrait un masque d'un bit par octet (movemask). Le premier bit à 1 donne la position de la première occurrence, le nombre de bits à 1 le nombre d'occurrences. Le jeu d'instructions est choisi à l'exécution (AVX2 si le processeur le supporte, SSE2 sinon) ; sur une autre architecture, ou si LIST_NO_SIMD est défini, on se rabat sur une simple boucle.
+ *
+ * Les comparaisons de flottants suivent la sémantique de l'opérateur == : NaN n'est jamais trouvé, 0.0 et -0.0 sont égaux.
+ */
+
+#if !defined(LIST_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define LIST_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * Vaut true si les noyaux vectoriels savent traiter le type T
+ */
+template<typename T>
+struct SimdSearchable{
+    static const bool value = (std::is_integral<T>::value && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8))
+        || std::is_same<T, float>::value || std::is_same<T, double>::value;
+};
+
+/////////// VERSIONS SCALAIRES ///////////
+
+template<typename T>
+int scalarIndexOf(const T* p, int n, const T& v){
+    for(int i = 0; i < n; i++){
+        if(p[i] == v)
+            return i;
+    }
+    return -1;
+}
+
+template<typename T>
+int scalarLastIndexOf(const T* p, int n, const T& v){
+    for(int i = n - 1; i >= 0; i--){
+        if(p[i] == v)
+            return i;
+    }
+    return -1;
+}
+
+template<typename T>
+int scalarCount(const T* p, int n, const T& v){
+    int c = 0;
+    for(int i = 0; i < n; i++){
+        if(p[i] == v)
+            c++;
+    }
+    return c;
+}
+
+#ifdef LIST_SIMD_X86
+
+/////////// COMPARAISONS PAR TYPE ///////////
+
+/**
+ * SimdCmp<T> fournit, pour SSE2 et AVX2, la diffusion de la valeur recherchée dans un registre (splat) et la comparaison élément par élément, dont le résultat est un registre où chaque élément égal vaut "tous les bits à 1".
+ */
+template<typename T, int Size = sizeof(T), bool Float = std::is_floating_point<T>::value>
+struct SimdCmp;
+
+template<typename T>
+struct SimdCmp<T, 1, false>{
+    static __m128i splat(T v){ return _mm_set1_epi8((char)v); }
+    static __m128i eq(__m128i a, __m128i b){ return _mm_cmpeq_epi8(a, b); }
+    __attribute__((target("avx2"))) static __m256i splat256(T v){ return _mm256_set1_epi8((char)v); }
+    __attribute__((target("avx2"))) static __m256i eq256(__m256i a, __m256i b){ return _mm256_cmpeq_epi8(a, b); }
+};
+
+template<typename T>
+struct SimdCmp<T, 2, false>{
+    static __m128i splat(T v){ return _mm_set1_epi16((short)v); }
+    static __m128i eq(__m128i a, __m128i b){ return _mm_cmpeq_epi16(a, b); }
+    __attribute__((target("avx2"))) static __m256i splat256(T v){ return _mm256_set1_epi16((short)v); }
+    __attribute__((target("avx2"))) static __m256i eq256(__m256i a, __m256i b){ return _mm256_cmpeq_epi16(a, b); }
+};
+
+template<typename T>
+struct SimdCmp<T, 4, false>{
+    static __m128i splat(T v){ return _mm_set1_epi32((int)v); }
+    static __m128i eq(__m128i a, __m128i b){ return _mm_cmpeq_epi32(a, b); }
+    __attribute__((target("avx2"))) static __m256i splat256(T v){ return _mm256_set1_epi32((int)v); }
+    __attribute__((target("avx2"))) static __m256i eq256(__m256i a, __m256i b){ return _mm256_cmpeq_epi32(a, b); }
+};
+
+template<typename T>
+struct SimdCmp<T, 8, false>{
+    static __m128i splat(T v){ return _mm_set1_epi64x((long long)v); }
+    /**
+     * SSE2 n'a pas de comparaison d'entiers de 64 bits : on compare les moitiés de 32 bits puis on exige que les deux moitiés soient égales
+     */
+    static __m128i eq(__m128i a, __m128i b){
+        __m128i e = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+    __attribute__((target("avx2"))) static __m256i splat256(T v){ return _mm256_set1_epi64x((long long)v); }
+    __attribute__((target("avx2"))) static __m256i eq256(__m256i a, __m256i b){ return _mm256_cmpeq_epi64(a, b); }
+};
+
+template<typename T>
+struct SimdCmp<T, 4, true>{
+    static __m128i splat(T v){ return _mm_castps_si128(_mm_set1_ps(v)); }
+    static __m128i eq(__m128i a, __m128i b){ return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+    __attribute__((target("avx2"))) static __m256i splat256(T v){ return _mm256_castps_si256(_mm256_set1_ps(v)); }
+    __attribute__((target("avx2"))) static __m256i eq256(__m256i a, __m256i b){ return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ)); }
+};
+
+template<typename T>
+struct SimdCmp<T, 8, true>{
+    static __m128i splat(T v){ return _mm_castpd_si128(_mm_set1_pd(v)); }
+    static __m128i eq(__m128i a, __m128i b){ return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+    __attribute__((target("avx2"))) static __m256i splat256(T v){ return _mm256_castpd_si256(_mm256_set1_pd(v)); }
+    __attribute__((target("avx2"))) static __m256i eq256(__m256i a, __m256i b){ return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ)); }
+};
+
+/////////// NOYAUX SSE2 ///////////
+
+/**
+ * Les masques renvoyés par movemask ont un bit par octet : la position d'un élément est donc le numéro du bit divisé par sizeof(T). La boucle principale traite 4 registres par itération et ne regarde le détail que si l'un d'eux contient une occurrence.
+ */
+template<typename T>
+int sse2IndexOf(const T* p, int n, T v){
+    const int W = 16 / sizeof(T);
+    __m128i key = SimdCmp<T>::splat(v);
+    int i = 0;
+    for(; i + 4*W <= n; i += 4*W){
+        __m128i e0 = SimdCmp<T>::eq(_mm_loadu_si128((const __m128i*)(p + i)), key);
+        __m128i e1 = SimdCmp<T>::eq(_mm_loadu_si128((const __m128i*)(p + i + W)), key);
+        __m128i e2 = SimdCmp<T>::eq(_mm_loadu_si128((const __m128i*)(p + i + 2*W)), key);
+        __m128i e3 = SimdCmp<T>::eq(_mm_loadu_si128((const __m128i*)(p + i + 3*W)), key);
+        if(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3))) != 0){
+            unsigned long long m = (unsigned)_mm_movemask_epi8(e0)
+                | ((unsigned long long)(unsigned)_mm_movemask_epi8(e1) << 16)
+                | ((unsigned long long)(unsigned)_mm_movemask_epi8(e2) << 32)
+                | ((unsigned long long)(unsigned)_mm_movemask_epi8(e3) << 48);
+            return i + __builtin_ctzll(m) / sizeof(T);
+        }
+    }
+    for(; i + W <= n; i += W){
+        unsigned m = _mm_movemask_epi8(SimdCmp<T>::eq(_mm_loadu_si128((const __m128i*)(p + i)), key));
+        if(m != 0)
+            return i + __builtin_ctz(m) / sizeof(T);
+    }
+    int r = scalarIndexOf(p + i, n - i, v);
+    return r == -1 ? -1 : i + r;
+}
+
+template<typename T>
+int sse2LastIndexOf(const T* p, int n, T v){
+    const int W = 16 / sizeof(T);
+    __m128i key = SimdCmp<T>::splat(v);
+    int i = n;
+    while(i >= W){
+        i -= W;
+        unsigned m = _mm_movemask_epi8(SimdCmp<T>::eq(_mm_loadu_si128((const __m128i*)(p + i)), key));
+        if(m != 0)
+            return i + (31 - __builtin_clz(m)) / sizeof(T);
+    }
+    return scalarLastIndexOf(p, i, v);
+}
+
+template<typename T>
+int sse2Count(const T* p, int n, T v){
+    const int W = 16 / sizeof(T);
+    __m128i key = SimdCmp<T>::splat(v);
+    long bits = 0;
+    int i = 0;
+    for(; i + W <= n; i += W)
+        bits += __builtin_popcount(_mm_movemask_epi8(SimdCmp<T>::eq(_mm_loadu_si128((const __m128i*)(p + i)), key)));
+    return (int)(bits / sizeof(T)) + scalarCount(p + i, n - i, v);
+}
+
+/////////// NOYAUX AVX2 ///////////
+
+template<typename T>
+__attribute__((target("avx2"))) int avx2IndexOf(const T* p, int n, T v){
+    const int W = 32 / sizeof(T);
+    __m256i key = SimdCmp<T>::splat256(v);
+    int i = 0;
+    for(; i + 4*W <= n; i += 4*W){
+        __m256i e0 = SimdCmp<T>::eq256(_mm256_loadu_si256((const __m256i*)(p + i)), key);
+        __m256i e1 = SimdCmp<T>::eq256(_mm256_loadu_si256((const __m256i*)(p + i + W)), key);
+        __m256i e2 = SimdCmp<T>::eq256(_mm256_loadu_si256((const __m256i*)(p + i + 2*W)), key);
+        __m256i e3 = SimdCmp<T>::eq256(_mm256_loadu_si256((const __m256i*)(p + i + 3*W)), key);
+        if(!_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3)), _mm256_set1_epi8(-1))){
+            unsigned long long lo = (unsigned)_mm256_movemask_epi8(e0) | ((unsigned long long)(unsigned)_mm256_movemask_epi8(e1) << 32);
+            if(lo != 0)
+                return i + __builtin_ctzll(lo) / sizeof(T);
+            unsigned long long hi = (unsigned)_mm256_movemask_epi8(e2) | ((unsigned long long)(unsigned)_mm256_movemask_epi8(e3) << 32);
+            return i + 2*W + __builtin_ctzll(hi) / sizeof(T);
+        }
+    }
+    for(; i + W <= n; i += W){
+        unsigned m = _mm256_movemask_epi8(SimdCmp<T>::eq256(_mm256_loadu_si256((const __m256i*)(p + i)), key));
+        if(m != 0)
+            return i + __builtin_ctz(m) / sizeof(T);
+    }
+    int r = scalarIndexOf(p + i, n - i, v);
+    return r == -1 ? -1 : i + r;
+}
+
+template<typename T>
+__attribute__((target("avx2"))) int avx2LastIndexOf(const T* p, int n, T v){
+    const int W = 32 / sizeof(T);
+    __m256i key = SimdCmp<T>::splat256(v);
+    int i = n;
+    while(i >= W){
+        i -= W;
+        unsigned m = _mm256_movemask_epi8(SimdCmp<T>::eq256(_mm256_loadu_si256((const __m256i*)(p + i)), key));
+        if(m != 0)
+            return i + (31 - __builtin_clz(m)) / sizeof(T);
+    }
+    return scalarLastIndexOf(p, i, v);
+}
+
+template<typename T>
+__attribute__((target("avx2"))) int avx2Count(const T* p, int n, T v){
+    const int W = 32 / sizeof(T);
+    __m256i key = SimdCmp<T>::splat256(v);
+    long bits = 0;
+    int i = 0;
+    for(; i + W <= n; i += W)
+        bits += __builtin_popcount(_mm256_movemask_epi8(SimdCmp<T>::eq256(_mm256_loadu_si256((const __m256i*)(p + i)), key)));
+    return (int)(bits / sizeof(T)) + scalarCount(p + i, n - i, v);
+}
+
+/**
+ * Détection (une seule fois) du support d'AVX2 par le processeur
+ */
+inline bool cpuHasAvx2(){
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+#endif
+
+/////////// POINTS D'ENTRÉE ///////////
+
+/**
+ * Appelle le noyau vectoriel adapté au type et au processeur, ou la version scalaire
+ */
+template<typename T, bool = SimdSearchable<T>::value>
+struct ArraySearch{
+    static int indexOf(const T* p, int n, const T& v){ return scalarIndexOf(p, n, v); }
+    static int lastIndexOf(const T* p, int n, const T& v){ return scalarLastIndexOf(p, n, v); }
+    static int count(const T* p, int n, const T& v){ return scalarCount(p, n, v); }
+};
+
+#ifdef LIST_SIMD_X86
+template<typename T>
+struct ArraySearch<T, true>{
+    static int indexOf(const T* p, int n, const T& v){ return cpuHasAvx2() ? avx2IndexOf(p, n, v) : sse2IndexOf(p, n, v); }
+    static int lastIndexOf(const T* p, int n, const T& v){ return cpuHasAvx2() ? avx2LastIndexOf(p, n, v) : sse2LastIndexOf(p, n, v); }
+    static int count(const T* p, int n, const T& v){ return cpuHasAvx2() ? avx2Count(p, n, v) : sse2Count(p, n, v); }
+};
+#endif
+
+/**
+ * Position de la première occurrence de v dans p[0..n[, -1 si v n'y est pas
+ */
+template<typename T>
+inline int arrayIndexOf(const T* p, int n, const T& v){
+    return ArraySearch<T>::indexOf(p, n, v);
+}
+
+/**
+ * Position de la dernière occurrence de v dans p[0..n[, -1 si v n'y est pas
+ */
+template<typename T>
+inline int arrayLastIndexOf(const T* p, int n, const T& v){
+    return ArraySearch<T>::lastIndexOf(p, n, v);
+}
+
+/**
+ * Nombre d'occurrences de v dans p[0..n[
+ */
+template<typename T>
+inline int arrayCount(const T* p, int n, const T& v){
+    return ArraySearch<T>::count(p, n, v);
+}
+
+#endif
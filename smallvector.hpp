@@ -0,0 +1,468 @@
+#ifndef _SMALLVECTOR_H_
+#define _SMALLVECTOR_H_
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "list.hpp"
+#include "listbase.hpp"
+#include "simdsearch.hpp"
+#include "sort.hpp"
+#include "vector.hpp"
+
+/**
+ * Vecteur à petit tampon : les N premiers éléments sont stockés dans l'objet lui-même, sans aucune allocation. Le tableau ne passe sur le tas que lorsqu'il déborde (il grossit alors comme un Vector, voir VECTOR_GROWTH_FACTOR), et revient dans l'objet avec shrinkToFit() ou clear(). Un SmallVector de moins de N éléments ne coûte donc ni allocation ni libération, là où le constructeur de Vector réserve toujours LIST_CLUSTER_SIZE cases sur le tas.
+ *
+ * En contrepartie, l'objet occupe N*sizeof(T) octets de plus, et un déplacement (constructeur par déplacement, operator=) doit déplacer un à un les éléments qui sont dans l'objet : il n'est en O(1) que pour un tableau sur le tas.
+ */
+template<typename T, int N = 8>
+class SmallVector : public List<T>, public ListBase<SmallVector<T, N>, T>
+{
+    static_assert(N > 0, "SmallVector : le tampon interne doit contenir au moins un élément");
+
+    private:
+        alignas(T) unsigned char mInline[N*sizeof(T)]; //Tampon interne (mémoire brute)
+        T* mTab; //Tableau des éléments : le tampon interne ou un tableau alloué sur le tas
+        int mSize; //Capacité de mTab (N tant que le tableau est dans l'objet)
+        int mFilled; //Nombre d'éléments (seules les cases [0, mFilled[ contiennent des objets construits)
+        mutable int mCursor; //Itérateur sur le tableau
+
+        T* inlineTab(){
+            return reinterpret_cast<T*>(this->mInline);
+        }
+
+        /**
+         * Allocation et libération de mémoire brute (rien n'est libéré pour le tampon interne)
+         */
+        static T* allocate(int n){
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(){
+            if(!this->isInline())
+                std::allocator<T>().deallocate(this->mTab, this->mSize);
+        }
+
+        /**
+         * Déplace n éléments de src vers la zone brute dst (voir Vector::relocate)
+         */
+        static void relocate(T* dst, T* src, int n){
+            if(std::is_trivially_copyable<T>::value){
+                if(n > 0)
+                    std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n*sizeof(T));
+                return;
+            }
+            for(int i = 0; i < n; i++){
+                ::new(static_cast<void*>(dst + i)) T(std::move(src[i]));
+                src[i].~T();
+            }
+        }
+
+        /**
+         * Remplace mTab par un tableau de capacité "capacity" (>= mFilled) : le tampon interne si capacity vaut N, un tableau alloué sur le tas sinon
+         */
+        void reallocate(int capacity){
+            LIST_STAT(REALLOCATIONS, 1);
+            LIST_STAT(MOVES, mFilled);
+            T* nTab = capacity == N ? this->inlineTab() : allocate(capacity);
+            relocate(nTab, mTab, mFilled);
+            this->deallocate();
+            mTab = nTab;
+            mSize = capacity;
+        }
+
+        /**
+         * Agrandit le tableau de sorte qu'il puisse accueillir au moins n éléments de plus (même croissance que Vector)
+         */
+        void extendTab(int n){
+            int nSize = (int)(mSize * VECTOR_GROWTH_FACTOR);
+            if(nSize < mSize + LIST_CLUSTER_SIZE)
+                nSize = mSize + LIST_CLUSTER_SIZE;
+            if(nSize < mFilled + n)
+                nSize = mFilled + n;
+            this->reallocate(nSize);
+        }
+
+        /**
+         * Décale les éléments [d, mFilled[ de n cases vers l'avant (le tableau est agrandi si nécessaire). Les cases [d, d+n[ restent de la mémoire brute.
+         */
+        void offset(int d, int n){
+            if(n + mFilled > mSize)
+                this->extendTab(n);
+            LIST_STAT(MOVES, mFilled - d);
+            LIST_STAT(BYTES_SHIFTED, (mFilled - d)*sizeof(T));
+
+            if(std::is_trivially_copyable<T>::value){
+                std::memmove(static_cast<void*>(mTab + d + n), static_cast<const void*>(mTab + d), (mFilled - d)*sizeof(T));
+                return;
+            }
+
+            for(int i = mFilled - 1; i >= d; i--){
+                ::new(static_cast<void*>(mTab + i + n)) T(std::move(mTab[i]));
+                mTab[i].~T();
+            }
+        }
+
+        /**
+         * Détruit les éléments [d, d+n[ et décale le reste du tableau de n cases vers l'arrière
+         */
+        void backOffset(int d, int n){
+            for(int i = d; i < d + n; i++)
+                mTab[i].~T();
+            LIST_STAT(MOVES, mFilled - d - n);
+            LIST_STAT(BYTES_SHIFTED, (mFilled - d - n)*sizeof(T));
+
+            if(std::is_trivially_copyable<T>::value){
+                std::memmove(static_cast<void*>(mTab + d), static_cast<const void*>(mTab + d + n), (mFilled - d - n)*sizeof(T));
+                return;
+            }
+
+            for(int i = d; i < mFilled - n; i++){
+                ::new(static_cast<void*>(mTab + i)) T(std::move(mTab[i + n]));
+                mTab[i + n].~T();
+            }
+        }
+
+        /**
+         * Détruit tous les éléments, libère le tableau du tas éventuel et revient sur le tampon interne
+         */
+        void release(){
+            if(!std::is_trivially_destructible<T>::value){
+                for(int i = 0; i < mFilled; i++)
+                    mTab[i].~T();
+            }
+            this->deallocate();
+            mTab = this->inlineTab();
+            mSize = N;
+            mFilled = 0;
+        }
+
+        /**
+         * Reprend les éléments de o (vide et sur son tampon interne) : son tableau s'il est sur le tas, ses éléments un à un sinon. o se retrouve vide.
+         */
+        void steal(SmallVector<T, N>& o){
+            if(o.isInline()){
+                relocate(mTab, o.mTab, o.mFilled);
+                mFilled = o.mFilled;
+            }else{
+                mTab = o.mTab;
+                mSize = o.mSize;
+                mFilled = o.mFilled;
+                o.mTab = o.inlineTab();
+                o.mSize = N;
+            }
+            o.mFilled = 0;
+        }
+
+    public:
+        typedef T* iterator;
+        typedef const T* const_iterator;
+
+        /**
+         * Constructeur par défaut : aucune allocation
+         */
+        SmallVector(){
+            mTab = this->inlineTab();
+            mSize = N;
+            mFilled = 0;
+            mCursor = -1;
+        }
+
+        /**
+         * Constructeur réservant directement de la place pour "capacity" éléments (sur le tas seulement si capacity dépasse N)
+         */
+        explicit SmallVector(int capacity) : SmallVector(){
+            this->reserve(capacity);
+        }
+
+        /**
+         * Constructeur de copie : les éléments vont dans le tampon interne s'ils y tiennent, dans un tableau dimensionné au plus juste sinon
+         */
+        SmallVector(const SmallVector<T, N>& o) : SmallVector(){
+            if(o.mFilled > N){
+                mTab = allocate(o.mFilled);
+                mSize = o.mFilled;
+            }
+            LIST_STAT(COPIES, o.mFilled);
+            for(; mFilled < o.mFilled; mFilled++)
+                ::new(static_cast<void*>(mTab + mFilled)) T(o.mTab[mFilled]);
+        }
+
+        /**
+         * Constructeur par déplacement : on récupère le tableau de o s'il est sur le tas, on déplace ses éléments sinon
+         */
+        SmallVector(SmallVector<T, N>&& o) noexcept(std::is_nothrow_move_constructible<T>::value) : SmallVector(){
+            this->steal(o);
+        }
+
+        SmallVector<T, N>& operator= (SmallVector<T, N> o){
+            this->release();
+            this->steal(o);
+            mCursor = -1;
+            return *this;
+        }
+
+        ~SmallVector(){
+            this->release();
+        }
+
+        /**
+         * Vrai si les éléments sont dans le tampon interne de l'objet (aucune mémoire allouée)
+         */
+        bool isInline() const{
+            return static_cast<const void*>(this->mTab) == static_cast<const void*>(this->mInline);
+        }
+
+        /**
+         * Taille du tampon interne
+         */
+        static constexpr int inlineCapacity(){
+            return N;
+        }
+
+        int size() const{
+            return this->mFilled;
+        }
+
+        int capacity() const{
+            return this->mSize;
+        }
+
+        /**
+         * Garantit que le vecteur peut contenir n éléments sans réallocation
+         */
+        void reserve(int n){
+            if(n > mSize)
+                this->reallocate(n);
+        }
+
+        /**
+         * Ramène la capacité au nombre d'éléments présents, et revient dans le tampon interne si les éléments y tiennent
+         */
+        void shrinkToFit(){
+            int capacity = mFilled > N ? mFilled : N;
+            if(capacity < mSize)
+                this->reallocate(capacity);
+        }
+
+        /**
+         * Supprime tous les éléments et libère le tableau du tas éventuel
+         */
+        void clear(){
+            this->release();
+            mCursor = -1;
+        }
+
+        /**
+         * Fixe le nombre d'éléments à n (voir Vector::resize)
+         */
+        void resize(int n, const T& value = T()){
+            if(n < 0)
+                n = 0;
+            if(n > mFilled)
+                LIST_STAT(COPIES, n - mFilled);
+            if(n > mSize){
+                T v(value); //value peut être un élément du tableau qu'on va réallouer
+                this->reallocate(n);
+                for(; mFilled < n; mFilled++)
+                    ::new(static_cast<void*>(mTab + mFilled)) T(v);
+            }
+            for(; mFilled < n; mFilled++)
+                ::new(static_cast<void*>(mTab + mFilled)) T(value);
+            for(; mFilled > n; mFilled--)
+                mTab[mFilled - 1].~T();
+        }
+
+        /**
+         * Accès direct au tableau des éléments (valide jusqu'à la prochaine modification, ou au prochain déplacement, du vecteur)
+         */
+        T* data(){
+            return this->mTab;
+        }
+
+        const T* data() const{
+            return this->mTab;
+        }
+
+        iterator begin(){
+            return this->mTab;
+        }
+
+        iterator end(){
+            return this->mTab + this->mFilled;
+        }
+
+        const_iterator begin() const{
+            return this->mTab;
+        }
+
+        const_iterator end() const{
+            return this->mTab + this->mFilled;
+        }
+
+        /**
+         * Le vecteur entier forme un seul bloc contigu
+         */
+        void firstChunk(ListChunk<T>& c) const{
+            c.begin = this->mFilled == 0 ? nullptr : this->mTab;
+            c.end = this->mFilled == 0 ? nullptr : this->mTab + this->mFilled;
+            c.node = nullptr;
+            c.index = 0;
+        }
+
+        void nextChunk(ListChunk<T>& c) const{
+            c.begin = nullptr;
+            c.end = nullptr;
+        }
+
+        void append(T e){
+            if(mFilled == mSize)
+                this->extendTab(1);
+
+            ::new(static_cast<void*>(mTab + mFilled)) T(std::move(e));
+            mFilled++;
+        }
+
+        void prepend(T e){
+            this->offset(0, 1);
+
+            ::new(static_cast<void*>(mTab)) T(std::move(e));
+            mFilled++;
+        }
+
+        T operator[] (int i) const{
+            listCheckIndex(i, this->mFilled);
+
+            return this->mTab[i];
+        }
+
+        T& operator[] (int i){
+            listCheckIndex(i, this->mFilled);
+
+            return this->mTab[i];
+        }
+
+        bool hasNext() const{
+            return this->mCursor+1 < this->mFilled;
+        }
+
+        T next() const{
+            if(hasNext()){
+                mCursor++;
+                return this->mTab[this->mCursor];
+            }
+
+            if(this->mFilled == 0)
+                throw EmptyContainerException();
+
+            throw IndexOutOfBoundsException();
+        }
+
+        T first() const{
+            if(this->mFilled == 0)
+               throw EmptyContainerException();
+
+            mCursor = -1;
+            return this->mTab[mCursor+1];
+        }
+
+        T last() const{
+            if(this->mFilled == 0)
+                throw EmptyContainerException();
+
+            return this->mTab[this->mFilled-1];
+        }
+
+        /**
+         * Recherches dans le tableau (vectorisées pour les types arithmétiques, voir simdsearch.hpp)
+         */
+        int indexOf(const T& t) const{
+            return arrayIndexOf(this->mTab, this->mFilled, t);
+        }
+
+        int lastIndexOf(const T& t) const{
+            return arrayLastIndexOf(this->mTab, this->mFilled, t);
+        }
+
+        int count(const T& t) const{
+            return arrayCount(this->mTab, this->mFilled, t);
+        }
+
+        bool contains(const T& t) const{
+            return this->indexOf(t) != -1;
+        }
+
+        void remove(T e){
+            int i = this->pos(e);
+            this->backOffset(i, 1);
+            mFilled--;
+        }
+
+        /**
+         * Supprime le i-ème élément du vecteur
+         */
+        void removeAt(int i){
+            if(this->mFilled == 0)
+                throw EmptyContainerException();
+
+            if(i < 0 || this->mFilled <= i)
+                throw IndexOutOfBoundsException();
+
+            this->backOffset(i, 1);
+            mFilled--;
+        }
+
+        /**
+         * Versions sans exception (voir List<T>) : une seule vérification d'indice pour tryGet(), une seule recherche vectorisée pour tryRemove()
+         */
+        std::optional<T> tryGet(int i) const{
+            if((unsigned)i >= (unsigned)this->mFilled)
+                return std::nullopt;
+            return this->mTab[i];
+        }
+
+        bool tryRemove(const T& e){
+            int i = this->indexOf(e);
+            if(i == -1)
+                return false;
+            this->backOffset(i, 1);
+            mFilled--;
+            return true;
+        }
+
+        /**
+         * Retrait en fin de tableau, sans aucun décalage
+         */
+        T removeLast(){
+            if(this->mFilled == 0)
+                throw EmptyContainerException();
+
+            T ret = std::move(this->mTab[this->mFilled - 1]);
+            this->mTab[this->mFilled - 1].~T();
+            mFilled--;
+            return ret;
+        }
+
+        /**
+         * Tri en place du tableau (introsort, voir sort.hpp)
+         */
+        template<typename Cmp>
+        void sort(Cmp cmp){
+            arraySort(this->mTab, this->mTab + this->mFilled, cmp);
+        }
+
+        void sort(const typename List<T>::Comparator& cmp){
+            arraySort(this->mTab, this->mTab + this->mFilled, cmp);
+        }
+
+        void sort(){
+            this->sort(std::less<T>());
+        }
+
+};
+
+#endif
@@ -0,0 +1,525 @@
+#ifndef _SOAVECTOR_H_
+#define _SOAVECTOR_H_
+
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "list.hpp"
+#include "vector.hpp"
+
+/**
+ * Alignement (en octets) du début de chaque colonne d'un SoAVector : une ligne de cache, ce qui convient aussi aux instructions vectorielles les plus larges
+ */
+#ifndef SOAVECTOR_ALIGN
+#define SOAVECTOR_ALIGN 64
+#endif
+
+/**
+ * Vue sur une colonne d'un SoAVector : mSize éléments contigus à partir de mData (T vaut F ou const F). Elle reste valide tant que le SoAVector n'est pas agrandi ni détruit.
+ *
+ * data() indique au compilateur que le tableau est aligné sur SOAVECTOR_ALIGN octets : une boucle simple sur la colonne est vectorisée sans boucle de prologue.
+ */
+template<typename T>
+class SoAColumn
+{
+    private:
+        T* mData;
+        int mSize;
+
+    public:
+        typedef T* iterator;
+
+        SoAColumn(T* data, int size){
+            mData = data;
+            mSize = size;
+        }
+
+        T* data() const{
+            return static_cast<T*>(__builtin_assume_aligned(mData, SOAVECTOR_ALIGN));
+        }
+
+        int size() const{
+            return mSize;
+        }
+
+        T& operator[] (int i) const{
+            return mData[i];
+        }
+
+        T* begin() const{
+            return this->data();
+        }
+
+        T* end() const{
+            return mData + mSize;
+        }
+};
+
+/**
+ * Ligne i d'un SoAVector (V vaut SoAVector<Fields...> ou const SoAVector<Fields...>) : un objet léger qui désigne la ligne sans copier ses champs. get<K>() renvoie une référence sur le champ K ; on peut aussi convertir la ligne en std::tuple (copie des champs) ou lui affecter un std::tuple.
+ */
+template<typename V>
+class SoARow
+{
+    private:
+        V* mV;
+        int mI;
+
+    public:
+        SoARow(V* v, int i){
+            mV = v;
+            mI = i;
+        }
+
+        template<int K>
+        auto& get() const{
+            return mV->template column<K>()[mI];
+        }
+
+        operator typename V::value_type() const{
+            return mV->row(mI);
+        }
+
+        const SoARow& operator= (const typename V::value_type& t) const{
+            mV->set(mI, t);
+            return *this;
+        }
+
+        int index() const{
+            return mI;
+        }
+};
+
+/**
+ * Itérateur sur les lignes d'un SoAVector : operator* renvoie une SoARow (par valeur)
+ */
+template<typename V>
+class SoAIterator
+{
+    private:
+        V* mV;
+        int mI;
+
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef SoARow<V> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef SoARow<V> reference;
+
+        SoAIterator(V* v, int i){
+            mV = v;
+            mI = i;
+        }
+
+        SoARow<V> operator* () const{
+            return SoARow<V>(mV, mI);
+        }
+
+        SoAIterator& operator++ (){
+            mI++;
+            return *this;
+        }
+
+        SoAIterator operator++ (int){
+            SoAIterator ret = *this;
+            mI++;
+            return ret;
+        }
+
+        bool operator== (const SoAIterator& o) const{
+            return mI == o.mI;
+        }
+
+        bool operator!= (const SoAIterator& o) const{
+            return mI != o.mI;
+        }
+};
+
+/**
+ * Vecteur d'enregistrements stocké par colonnes ("structure of arrays") : SoAVector<long, int, double> garde tous les premiers champs dans un tableau, tous les seconds dans un autre, etc., chaque tableau étant aligné sur SOAVECTOR_ALIGN octets. Un parcours qui ne lit qu'un champ (somme des prix, recherche d'un identifiant...) ne charge donc en cache que ce champ, là où un Vector<Record> ramène chaque enregistrement entier (et ses octets de bourrage) ; et column<K>() donne un tableau contigu de même type que le compilateur sait vectoriser.
+ *
+ * On garde l'interface d'une liste : append(), operator[], removeAt(), parcours par for(auto r : v)... mais une ligne n'existe nulle part en mémoire sous forme de structure : operator[] et les itérateurs renvoient une SoARow, qui désigne la ligne et donne accès à ses champs (r.get<2>()). Pour la même raison SoAVector n'hérite pas de List<T>, dont l'operator[] doit renvoyer une référence sur un T.
+ *
+ * Les colonnes grossissent ensemble, comme le tableau d'un Vector (voir VECTOR_GROWTH_FACTOR) : un append() qui agrandit le SoAVector déplace toutes les colonnes et invalide les SoAColumn obtenues auparavant.
+ */
+template<typename... Fields>
+class SoAVector
+{
+    static_assert(sizeof...(Fields) > 0, "SoAVector : il faut au moins un champ");
+
+    public:
+        typedef std::tuple<Fields...> value_type;
+
+        /**
+         * Type du champ K
+         */
+        template<int K>
+        using Field = typename std::tuple_element<K, value_type>::type;
+
+        typedef SoARow<SoAVector<Fields...> > Row;
+        typedef SoARow<const SoAVector<Fields...> > ConstRow;
+        typedef SoAIterator<SoAVector<Fields...> > iterator;
+        typedef SoAIterator<const SoAVector<Fields...> > const_iterator;
+
+    private:
+        typedef std::index_sequence_for<Fields...> Indices;
+
+        std::tuple<Fields*...> mCols; //Une colonne par champ (mémoire brute : seules les cases [0, mFilled[ sont construites)
+        int mSize; //Capacité commune des colonnes
+        int mFilled; //Nombre de lignes
+        float mGrowth; //Facteur de croissance des colonnes (voir VECTOR_GROWTH_FACTOR)
+#ifdef LIST_STATS
+        mutable ListStats mStats; //Compteurs d'instrumentation (voir liststats.hpp)
+#endif
+
+        template<typename F>
+        static constexpr std::size_t alignment(){
+            return alignof(F) > SOAVECTOR_ALIGN ? alignof(F) : SOAVECTOR_ALIGN;
+        }
+
+        template<typename F>
+        static F* allocate(int n){
+            if(n <= 0)
+                return nullptr;
+            return static_cast<F*>(::operator new(n*sizeof(F), std::align_val_t(alignment<F>())));
+        }
+
+        template<typename F>
+        static void deallocate(F* p){
+            if(p != nullptr)
+                ::operator delete(p, std::align_val_t(alignment<F>()));
+        }
+
+        /**
+         * Appelle f sur chaque colonne (un F* par champ), dans l'ordre des champs
+         */
+        template<typename Fn>
+        void forColumns(Fn f){
+            std::apply([&f](auto*&... p){ (f(p), ...); }, mCols);
+        }
+
+        /**
+         * Déplace n éléments de src vers la zone brute dst (voir Vector::relocate)
+         */
+        template<typename F>
+        static void relocate(F* dst, F* src, int n){
+            if(std::is_trivially_copyable<F>::value){
+                if(n > 0)
+                    std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n*sizeof(F));
+                return;
+            }
+            for(int i = 0; i < n; i++){
+                ::new(static_cast<void*>(dst + i)) F(std::move(src[i]));
+                src[i].~F();
+            }
+        }
+
+        /**
+         * Remplace chaque colonne par un tableau de capacité "capacity" (>= mFilled). Toutes les colonnes sont allouées avant qu'on ne déplace quoi que ce soit : si une allocation échoue, le SoAVector n'a pas changé.
+         */
+        void reallocate(int capacity){
+            LIST_STAT(REALLOCATIONS, 1);
+            LIST_STAT(MOVES, mFilled);
+            std::tuple<Fields*...> nCols;
+            std::apply([](auto*&... p){ ((p = nullptr), ...); }, nCols);
+            try{
+                std::apply([capacity](auto*&... p){ ((p = allocate<typename std::remove_reference<decltype(*p)>::type>(capacity)), ...); }, nCols);
+            }catch(...){
+                std::apply([](auto*&... p){ (deallocate(p), ...); }, nCols);
+                throw;
+            }
+            this->moveColumns(nCols, Indices());
+            mSize = capacity;
+        }
+
+        template<std::size_t... I>
+        void moveColumns(std::tuple<Fields*...>& nCols, std::index_sequence<I...>){
+            (relocate(std::get<I>(nCols), std::get<I>(mCols), mFilled), ...);
+            (deallocate(std::get<I>(mCols)), ...);
+            mCols = nCols;
+        }
+
+        void extendTab(int n){
+            int nSize;
+            if(mGrowth > 1)
+                nSize = (int)(mSize * mGrowth);
+            else
+                nSize = mSize + (n/LIST_CLUSTER_SIZE + 1)*LIST_CLUSTER_SIZE;
+
+            if(nSize < mSize + LIST_CLUSTER_SIZE)
+                nSize = mSize + LIST_CLUSTER_SIZE;
+            if(nSize < mFilled + n)
+                nSize = mFilled + n;
+
+            this->reallocate(nSize);
+        }
+
+        /**
+         * Détruit les champs de la ligne i dans les "columns" premières colonnes
+         */
+        void destroyRow(int i, int columns){
+            int k = 0;
+            this->forColumns([i, columns, &k](auto* p){
+                typedef typename std::remove_reference<decltype(*p)>::type F;
+                if(k++ < columns)
+                    p[i].~F();
+            });
+        }
+
+        /**
+         * Construit la ligne mFilled (qui doit exister dans les colonnes) à partir de vals. Si la construction d'un champ lève une exception, les champs déjà construits sont détruits.
+         */
+        template<std::size_t... I, typename... Args>
+        void construct(std::index_sequence<I...>, Args&&... vals){
+            int built = 0;
+            try{
+                ((::new(static_cast<void*>(std::get<I>(mCols) + mFilled)) Fields(std::forward<Args>(vals)), built++), ...);
+            }catch(...){
+                this->destroyRow(mFilled, built);
+                throw;
+            }
+            mFilled++;
+        }
+
+        template<std::size_t... I>
+        value_type row(int i, std::index_sequence<I...>) const{
+            return value_type(std::get<I>(mCols)[i]...);
+        }
+
+        template<std::size_t... I>
+        void set(int i, const value_type& t, std::index_sequence<I...>){
+            ((std::get<I>(mCols)[i] = std::get<I>(t)), ...);
+        }
+
+        template<std::size_t... I>
+        void copyRow(const SoAVector<Fields...>& o, int i, std::index_sequence<I...>){
+            this->construct(Indices(), std::get<I>(o.mCols)[i]...);
+        }
+
+        void release(){
+            this->truncate(0);
+            this->forColumns([](auto*& p){
+                deallocate(p);
+                p = nullptr;
+            });
+            mSize = 0;
+        }
+
+        void truncate(int n){
+            for(; mFilled > n; mFilled--)
+                this->destroyRow(mFilled - 1, sizeof...(Fields));
+        }
+
+    public:
+        /**
+         * SoAVector vide, avec LIST_CLUSTER_SIZE lignes réservées
+         */
+        SoAVector(){
+            std::apply([](auto*&... p){ ((p = nullptr), ...); }, mCols);
+            mSize = 0;
+            mFilled = 0;
+            mGrowth = VECTOR_GROWTH_FACTOR;
+            this->reallocate(LIST_CLUSTER_SIZE);
+        }
+
+        /**
+         * SoAVector vide, avec "capacity" lignes réservées dans chaque colonne
+         */
+        explicit SoAVector(int capacity, float growth = VECTOR_GROWTH_FACTOR){
+            std::apply([](auto*&... p){ ((p = nullptr), ...); }, mCols);
+            mSize = 0;
+            mFilled = 0;
+            mGrowth = growth;
+            if(capacity > 0)
+                this->reallocate(capacity);
+        }
+
+        SoAVector(const SoAVector<Fields...>& o) : SoAVector(o.mFilled, o.mGrowth){
+            for(int i = 0; i < o.mFilled; i++)
+                this->copyRow(o, i, Indices());
+        }
+
+        SoAVector(SoAVector<Fields...>&& o) noexcept{
+            mCols = o.mCols;
+            mSize = o.mSize;
+            mFilled = o.mFilled;
+            mGrowth = o.mGrowth;
+            std::apply([](auto*&... p){ ((p = nullptr), ...); }, o.mCols);
+            o.mSize = 0;
+            o.mFilled = 0;
+        }
+
+        SoAVector<Fields...>& operator= (SoAVector<Fields...> o){
+            std::swap(mCols, o.mCols);
+            std::swap(mSize, o.mSize);
+            std::swap(mFilled, o.mFilled);
+            std::swap(mGrowth, o.mGrowth);
+            return *this;
+        }
+
+        ~SoAVector(){
+            this->release();
+        }
+
+        /**
+         * Compteurs d'instrumentation (tous nuls si LIST_STATS n'est pas défini, voir liststats.hpp)
+         */
+        ListStats stats() const{
+#ifdef LIST_STATS
+            return mStats;
+#else
+            return ListStats();
+#endif
+        }
+
+        void resetStats(){
+#ifdef LIST_STATS
+            mStats.reset();
+#endif
+        }
+
+        /**
+         * Nombre de lignes
+         */
+        int size() const{
+            return mFilled;
+        }
+
+        /**
+         * Nombre de lignes que le SoAVector peut contenir sans réallocation
+         */
+        int capacity() const{
+            return mSize;
+        }
+
+        bool isEmpty() const{
+            return mFilled == 0;
+        }
+
+        void reserve(int n){
+            if(n > mSize)
+                this->reallocate(n);
+        }
+
+        /**
+         * Supprime toutes les lignes (la capacité est conservée)
+         */
+        void clear(){
+            this->truncate(0);
+        }
+
+        /**
+         * Ajoute une ligne formée des champs vals. Ils sont pris par valeur, comme dans Vector::append : un champ lu dans le SoAVector lui-même (s.append(s[0].get<0>(), ...)) est copié avant que l'agrandissement ne libère les colonnes.
+         */
+        void append(Fields... vals){
+            if(mFilled == mSize)
+                this->extendTab(1);
+            this->construct(Indices(), std::move(vals)...);
+        }
+
+        /**
+         * Ajoute une ligne à partir d'un std::tuple
+         */
+        void appendRow(const value_type& t){
+            std::apply([this](const Fields&... vals){ this->append(vals...); }, t);
+        }
+
+        /**
+         * Ligne i (IndexOutOfBoundsException si elle n'existe pas)
+         */
+        Row operator[] (int i){
+            listCheckIndex(i, mFilled);
+            return Row(this, i);
+        }
+
+        ConstRow operator[] (int i) const{
+            listCheckIndex(i, mFilled);
+            return ConstRow(this, i);
+        }
+
+        /**
+         * Copie des champs de la ligne i (l'indice est toujours vérifié, quel que soit LIST_BOUNDS_CHECK)
+         */
+        value_type row(int i) const{
+            if((unsigned)i >= (unsigned)mFilled)
+                listIndexError(mFilled);
+            return this->row(i, Indices());
+        }
+
+        /**
+         * Remplace les champs de la ligne i par ceux de t (l'indice est toujours vérifié)
+         */
+        void set(int i, const value_type& t){
+            if((unsigned)i >= (unsigned)mFilled)
+                listIndexError(mFilled);
+            this->set(i, t, Indices());
+        }
+
+        /**
+         * Colonne du champ K (voir SoAColumn)
+         */
+        template<int K>
+        SoAColumn< Field<K> > column(){
+            return SoAColumn< Field<K> >(std::get<K>(mCols), mFilled);
+        }
+
+        template<int K>
+        SoAColumn<const Field<K> > column() const{
+            return SoAColumn<const Field<K> >(std::get<K>(mCols), mFilled);
+        }
+
+        /**
+         * Supprime la ligne i : les lignes suivantes sont décalées d'une case dans chaque colonne
+         */
+        void removeAt(int i){
+            if(mFilled == 0)
+                throw EmptyContainerException();
+            if(i < 0 || mFilled <= i)
+                throw IndexOutOfBoundsException();
+
+            int n = mFilled;
+            this->forColumns([i, n](auto* p){
+                typedef typename std::remove_reference<decltype(*p)>::type F;
+                if(std::is_trivially_copyable<F>::value){
+                    std::memmove(static_cast<void*>(p + i), static_cast<const void*>(p + i + 1), (n - i - 1)*sizeof(F));
+                    return;
+                }
+                for(int k = i; k < n - 1; k++)
+                    p[k] = std::move(p[k + 1]);
+                p[n - 1].~F();
+            });
+            mFilled--;
+        }
+
+        /**
+         * Supprime la dernière ligne (EmptyContainerException si le SoAVector est vide)
+         */
+        void removeLast(){
+            if(mFilled == 0)
+                throw EmptyContainerException();
+            this->truncate(mFilled - 1);
+        }
+
+        iterator begin(){
+            return iterator(this, 0);
+        }
+
+        iterator end(){
+            return iterator(this, mFilled);
+        }
+
+        const_iterator begin() const{
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const{
+            return const_iterator(this, mFilled);
+        }
+};
+
+#endif
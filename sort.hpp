@@ -0,0 +1,168 @@
+#ifndef _SORT_H_
+#define _SORT_H_
+
+#include <utility>
+
+/**
+ * Algorithmes de tri et de recherche dichotomique sur un tableau contigu [first, last[ (utilisés par List<T>::sort() et ses implémentations).
+ *
+ * arraySort est un tri introspectif ("introsort") : un tri rapide dont le pivot est la médiane de trois éléments, qui laisse les petits sous-tableaux (ARRAY_SORT_THRESHOLD éléments au plus) à un tri par insertion final, et qui bascule sur un tri par tas si la récursion devient trop profonde (plus de 2 log2(n) niveaux). Le tri est fait en place, en O(n log n) dans le pire des cas, mais n'est pas stable.
+ *
+ * cmp(a, b) doit renvoyer true si a doit être placé strictement avant b (comme l'opérateur <).
+ */
+
+/**
+ * Taille en dessous de laquelle un sous-tableau est trié par insertion
+ */
+#ifndef ARRAY_SORT_THRESHOLD
+#define ARRAY_SORT_THRESHOLD 16
+#endif
+
+/**
+ * Tri par insertion de [first, last[
+ */
+template<typename T, typename Cmp>
+void insertionSort(T* first, T* last, Cmp& cmp){
+    if(first == last)
+        return;
+    for(T* i = first + 1; i < last; ++i){
+        T v = std::move(*i);
+        T* j = i;
+        if(cmp(v, *first)){ //Le nouvel élément est le plus petit : on décale tout sans comparer
+            for(; j > first; --j)
+                *j = std::move(*(j - 1));
+        }
+        else{ //*first arrête la boucle : pas besoin de tester j > first
+            for(; cmp(v, *(j - 1)); --j)
+                *j = std::move(*(j - 1));
+        }
+        *j = std::move(v);
+    }
+}
+
+/**
+ * Fait descendre dans le tas [first, first + n[ la valeur v placée à la racine du sous-arbre i
+ */
+template<typename T, typename Cmp>
+void siftDown(T* first, long i, long n, T v, Cmp& cmp){
+    for(;;){
+        long child = 2*i + 1;
+        if(child >= n)
+            break;
+        if(child + 1 < n && cmp(first[child], first[child + 1]))
+            child++;
+        if(!cmp(v, first[child]))
+            break;
+        first[i] = std::move(first[child]);
+        i = child;
+    }
+    first[i] = std::move(v);
+}
+
+template<typename T, typename Cmp>
+void heapSort(T* first, T* last, Cmp& cmp){
+    long n = last - first;
+    for(long i = n/2 - 1; i >= 0; i--)
+        siftDown(first, i, n, T(std::move(first[i])), cmp);
+    for(long k = n - 1; k > 0; k--){
+        T v = std::move(first[k]);
+        first[k] = std::move(first[0]);
+        siftDown(first, 0, k, std::move(v), cmp);
+    }
+}
+
+/**
+ * Place en *first la médiane de *a, *b et *c
+ */
+template<typename T, typename Cmp>
+void moveMedianToFirst(T* first, T* a, T* b, T* c, Cmp& cmp){
+    if(cmp(*a, *b)){
+        if(cmp(*b, *c))
+            std::swap(*first, *b);
+        else if(cmp(*a, *c))
+            std::swap(*first, *c);
+        else
+            std::swap(*first, *a);
+    }
+    else if(cmp(*a, *c))
+        std::swap(*first, *a);
+    else if(cmp(*b, *c))
+        std::swap(*first, *c);
+    else
+        std::swap(*first, *b);
+}
+
+/**
+ * Partition de Hoare de ]first, last[ autour du pivot *first : renvoie le début de la partie droite. Le pivot (médiane de trois) garantit que les deux curseurs s'arrêtent sans test de bornes.
+ */
+template<typename T, typename Cmp>
+T* partitionPivot(T* first, T* last, Cmp& cmp){
+    T* mid = first + (last - first)/2;
+    moveMedianToFirst(first, first + 1, mid, last - 1, cmp);
+    T* lo = first + 1;
+    T* hi = last;
+    for(;;){
+        while(cmp(*lo, *first))
+            ++lo;
+        --hi;
+        while(cmp(*first, *hi))
+            --hi;
+        if(!(lo < hi))
+            return lo;
+        std::swap(*lo, *hi);
+        ++lo;
+    }
+}
+
+/**
+ * Boucle principale de l'introsort : les sous-tableaux de moins de ARRAY_SORT_THRESHOLD éléments sont laissés en l'état pour le tri par insertion final. On ne récurse que sur la partie droite, la gauche est traitée par la boucle.
+ */
+template<typename T, typename Cmp>
+void introSortLoop(T* first, T* last, int depth, Cmp& cmp){
+    while(last - first > ARRAY_SORT_THRESHOLD){
+        if(depth == 0){
+            heapSort(first, last, cmp);
+            return;
+        }
+        depth--;
+        T* cut = partitionPivot(first, last, cmp);
+        introSortLoop(cut, last, depth, cmp);
+        last = cut;
+    }
+}
+
+/**
+ * Trie [first, last[ en place selon cmp
+ */
+template<typename T, typename Cmp>
+void arraySort(T* first, T* last, Cmp cmp){
+    long n = last - first;
+    if(n < 2)
+        return;
+    int depth = 0;
+    for(long k = n; k > 1; k /= 2)
+        depth += 2;
+    introSortLoop(first, last, depth, cmp);
+    //Chaque élément est maintenant à moins de ARRAY_SORT_THRESHOLD cases de sa place : le tri par insertion final est linéaire
+    insertionSort(first, last, cmp);
+}
+
+/**
+ * Position du premier élément de [first, last[ (trié selon cmp) qui n'est pas strictement avant key
+ */
+template<typename T, typename Cmp>
+const T* arrayLowerBound(const T* first, const T* last, const T& key, Cmp& cmp){
+    long n = last - first;
+    while(n > 0){
+        long half = n/2;
+        if(cmp(first[half], key)){
+            first += half + 1;
+            n -= half + 1;
+        }
+        else
+            n = half;
+    }
+    return first;
+}
+
+#endif
@@ -0,0 +1,342 @@
+#ifndef _STREAM_H_
+#define _STREAM_H_
+
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "vector.hpp"
+
+/**
+ * Chaînes de traitement paresseuses sur les listes, dans l'esprit des Streams de Java :
+ *
+ *     Vector<int> r = stream(liste).filter([](int x){ return x % 2 == 0; }).map([](int x){ return 3*x; }).limit(10).collect();
+ *
+ * stream(l) ne copie rien et ne parcourt rien : filter(), map(), skip() et limit() ne font que construire la chaîne, et c'est l'opération finale (collect(), reduce(), count(), forEach(), findFirst(), anyMatch(), allMatch()) qui la parcourt. Chaque étape est un type template qui enveloppe la précédente : toute la chaîne est connue à la compilation et le compilateur la fusionne en une seule boucle sur la liste, sans appel virtuel (sauf à travers un List<T>&, où le passage d'un bloc d'éléments au suivant en coûte un, voir ListChunk) et sans conteneur intermédiaire.
+ *
+ * Les éléments sont poussés de la source vers l'opération finale. Chaque étape peut interrompre le parcours : limit(k) l'arrête après le k-ième élément, findFirst() et anyMatch() au premier élément trouvé. Les éléments qui suivent ne sont alors jamais lus, ni filtrés, ni transformés.
+ *
+ * collect() réserve d'emblée la place de tous les éléments lorsque leur nombre exact est connu : il l'est à la source, map(), skip() et limit() le conservent, filter() le rend inconnu (et limit() ne le rend pas connu : après un filter(), limit(k) peut produire moins de k éléments).
+ *
+ * Un Stream garde une référence sur la liste : celle-ci doit rester en vie, et ne pas être modifiée, tant que le Stream est utilisé. Une même chaîne peut servir à plusieurs opérations finales, chacune la reprend depuis le début.
+ */
+
+/**
+ * Source d'un Stream : les éléments de [first, last[
+ */
+template<typename It>
+class StreamRange
+{
+    private:
+        It mFirst;
+        It mLast;
+        int mSize;
+
+    public:
+        StreamRange(It first, It last, int size){
+            mFirst = first;
+            mLast = last;
+            mSize = size;
+        }
+
+        /**
+         * Passe chaque élément à sink, jusqu'à la fin ou jusqu'à ce que sink renvoie false
+         */
+        template<typename Sink>
+        void run(Sink&& sink){
+            for(It it = mFirst; it != mLast; ++it){
+                if(!sink(*it))
+                    return;
+            }
+        }
+
+        /**
+         * Nombre d'éléments produits, -1 s'il est inconnu
+         */
+        int sizeHint() const{
+            return mSize;
+        }
+};
+
+/**
+ * Étape filter() : ne transmet que les éléments qui vérifient mPred
+ */
+template<typename Src, typename P>
+class StreamFilter
+{
+    private:
+        Src mSrc;
+        P mPred;
+
+    public:
+        StreamFilter(Src src, P pred) : mSrc(std::move(src)), mPred(std::move(pred)){}
+
+        template<typename Sink>
+        void run(Sink&& sink){
+            mSrc.run([this, &sink](auto&& e){
+                return mPred(e) ? sink(std::forward<decltype(e)>(e)) : true;
+            });
+        }
+
+        int sizeHint() const{
+            return -1;
+        }
+};
+
+/**
+ * Étape map() : transmet mF(e) à la place de chaque élément e
+ */
+template<typename Src, typename F>
+class StreamMap
+{
+    private:
+        Src mSrc;
+        F mF;
+
+    public:
+        StreamMap(Src src, F f) : mSrc(std::move(src)), mF(std::move(f)){}
+
+        template<typename Sink>
+        void run(Sink&& sink){
+            mSrc.run([this, &sink](auto&& e){
+                return sink(mF(std::forward<decltype(e)>(e)));
+            });
+        }
+
+        int sizeHint() const{
+            return mSrc.sizeHint();
+        }
+};
+
+/**
+ * Étape skip() : ignore les mK premiers éléments
+ */
+template<typename Src>
+class StreamSkip
+{
+    private:
+        Src mSrc;
+        int mK;
+
+    public:
+        StreamSkip(Src src, int k) : mSrc(std::move(src)), mK(k){}
+
+        template<typename Sink>
+        void run(Sink&& sink){
+            int n = 0;
+            mSrc.run([this, &sink, &n](auto&& e){
+                if(n < mK){
+                    n++;
+                    return true;
+                }
+                return sink(std::forward<decltype(e)>(e));
+            });
+        }
+
+        int sizeHint() const{
+            int s = mSrc.sizeHint();
+            if(s == -1)
+                return -1;
+            return s > mK ? s - mK : 0;
+        }
+};
+
+/**
+ * Étape limit() : arrête le parcours après le mK-ième élément
+ */
+template<typename Src>
+class StreamLimit
+{
+    private:
+        Src mSrc;
+        int mK;
+
+    public:
+        StreamLimit(Src src, int k) : mSrc(std::move(src)), mK(k){}
+
+        template<typename Sink>
+        void run(Sink&& sink){
+            if(mK <= 0)
+                return;
+            int n = 0;
+            mSrc.run([this, &sink, &n](auto&& e){
+                return sink(std::forward<decltype(e)>(e)) && ++n < mK;
+            });
+        }
+
+        int sizeHint() const{
+            int s = mSrc.sizeHint();
+            if(s == -1)
+                return -1; //Au plus mK, mais peut-être moins : collect() ne réserve que pour un nombre exact
+            int k = mK > 0 ? mK : 0;
+            return s > k ? k : s;
+        }
+};
+
+/**
+ * Chaîne de traitement produisant des éléments de type T (voir en tête de fichier). Pipe est le type de la dernière étape.
+ */
+template<typename T, typename Pipe>
+class Stream
+{
+    private:
+        Pipe mPipe;
+
+    public:
+        typedef T value_type;
+
+        explicit Stream(Pipe pipe) : mPipe(std::move(pipe)){}
+
+        /**
+         * Ne garde que les éléments e tels que pred(e)
+         */
+        template<typename P>
+        Stream< T, StreamFilter<Pipe, P> > filter(P pred) const{
+            return Stream< T, StreamFilter<Pipe, P> >(StreamFilter<Pipe, P>(mPipe, std::move(pred)));
+        }
+
+        /**
+         * Remplace chaque élément e par f(e)
+         */
+        template<typename F>
+        auto map(F f) const -> Stream< typename std::decay<decltype(f(std::declval<const T&>()))>::type, StreamMap<Pipe, F> >{
+            typedef typename std::decay<decltype(f(std::declval<const T&>()))>::type U;
+            return Stream< U, StreamMap<Pipe, F> >(StreamMap<Pipe, F>(mPipe, std::move(f)));
+        }
+
+        /**
+         * Ignore les k premiers éléments
+         */
+        Stream< T, StreamSkip<Pipe> > skip(int k) const{
+            return Stream< T, StreamSkip<Pipe> >(StreamSkip<Pipe>(mPipe, k));
+        }
+
+        /**
+         * Ne garde que les k premiers éléments (le parcours s'arrête ensuite)
+         */
+        Stream< T, StreamLimit<Pipe> > limit(int k) const{
+            return Stream< T, StreamLimit<Pipe> >(StreamLimit<Pipe>(mPipe, k));
+        }
+
+        /**
+         * Applique f à chaque élément
+         */
+        template<typename F>
+        void forEach(F f) const{
+            Pipe p = mPipe;
+            p.run([&f](auto&& e){
+                f(std::forward<decltype(e)>(e));
+                return true;
+            });
+        }
+
+        /**
+         * Réduction : renvoie op(...op(op(init, e0), e1)..., en-1)
+         */
+        template<typename U, typename Op>
+        U reduce(U init, Op op) const{
+            Pipe p = mPipe;
+            p.run([&init, &op](auto&& e){
+                init = op(std::move(init), std::forward<decltype(e)>(e));
+                return true;
+            });
+            return init;
+        }
+
+        /**
+         * Nombre d'éléments
+         */
+        int count() const{
+            int n = 0;
+            Pipe p = mPipe;
+            p.run([&n](auto&&){
+                n++;
+                return true;
+            });
+            return n;
+        }
+
+        /**
+         * Premier élément, vide s'il n'y en a pas (le parcours s'arrête au premier élément)
+         */
+        std::optional<T> findFirst() const{
+            std::optional<T> r;
+            Pipe p = mPipe;
+            p.run([&r](auto&& e){
+                r.emplace(std::forward<decltype(e)>(e));
+                return false;
+            });
+            return r;
+        }
+
+        /**
+         * Vrai si un élément vérifie pred (le parcours s'arrête au premier trouvé)
+         */
+        template<typename P>
+        bool anyMatch(P pred) const{
+            bool found = false;
+            Pipe p = mPipe;
+            p.run([&found, &pred](auto&& e){
+                found = pred(e);
+                return !found;
+            });
+            return found;
+        }
+
+        /**
+         * Vrai si tous les éléments vérifient pred (le parcours s'arrête au premier qui ne la vérifie pas)
+         */
+        template<typename P>
+        bool allMatch(P pred) const{
+            return !this->anyMatch([&pred](const T& e){ return !pred(e); });
+        }
+
+        /**
+         * Vector des éléments, dimensionné d'emblée lorsque leur nombre exact est connu
+         */
+        Vector<T> collect() const{
+            int n = mPipe.sizeHint();
+            Vector<T> v = n >= 0 ? Vector<T>(n) : Vector<T>();
+            Pipe p = mPipe;
+            p.run([&v](auto&& e){
+                v.append(std::forward<decltype(e)>(e));
+                return true;
+            });
+            return v;
+        }
+
+        /**
+         * Ajoute les éléments à la fin de out (n'importe quelle liste)
+         */
+        void collect(List<T>& out) const{
+            Pipe p = mPipe;
+            p.run([&out](auto&& e){
+                out.append(std::forward<decltype(e)>(e));
+                return true;
+            });
+        }
+};
+
+/**
+ * Stream des éléments de l (Vector, LinkedList, PersistentList, List<T>&...), parcourus avec les itérateurs de l
+ */
+template<typename L>
+auto stream(const L& l) -> Stream< typename std::decay<decltype(*l.begin())>::type, StreamRange<decltype(l.begin())> >{
+    typedef typename std::decay<decltype(*l.begin())>::type T;
+    typedef decltype(l.begin()) It;
+    return Stream< T, StreamRange<It> >(StreamRange<It>(l.begin(), l.end(), l.size()));
+}
+
+/**
+ * Stream des éléments de [first, last[
+ */
+template<typename It>
+Stream< typename std::iterator_traits<It>::value_type, StreamRange<It> > stream(It first, It last){
+    int n = -1;
+    if constexpr(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value)
+        n = (int)(last - first);
+    return Stream< typename std::iterator_traits<It>::value_type, StreamRange<It> >(StreamRange<It>(first, last, n));
+}
+
+#endif
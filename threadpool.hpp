@@ -0,0 +1,261 @@
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+/**
+ * Réserve de threads à vol de tâches ("work stealing") utilisée par les algorithmes parallèles (voir parallel.hpp).
+ *
+ * Chaque thread de la réserve possède sa propre file de tâches. Une tâche créée par un thread de la réserve va dans sa file ; il la reprend par la fin (la tâche la plus récente, dont les données sont encore en cache) tandis que les threads inoccupés volent les tâches des autres par le début (les plus anciennes, qui sont aussi les plus grosses dans un algorithme "diviser pour régner"). Les tâches soumises depuis un autre thread passent par une file commune. Un thread qui n'a plus rien à faire s'endort jusqu'à la prochaine soumission.
+ *
+ * Les tâches se lancent par groupes (TaskGroup) : le thread qui attend la fin d'un groupe ne reste pas bloqué, il exécute lui aussi des tâches en attendant. Une réserve de N threads fait donc travailler N + 1 coeurs, et une tâche peut elle-même lancer et attendre des sous-tâches sans risque d'interblocage.
+ *
+ * Compilation : -pthread.
+ */
+
+/**
+ * Tâche en attente d'exécution
+ */
+typedef std::function<void()> PoolTask;
+
+class ThreadPool
+{
+    private:
+        /**
+         * File de tâches d'un thread (protégée par un verrou : les tâches sont assez grosses pour que son coût soit négligeable)
+         */
+        struct TaskQueue{
+            std::mutex mutex;
+            std::deque<PoolTask> tasks;
+        };
+
+        int mThreads; //Nombre de threads de la réserve
+        std::thread* mWorkers;
+        TaskQueue* mQueues; //mThreads files propres, puis la file commune
+        std::atomic<int> mPending; //Nombre de tâches dans les files
+        std::atomic<bool> mStop;
+        std::mutex mSleepMutex;
+        std::condition_variable mWake;
+
+        /**
+         * Numéro du thread courant dans la réserve, -1 s'il n'en fait pas partie
+         */
+        int selfIndex() const{
+            return tlsPool() == this ? tlsIndex() : -1;
+        }
+
+        static const ThreadPool*& tlsPool(){
+            static thread_local const ThreadPool* pool = nullptr;
+            return pool;
+        }
+
+        static int& tlsIndex(){
+            static thread_local int index = -1;
+            return index;
+        }
+
+        /**
+         * Retire une tâche de la file q, par la fin (back == true) ou par le début
+         */
+        bool pop(TaskQueue& q, bool back, PoolTask& task){
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if(q.tasks.empty())
+                return false;
+            if(back){
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            }else{
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            mPending--;
+            return true;
+        }
+
+        /**
+         * Cherche une tâche pour le thread self (-1 hors de la réserve) : dans sa propre file, puis dans la file commune, puis chez les autres
+         */
+        bool findTask(int self, PoolTask& task){
+            if(mPending.load() == 0)
+                return false;
+            if(self >= 0 && this->pop(mQueues[self], true, task))
+                return true;
+            if(this->pop(mQueues[mThreads], false, task))
+                return true;
+            for(int k = 1; k <= mThreads; k++){
+                int victim = (self + k + mThreads) % mThreads;
+                if(victim != self && this->pop(mQueues[victim], false, task))
+                    return true;
+            }
+            return false;
+        }
+
+        void workerLoop(int index){
+            tlsPool() = this;
+            tlsIndex() = index;
+            PoolTask task;
+            for(;;){
+                if(this->findTask(index, task)){
+                    task();
+                    task = nullptr;
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(mSleepMutex);
+                mWake.wait(lock, [this]{ return mStop.load() || mPending.load() > 0; });
+                if(mStop.load() && mPending.load() == 0)
+                    return;
+            }
+        }
+
+    public:
+        /**
+         * Réserve de "threads" threads (0 est permis : tout s'exécute alors dans le thread qui attend)
+         */
+        explicit ThreadPool(int threads){
+            mThreads = threads > 0 ? threads : 0;
+            mPending = 0;
+            mStop = false;
+            mQueues = new TaskQueue[mThreads + 1];
+            mWorkers = new std::thread[mThreads];
+            for(int i = 0; i < mThreads; i++)
+                mWorkers[i] = std::thread(&ThreadPool::workerLoop, this, i);
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator= (const ThreadPool&) = delete;
+
+        /**
+         * Destructeur : les tâches déjà soumises sont exécutées avant l'arrêt des threads
+         */
+        ~ThreadPool(){
+            {
+                std::lock_guard<std::mutex> lock(mSleepMutex);
+                mStop = true;
+            }
+            mWake.notify_all();
+            for(int i = 0; i < mThreads; i++)
+                mWorkers[i].join();
+            delete[] mWorkers;
+            delete[] mQueues;
+        }
+
+        /**
+         * Réserve partagée par défaut, avec un thread de moins que de coeurs (le thread appelant travaille aussi)
+         */
+        static ThreadPool& global(){
+            static ThreadPool pool((int)std::thread::hardware_concurrency() - 1);
+            return pool;
+        }
+
+        int threads() const{
+            return mThreads;
+        }
+
+        /**
+         * Nombre de threads qui exécutent les tâches d'un groupe : ceux de la réserve plus celui qui attend
+         */
+        int parallelism() const{
+            return mThreads + 1;
+        }
+
+        /**
+         * Ajoute une tâche à la file du thread courant (ou à la file commune) et réveille un thread endormi
+         */
+        void submit(PoolTask task){
+            int self = this->selfIndex();
+            TaskQueue& q = mQueues[self >= 0 ? self : mThreads];
+            {
+                std::lock_guard<std::mutex> lock(q.mutex);
+                q.tasks.push_back(std::move(task));
+                mPending++;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mSleepMutex); //Sans ce verrou, un thread qui vient de trouver mPending nul pourrait s'endormir après la notification
+            }
+            mWake.notify_one();
+        }
+
+        /**
+         * Exécute une tâche en attente dans le thread courant, renvoie false s'il n'y en avait pas
+         */
+        bool runPendingTask(){
+            PoolTask task;
+            if(!this->findTask(this->selfIndex(), task))
+                return false;
+            task();
+            return true;
+        }
+};
+
+/**
+ * Groupe de tâches dont on attend la fin avec wait(). Si une tâche lance une exception, wait() relance la première après la fin de toutes les autres.
+ */
+class TaskGroup
+{
+    private:
+        ThreadPool& mPool;
+        std::atomic<int> mLeft; //Tâches lancées et pas encore terminées
+        std::mutex mErrorMutex;
+        std::exception_ptr mError;
+
+    public:
+        explicit TaskGroup(ThreadPool& pool = ThreadPool::global()) : mPool(pool){
+            mLeft = 0;
+        }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator= (const TaskGroup&) = delete;
+
+        ~TaskGroup(){
+            while(mLeft.load() > 0){
+                if(!mPool.runPendingTask())
+                    std::this_thread::yield();
+            }
+        }
+
+        ThreadPool& pool(){
+            return mPool;
+        }
+
+        /**
+         * Lance f() dans la réserve
+         */
+        template<typename F>
+        void run(F f){
+            mLeft++;
+            mPool.submit([this, f]() mutable{
+                try{
+                    f();
+                }catch(...){
+                    std::lock_guard<std::mutex> lock(mErrorMutex);
+                    if(!mError)
+                        mError = std::current_exception();
+                }
+                mLeft--;
+            });
+        }
+
+        /**
+         * Attend la fin de toutes les tâches du groupe en exécutant des tâches en attente
+         */
+        void wait(){
+            while(mLeft.load() > 0){
+                if(!mPool.runPendingTask())
+                    std::this_thread::yield();
+            }
+            if(mError){
+                std::exception_ptr e = mError;
+                mError = nullptr;
+                std::rethrow_exception(e);
+            }
+        }
+};
+
+#endif
@@ -0,0 +1,537 @@
+#ifndef _UNROLLEDLIST_H_
+#define _UNROLLEDLIST_H_
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "list.hpp"
+#include "listbase.hpp"
+#include "simdsearch.hpp"
+
+/**
+ * Liste chaînée "déroulée" : chaque noeud contient non pas un mais un petit tableau d'éléments (de taille fixe, de l'ordre d'une ou deux lignes de cache). On garde l'intérêt de la LinkedList (insertion et suppression au milieu sans décaler toute la liste) tout en divisant par la capacité d'un noeud le nombre de pointeurs à suivre lors d'un parcours, et donc le nombre de défauts de cache.
+ *
+ * Un noeud plein est coupé en deux lors d'une insertion ; un noeud rempli à moins de la moitié est fusionné avec son successeur lors d'une suppression (si le tout tient dans un noeud), de sorte que les noeuds restent en moyenne au moins à moitié pleins.
+ */
+
+/**
+ * Taille visée (en octets) d'un noeud de UnrolledList, en-tête compris
+ */
+#ifndef UNROLLED_NODE_BYTES
+#define UNROLLED_NODE_BYTES 128
+#endif
+
+template<typename T>
+struct UnrolledNode{
+    static constexpr int FITTING = (int)((UNROLLED_NODE_BYTES - sizeof(void*) - sizeof(int)) / sizeof(T));
+    static constexpr int CAPACITY = FITTING > 4 ? FITTING : 4; //Au moins 4 éléments par noeud, même pour de gros éléments
+
+    UnrolledNode* next;
+    int count; //Nombre d'éléments construits dans elts (ce sont les count premiers)
+    alignas(T) unsigned char storage[CAPACITY*sizeof(T)];
+
+    UnrolledNode(){
+        next = nullptr;
+        count = 0;
+    }
+
+    T* elts(){
+        return reinterpret_cast<T*>(storage);
+    }
+
+    const T* elts() const{
+        return reinterpret_cast<const T*>(storage);
+    }
+
+    /**
+     * Insère e en position i du noeud (qui ne doit pas être plein)
+     */
+    void insert(int i, T e){
+        T* t = this->elts();
+        for(int k = count; k > i; k--){
+            ::new(static_cast<void*>(t + k)) T(std::move(t[k-1]));
+            t[k-1].~T();
+        }
+        ::new(static_cast<void*>(t + i)) T(std::move(e));
+        count++;
+    }
+
+    /**
+     * Supprime l'élément en position i du noeud
+     */
+    void erase(int i){
+        T* t = this->elts();
+        t[i].~T();
+        for(int k = i; k < count-1; k++){
+            ::new(static_cast<void*>(t + k)) T(std::move(t[k+1]));
+            t[k+1].~T();
+        }
+        count--;
+    }
+
+    /**
+     * Déplace les éléments [from, count[ à la fin du noeud dst
+     */
+    void moveTail(int from, UnrolledNode* dst){
+        T* t = this->elts();
+        T* d = dst->elts();
+        for(int k = from; k < count; k++){
+            ::new(static_cast<void*>(d + dst->count)) T(std::move(t[k]));
+            t[k].~T();
+            dst->count++;
+        }
+        count = from;
+    }
+
+    void clear(){
+        T* t = this->elts();
+        for(int k = 0; k < count; k++)
+            t[k].~T();
+        count = 0;
+    }
+};
+
+/**
+ * Itérateur externe sur une UnrolledList (V vaut T ou const T) : noeud courant et indice dans ce noeud
+ */
+template<typename T, typename V>
+class UnrolledListIterator
+{
+    private:
+        UnrolledNode<T>* mNode;
+        int mIdx;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V* pointer;
+        typedef V& reference;
+
+        explicit UnrolledListIterator(UnrolledNode<T>* n = nullptr){
+            mNode = n;
+            mIdx = 0;
+        }
+
+        template<typename W>
+        UnrolledListIterator(const UnrolledListIterator<T, W>& o){
+            mNode = o.mNode;
+            mIdx = o.mIdx;
+        }
+
+        V& operator* () const{
+            return mNode->elts()[mIdx];
+        }
+
+        V* operator-> () const{
+            return mNode->elts() + mIdx;
+        }
+
+        UnrolledListIterator& operator++ (){
+            mIdx++;
+            if(mIdx == mNode->count){
+                mNode = mNode->next;
+                mIdx = 0;
+            }
+            return *this;
+        }
+
+        UnrolledListIterator operator++ (int){
+            UnrolledListIterator ret = *this;
+            ++(*this);
+            return ret;
+        }
+
+        bool operator== (const UnrolledListIterator& o) const{
+            return mNode == o.mNode && mIdx == o.mIdx;
+        }
+
+        bool operator!= (const UnrolledListIterator& o) const{
+            return !(*this == o);
+        }
+
+        template<typename U, typename W>
+        friend class UnrolledListIterator;
+};
+
+template<typename T>
+class UnrolledList : public List<T>, public ListBase<UnrolledList<T>, T>
+{
+    private:
+        typedef UnrolledNode<T> Node;
+
+        Node* mFirst;
+        Node* mLast;
+        int mSize; //Nombre total d'éléments
+        mutable Node* mCursNode; //Itérateur : noeud courant...
+        mutable int mCursIdx; //... et indice du prochain élément à renvoyer dans ce noeud
+
+        static void chunkAt(ListChunk<T>& c, Node* n){
+            c.node = n;
+            c.begin = n == nullptr ? nullptr : n->elts();
+            c.end = n == nullptr ? nullptr : n->elts() + n->count;
+        }
+
+        /**
+         * Trouve le noeud contenant le i-ème élément (0 <= i < mSize), i devient l'indice de l'élément dans ce noeud. Le parcours saute un noeud entier à chaque pas.
+         */
+        Node* locate(int& i) const{
+            Node* n = mFirst;
+            while(i >= n->count){
+                LIST_STAT(TRAVERSAL_STEPS, 1);
+                i -= n->count;
+                n = n->next;
+            }
+            return n;
+        }
+
+        /**
+         * Coupe le noeud plein n en deux : la seconde moitié de ses éléments part dans un nouveau noeud inséré juste après lui.
+         */
+        Node* split(Node* n){
+            Node* m = new Node();
+            LIST_STAT(NODE_ALLOCATIONS, 1);
+            LIST_STAT(MOVES, n->count - n->count/2);
+            int half = n->count/2;
+            n->moveTail(half, m);
+            if(mCursNode == n && mCursIdx >= half){ //Le prochain élément du curseur est parti dans m
+                mCursNode = m;
+                mCursIdx -= half;
+            }
+            m->next = n->next;
+            n->next = m;
+            if(mLast == n)
+                mLast = m;
+            return m;
+        }
+
+        /**
+         * Retire le noeud n (vide) de la chaîne, prev étant son prédécesseur (ou nullptr)
+         */
+        void unlink(Node* prev, Node* n){
+            if(mCursNode == n){
+                mCursNode = n->next;
+                mCursIdx = 0;
+            }
+            if(prev == nullptr)
+                mFirst = n->next;
+            else
+                prev->next = n->next;
+            if(mLast == n)
+                mLast = prev;
+            delete n;
+            LIST_STAT(NODE_FREES, 1);
+        }
+
+        /**
+         * Supprime l'élément k du noeud n. Le curseur de first()/next() continue de désigner le même prochain élément : on le recule si l'élément supprimé le précédait dans n, on le passe au noeud suivant s'il arrive en fin de noeud.
+         */
+        void eraseAt(Node* n, int k){
+            LIST_STAT(MOVES, n->count - 1 - k);
+            LIST_STAT(BYTES_SHIFTED, (n->count - 1 - k)*sizeof(T));
+            n->erase(k);
+            mSize--;
+            if(mCursNode == n){
+                if(k < mCursIdx)
+                    mCursIdx--;
+                if(mCursIdx == n->count){
+                    mCursNode = n->next;
+                    mCursIdx = 0;
+                }
+            }
+        }
+
+        /**
+         * Rééquilibrage après une suppression dans le noeud n : un noeud vide est retiré, un noeud moins qu'à moitié plein absorbe son successeur si le tout tient dans un seul noeud.
+         */
+        void rebalance(Node* prev, Node* n){
+            if(n->count == 0){
+                this->unlink(prev, n);
+                return;
+            }
+            Node* m = n->next;
+            if(n->count < Node::CAPACITY/2 && m != nullptr && n->count + m->count <= Node::CAPACITY){
+                LIST_STAT(MOVES, m->count);
+                if(mCursNode == m){
+                    mCursNode = n;
+                    mCursIdx += n->count;
+                }
+                m->moveTail(0, n);
+                this->unlink(n, m);
+            }
+        }
+
+        void release(){
+            Node* n = mFirst;
+            while(n != nullptr){
+                Node* next = n->next;
+                n->clear();
+                delete n;
+                LIST_STAT(NODE_FREES, 1);
+                n = next;
+            }
+            mFirst = nullptr;
+            mLast = nullptr;
+            mSize = 0;
+        }
+
+    public:
+        /**
+         * Nombre maximal d'éléments par noeud
+         */
+        static constexpr int NODE_CAPACITY = Node::CAPACITY;
+
+        typedef UnrolledListIterator<T, T> iterator;
+        typedef UnrolledListIterator<T, const T> const_iterator;
+
+        UnrolledList(){
+            mFirst = nullptr;
+            mLast = nullptr;
+            mSize = 0;
+            mCursNode = nullptr;
+            mCursIdx = 0;
+        }
+
+        UnrolledList(const UnrolledList<T>& o){
+            mFirst = nullptr;
+            mLast = nullptr;
+            mSize = 0;
+            mCursNode = nullptr;
+            mCursIdx = 0;
+            LIST_STAT(COPIES, o.mSize);
+            for(Node* n = o.mFirst; n != nullptr; n = n->next){
+                for(int k = 0; k < n->count; k++)
+                    this->append(n->elts()[k]);
+            }
+        }
+
+        UnrolledList(UnrolledList<T>&& o) noexcept{
+            mFirst = o.mFirst;
+            mLast = o.mLast;
+            mSize = o.mSize;
+            mCursNode = nullptr;
+            mCursIdx = 0;
+            o.mFirst = nullptr;
+            o.mLast = nullptr;
+            o.mSize = 0;
+        }
+
+        UnrolledList<T>& operator= (UnrolledList<T> o){
+            std::swap(mFirst, o.mFirst);
+            std::swap(mLast, o.mLast);
+            std::swap(mSize, o.mSize);
+            mCursNode = nullptr;
+            return *this;
+        }
+
+        ~UnrolledList(){
+            this->release();
+        }
+
+        int size() const{
+            return this->mSize;
+        }
+
+        iterator begin(){
+            return iterator(this->mFirst);
+        }
+
+        iterator end(){
+            return iterator();
+        }
+
+        const_iterator begin() const{
+            return const_iterator(this->mFirst);
+        }
+
+        const_iterator end() const{
+            return const_iterator();
+        }
+
+        /**
+         * Chaque noeud forme un bloc contigu (les noeuds ne sont jamais vides)
+         */
+        void firstChunk(ListChunk<T>& c) const{
+            chunkAt(c, this->mFirst);
+        }
+
+        void nextChunk(ListChunk<T>& c) const{
+            chunkAt(c, static_cast<const Node*>(c.node)->next);
+        }
+
+        /**
+         * Ajout en fin de liste : le dernier noeud est rempli complètement avant d'en créer un nouveau
+         */
+        void append(T e){
+            if(mLast == nullptr){
+                mFirst = mLast = new Node();
+                LIST_STAT(NODE_ALLOCATIONS, 1);
+            }else if(mLast->count == Node::CAPACITY){
+                mLast->next = new Node();
+                mLast = mLast->next;
+                LIST_STAT(NODE_ALLOCATIONS, 1);
+            }
+            ::new(static_cast<void*>(mLast->elts() + mLast->count)) T(std::move(e));
+            mLast->count++;
+            mSize++;
+        }
+
+        void prepend(T e){
+            if(mFirst == nullptr || mFirst->count == Node::CAPACITY){
+                Node* n = new Node();
+                LIST_STAT(NODE_ALLOCATIONS, 1);
+                n->next = mFirst;
+                mFirst = n;
+                if(mLast == nullptr)
+                    mLast = n;
+            }
+            LIST_STAT(MOVES, mFirst->count);
+            LIST_STAT(BYTES_SHIFTED, mFirst->count*sizeof(T));
+            mFirst->insert(0, std::move(e));
+            if(mCursNode == mFirst)
+                mCursIdx++; //Le curseur garde le même prochain élément
+            mSize++;
+        }
+
+        /**
+         * Insère e de sorte qu'il devienne le i-ème élément de la liste (0 <= i <= size()). Seuls les éléments du noeud concerné sont décalés ; un noeud plein est d'abord coupé en deux.
+         */
+        void insert(int i, T e){
+            if(i < 0 || mSize < i)
+                throw IndexOutOfBoundsException();
+
+            if(i == mSize){
+                this->append(std::move(e));
+                return;
+            }
+
+            Node* n = this->locate(i);
+            if(n->count == Node::CAPACITY){
+                Node* m = this->split(n);
+                if(i > n->count){
+                    i -= n->count;
+                    n = m;
+                }
+            }
+            LIST_STAT(MOVES, n->count - i);
+            LIST_STAT(BYTES_SHIFTED, (n->count - i)*sizeof(T));
+            n->insert(i, std::move(e));
+            if(mCursNode == n && i <= mCursIdx)
+                mCursIdx++; //Le curseur garde le même prochain élément
+            mSize++;
+        }
+
+        /**
+         * Supprime le i-ème élément de la liste
+         */
+        void removeAt(int i){
+            if(this->mSize == 0)
+                throw EmptyContainerException();
+
+            if(i < 0 || mSize <= i)
+                throw IndexOutOfBoundsException();
+
+            Node* prev = nullptr;
+            Node* n = mFirst;
+            while(i >= n->count){
+                LIST_STAT(TRAVERSAL_STEPS, 1);
+                i -= n->count;
+                prev = n;
+                n = n->next;
+            }
+            this->eraseAt(n, i);
+            this->rebalance(prev, n);
+        }
+
+        T operator[] (int i) const{
+            listCheckIndex(i, this->mSize);
+
+            Node* n = this->locate(i);
+            return n->elts()[i];
+        }
+
+        T& operator[] (int i){
+            listCheckIndex(i, this->mSize);
+
+            Node* n = this->locate(i);
+            return n->elts()[i];
+        }
+
+        bool hasNext() const{
+            return this->mCursNode != nullptr;
+        }
+
+        T next() const{
+            if(this->mCursNode != nullptr){
+                T ret = mCursNode->elts()[mCursIdx];
+                mCursIdx++;
+                if(mCursIdx == mCursNode->count){
+                    mCursNode = mCursNode->next;
+                    mCursIdx = 0;
+                }
+                return ret;
+            }
+
+            if(this->mSize == 0)
+                throw EmptyContainerException();
+
+            throw IndexOutOfBoundsException();
+        }
+
+        T first() const{
+            if(this->mSize == 0)
+                throw EmptyContainerException();
+
+            mCursNode = mFirst;
+            mCursIdx = 0;
+            return mFirst->elts()[0];
+        }
+
+        T last() const{
+            if(this->mSize == 0)
+                throw EmptyContainerException();
+
+            return mLast->elts()[mLast->count-1];
+        }
+
+        /**
+         * Recherche noeud par noeud (vectorisée pour les types arithmétiques)
+         */
+        int indexOf(const T& t) const{
+            int base = 0;
+            for(Node* n = mFirst; n != nullptr; n = n->next){
+                LIST_STAT(TRAVERSAL_STEPS, 1);
+                int i = arrayIndexOf(n->elts(), n->count, t);
+                if(i != -1)
+                    return base + i;
+                base += n->count;
+            }
+            return -1;
+        }
+
+        /**
+         * Supprime la première occurrence de e
+         */
+        void remove(T e){
+            Node* prev = nullptr;
+            for(Node* n = mFirst; n != nullptr; n = n->next){
+                LIST_STAT(TRAVERSAL_STEPS, 1);
+                T* t = n->elts();
+                for(int k = 0; k < n->count; k++){
+                    if(t[k] == e){
+                        this->eraseAt(n, k);
+                        this->rebalance(prev, n);
+                        return;
+                    }
+                }
+                prev = n;
+            }
+
+            throw ElementNotFoundException<T>(e);
+        }
+
+};
+
+#endif
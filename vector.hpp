@@ -1,94 +1,379 @@
 #ifndef _VECTOR_H_
 #define _VECTOR_H_
 
-#include "list.hpp"
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
-#ifndef nullptr
-#define nullptr 0
-#endif
+#include "list.hpp"
+#include "listbase.hpp"
+#include "simdsearch.hpp"
 
 
 /**
- * La variable de préprocesseur LIST_CLUSTER_SIZE définie le nombre de case dont on va augmenter le tableau contenant les éléments lorsque la taille de de celui-ci ne suffit plus. Cela permet d'éviter, lorsqu'on rajoute 5 éléments, d'avoir à détruire puis à recréer le tableau de données 5 fois. Cette valeur est purement arbitraire et, pour un Vecteur dans lequel on ajoute souvent des données, il est conseillé d'augmenter cette valeur.
+ * La variable de préprocesseur LIST_CLUSTER_SIZE définit la capacité initiale d'un Vecteur ainsi que le nombre minimal de cases dont on augmente le tableau lorsque celui-ci est plein.
  */
 #ifndef LIST_CLUSTER_SIZE
 #define LIST_CLUSTER_SIZE 10
 #endif
 
+/**
+ * Facteur de croissance géométrique par défaut du tableau : lorsqu'il est plein, sa capacité est multipliée par VECTOR_GROWTH_FACTOR. Grâce à cette croissance géométrique, N ajouts en fin de tableau ne coûtent que O(N) déplacements au total (O(1) amorti par ajout). 1.5 permet de réutiliser les blocs mémoire libérés, 2 fait moins de réallocations. Un facteur inférieur ou égal à 1 restaure l'ancienne croissance arithmétique (LIST_CLUSTER_SIZE cases de plus à chaque fois).
+ */
+#ifndef VECTOR_GROWTH_FACTOR
+#define VECTOR_GROWTH_FACTOR 1.5f
+#endif
+
 template<typename T>
-class Vector : public List<T>
+class Vector : public List<T>, public ListBase<Vector<T>, T>
 {
     private:
-        int mSize; //Taille du tableau mTab (est supérieur ou égal au nombre d'éléments que nous avons mis dans la collection
+        int mSize; //Capacité du tableau mTab (est supérieur ou égal au nombre d'éléments que nous avons mis dans la collection)
         mutable int mCursor; //Itérateur sur le tableau
         int mFilled; //Nombre d'éléments réellement présents dans le tableau (mFilled <= mSize)
-        T* mTab;
+        float mGrowth; //Facteur de croissance du tableau (voir VECTOR_GROWTH_FACTOR)
+        T* mTab; //Mémoire brute : seules les cases [0, mFilled[ contiennent des objets construits, les autres ne sont jamais initialisées
 
         /**
-         * Méthode permettant d'étendre le tableau mTab de n case + le nombre de cases restantes de sorte à ce que la taille du nouveau tableau reste une multiple de LIST_CLUSTER_SIZE
+         * Allocation et libération de mémoire brute (aucun constructeur ni destructeur de T n'est appelé).
          */
-        void extendTab(int n){
-            int fact = n/LIST_CLUSTER_SIZE + 1;
-            T* oldTab = this->mTab;
-            
-            //Création du tableau étendu
-            mTab = new T[mSize + fact*LIST_CLUSTER_SIZE];
-            mSize = mSize + fact*LIST_CLUSTER_SIZE;
+        static T* allocate(int n){
+            if(n <= 0)
+                return nullptr;
+            return std::allocator<T>().allocate(n);
+        }
 
+        static void deallocate(T* p, int n){
+            if(p != nullptr)
+                std::allocator<T>().deallocate(p, n);
+        }
 
-            //Copie des éléments un à un
-            for(int i = 0; i < mFilled; i++){
-                mTab[i] = oldTab[i];
+        /**
+         * Déplace n éléments de src vers la zone brute dst (les deux zones ne doivent pas se chevaucher). Les éléments de src sont détruits : cette zone redevient de la mémoire brute. Pour un type trivialement copiable, un simple memcpy suffit.
+         */
+        static void relocate(T* dst, T* src, int n){
+            if(std::is_trivially_copyable<T>::value){
+                if(n > 0)
+                    std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n*sizeof(T));
+                return;
+            }
+            for(int i = 0; i < n; i++){
+                ::new(static_cast<void*>(dst + i)) T(std::move(src[i]));
+                src[i].~T();
             }
+        }
 
-            //Suppression de l'ancien tableau
-            delete[] oldTab;
+        /**
+         * Remplace mTab par un tableau de capacité "capacity" (>= mFilled) dans lequel on déplace les éléments existants.
+         */
+        void reallocate(int capacity){
+            LIST_STAT(REALLOCATIONS, 1);
+            LIST_STAT(MOVES, mFilled);
+            T* nTab = allocate(capacity);
+            relocate(nTab, mTab, mFilled);
+            deallocate(mTab, mSize);
+            mTab = nTab;
+            mSize = capacity;
+        }
+
+        /**
+         * Méthode permettant d'étendre le tableau mTab de sorte qu'il puisse accueillir au moins n éléments de plus. La capacité est multipliée par mGrowth, sauf si cela ne suffit pas pour les n nouveaux éléments.
+         */
+        void extendTab(int n){
+            int nSize;
+            if(mGrowth > 1)
+                nSize = (int)(mSize * mGrowth);
+            else
+                nSize = mSize + (n/LIST_CLUSTER_SIZE + 1)*LIST_CLUSTER_SIZE;
+
+            if(nSize < mSize + LIST_CLUSTER_SIZE)
+                nSize = mSize + LIST_CLUSTER_SIZE;
+            if(nSize < mFilled + n)
+                nSize = mFilled + n;
+
+            this->reallocate(nSize);
         }
 
 
         /**
-         * Décale le tableau vers l'avant à partir de l'élément d de n cases (utile pour la méthode prepend)
+         * Décale le tableau vers l'avant à partir de l'élément d de n cases (utile pour la méthode prepend). Les cases [d, d+n[ sont laissées à l'état de mémoire brute, à l'appelant d'y construire les nouveaux éléments et de mettre mFilled à jour.
          */
         void offset(int d, int n){
-            T tmp, ttmp;
             //On agrandit le tableau autant que nécessaire
-            if(n + mFilled >= mSize)
+            if(n + mFilled > mSize)
                 this->extendTab(n);
+            LIST_STAT(MOVES, mFilled - d);
+            LIST_STAT(BYTES_SHIFTED, (mFilled - d)*sizeof(T));
 
-            //Et on décale comme des gros autistes
-            for(int i = mFilled; i >= d; i--){
-                mTab[i-1+n] = mTab[i-1];
+            if(std::is_trivially_copyable<T>::value){
+                std::memmove(static_cast<void*>(mTab + d + n), static_cast<const void*>(mTab + d), (mFilled - d)*sizeof(T));
+                return;
+            }
+
+            for(int i = mFilled - 1; i >= d; i--){
+                ::new(static_cast<void*>(mTab + i + n)) T(std::move(mTab[i]));
+                mTab[i].~T();
             }
         }
 
         /**
-         * Décale le tableau de n cases vers l'arrière de la fin jusque à l'élément d inclus (utile pour la méthode remove)
+         * Détruit les éléments [d, d+n[ et décale de n cases vers l'arrière le reste du tableau (utile pour la méthode remove). À l'appelant de mettre mFilled à jour.
          */
         void backOffset(int d, int n){
-            for(int i = d; i <= this->mFilled-n-1; i++){
-                mTab[i] = mTab[i+n];
+            for(int i = d; i < d + n; i++)
+                mTab[i].~T();
+            LIST_STAT(MOVES, mFilled - d - n);
+            LIST_STAT(BYTES_SHIFTED, (mFilled - d - n)*sizeof(T));
+
+            if(std::is_trivially_copyable<T>::value){
+                std::memmove(static_cast<void*>(mTab + d), static_cast<const void*>(mTab + d + n), (mFilled - d - n)*sizeof(T));
+                return;
+            }
+
+            for(int i = d; i < mFilled - n; i++){
+                ::new(static_cast<void*>(mTab + i)) T(std::move(mTab[i + n]));
+                mTab[i + n].~T();
+            }
+        }
+
+        /**
+         * Construit en fin de tableau des copies des n éléments de p (la place doit avoir été réservée)
+         */
+        void copyBlock(const T* p, int n){
+            LIST_STAT(COPIES, n);
+            if(std::is_trivially_copyable<T>::value){
+                if(n > 0)
+                    std::memcpy(static_cast<void*>(mTab + mFilled), static_cast<const void*>(p), n*sizeof(T));
+                mFilled += n;
+                return;
+            }
+            for(int k = 0; k < n; k++, mFilled++)
+                ::new(static_cast<void*>(mTab + mFilled)) T(p[k]);
+        }
+
+        /**
+         * Insère devant le i-ème élément les n éléments qui commencent à first : la fin du tableau est décalée une seule fois. Si la construction d'un élément échoue, ceux déjà construits sont détruits et la fin est remise en place.
+         */
+        template<typename It>
+        void insertN(int i, It first, int n){
+            if(n <= 0)
+                return;
+            this->offset(i, n);
+            int done = 0;
+            try{
+                for(; done < n; done++, ++first)
+                    ::new(static_cast<void*>(mTab + i + done)) T(*first);
+            }catch(...){
+                for(int k = 0; k < done; k++)
+                    mTab[i + k].~T();
+                for(int k = i; k < mFilled; k++){
+                    ::new(static_cast<void*>(mTab + k)) T(std::move(mTab[k + n]));
+                    mTab[k + n].~T();
+                }
+                throw;
             }
+            LIST_STAT(COPIES, n);
+            mFilled += n;
+        }
+
+        /**
+         * Détruit les éléments [n, mFilled[
+         */
+        void truncate(int n){
+            for(; mFilled > n; mFilled--)
+                mTab[mFilled - 1].~T();
+        }
+
+        /**
+         * Détruit tous les éléments et libère le tableau.
+         */
+        void release(){
+            if(!std::is_trivially_destructible<T>::value){
+                for(int i = 0; i < mFilled; i++)
+                    mTab[i].~T();
+            }
+            deallocate(mTab, mSize);
+            mTab = nullptr;
+            mSize = 0;
+            mFilled = 0;
         }
 
 
     public:
+        typedef T* iterator;
+        typedef const T* const_iterator;
 
         /**
-         * Constructeur par défaut (on met la taille de mTab à LIST_CLUSTER_SIZE, il y'a peu de chance qu'on crée un Vecteur pour ne rien y insérer...
+         * Constructeur par défaut (on met la taille de mTab à LIST_CLUSTER_SIZE, il y'a peu de chance qu'on crée un Vecteur pour ne rien y insérer...). La mémoire est réservée mais aucun élément n'est construit.
          */
         Vector(){
             mCursor = -1;
             mSize = LIST_CLUSTER_SIZE;
             mFilled = 0;
-            mTab = new T[LIST_CLUSTER_SIZE];
+            mGrowth = VECTOR_GROWTH_FACTOR;
+            mTab = allocate(LIST_CLUSTER_SIZE);
+        }
+
+        /**
+         * Constructeur réservant directement de la place pour "capacity" éléments, avec un facteur de croissance éventuellement différent de VECTOR_GROWTH_FACTOR.
+         */
+        explicit Vector(int capacity, float growth = VECTOR_GROWTH_FACTOR){
+            mCursor = -1;
+            mSize = capacity > 0 ? capacity : 0;
+            mFilled = 0;
+            mGrowth = growth;
+            mTab = allocate(mSize);
+        }
+
+        /**
+         * Constructeur de copie : le nouveau tableau est dimensionné au plus juste.
+         */
+        Vector(const Vector<T>& o){
+            mCursor = -1;
+            mSize = o.mFilled;
+            mFilled = 0;
+            mGrowth = o.mGrowth;
+            mTab = allocate(mSize);
+            LIST_STAT(COPIES, o.mFilled);
+            for(; mFilled < o.mFilled; mFilled++)
+                ::new(static_cast<void*>(mTab + mFilled)) T(o.mTab[mFilled]);
+        }
+
+        /**
+         * Constructeur par déplacement : on récupère simplement le tableau de o.
+         */
+        Vector(Vector<T>&& o) noexcept{
+            mCursor = -1;
+            mSize = o.mSize;
+            mFilled = o.mFilled;
+            mGrowth = o.mGrowth;
+            mTab = o.mTab;
+            o.mTab = nullptr;
+            o.mSize = 0;
+            o.mFilled = 0;
+        }
+
+        Vector<T>& operator= (Vector<T> o){
+            std::swap(mSize, o.mSize);
+            std::swap(mFilled, o.mFilled);
+            std::swap(mGrowth, o.mGrowth);
+            std::swap(mTab, o.mTab);
+            mCursor = -1;
+            return *this;
         }
 
         /**
          * Destructeur libérant les ressources allouées à l'instance de Vector<T>
          */
         ~Vector(){
-            if(mTab != nullptr)
-                delete[] mTab;
+            this->release();
+        }
+
+        /**
+         * Nombre d'éléments présents dans le Vecteur
+         */
+        int size() const{
+            return this->mFilled;
+        }
+
+        /**
+         * Nombre d'éléments que le Vecteur peut contenir sans réallocation
+         */
+        int capacity() const{
+            return this->mSize;
+        }
+
+        float growthFactor() const{
+            return this->mGrowth;
+        }
+
+        void setGrowthFactor(float growth){
+            this->mGrowth = growth;
+        }
+
+        /**
+         * Garantit que le Vecteur peut contenir n éléments sans réallocation (à utiliser lorsqu'on connait à l'avance le nombre d'éléments à insérer).
+         */
+        void reserve(int n){
+            if(n > mSize)
+                this->reallocate(n);
+        }
+
+        /**
+         * Ramène la capacité du tableau au nombre d'éléments effectivement présents.
+         */
+        void shrinkToFit(){
+            if(mFilled < mSize)
+                this->reallocate(mFilled);
+        }
+
+        /**
+         * Fixe le nombre d'éléments à n : les éléments en trop sont détruits, les éléments manquants sont des copies de value (ajoutés en fin de tableau).
+         */
+        void resize(int n, const T& value = T()){
+            if(n < 0)
+                n = 0;
+            if(n > mFilled)
+                LIST_STAT(COPIES, n - mFilled);
+            if(n > mSize){
+                T v(value); //value peut être un élément du tableau qu'on va réallouer
+                this->reallocate(n);
+                for(; mFilled < n; mFilled++)
+                    ::new(static_cast<void*>(mTab + mFilled)) T(v);
+            }
+            for(; mFilled < n; mFilled++)
+                ::new(static_cast<void*>(mTab + mFilled)) T(value);
+            for(; mFilled > n; mFilled--)
+                mTab[mFilled - 1].~T();
+        }
+
+        /**
+         * Accès direct au tableau des éléments (valide jusqu'à la prochaine modification du Vecteur)
+         */
+        T* data(){
+            return this->mTab;
+        }
+
+        const T* data() const{
+            return this->mTab;
+        }
+
+        /**
+         * Itérateurs externes : de simples pointeurs sur le tableau
+         */
+        iterator begin(){
+            return this->mTab;
+        }
+
+        iterator end(){
+            return this->mTab + this->mFilled;
+        }
+
+        const_iterator begin() const{
+            return this->mTab;
+        }
+
+        const_iterator end() const{
+            return this->mTab + this->mFilled;
+        }
+
+        /**
+         * Le Vecteur entier forme un seul bloc contigu
+         */
+        void firstChunk(ListChunk<T>& c) const{
+            c.begin = this->mFilled == 0 ? nullptr : this->mTab;
+            c.end = this->mFilled == 0 ? nullptr : this->mTab + this->mFilled;
+            c.node = nullptr;
+            c.index = 0;
+        }
+
+        void nextChunk(ListChunk<T>& c) const{
+            c.begin = nullptr;
+            c.end = nullptr;
         }
 
         void append(T e){
@@ -96,40 +381,28 @@ class Vector : public List<T>
             if(mFilled == mSize)
                 this->extendTab(1);
 
-            mTab[mFilled] = e;
+            ::new(static_cast<void*>(mTab + mFilled)) T(std::move(e));
 
             mFilled++;
         }
 
         void prepend(T e){
-            //Si nécessaire on augmente la taille du tableau
-            if(mFilled == mSize)
-                this->extendTab(1);
-
-            //On décale tous les éléments du tableau
+            //On décale tous les éléments du tableau (le tableau est agrandi si nécessaire)
             this->offset(0, 1);
 
             //On met le nouveau à l'index 0
-            this->mTab[0] = e;
+            ::new(static_cast<void*>(mTab)) T(std::move(e));
             mFilled++;
         }
 
         T operator[] (int i) const{
-            if(this->mFilled == 0)
-                throw EmptyContainerException();
-
-            if(i < 0 || this->mFilled <= i)
-                throw IndexOutOfBoundsException();
+            listCheckIndex(i, this->mFilled);
 
             return this->mTab[i];
         }
 
         T& operator[] (int i){
-            if(this->mFilled == 0)
-                throw EmptyContainerException();
-
-            if(i < 0 || this->mFilled <= i)
-                throw IndexOutOfBoundsException();
+            listCheckIndex(i, this->mFilled);
 
             return this->mTab[i];
         }
@@ -143,7 +416,7 @@ class Vector : public List<T>
                 mCursor++;
                 return this->mTab[this->mCursor];
             }
-            
+
             if(this->mFilled == 0)
                 throw EmptyContainerException();
 
@@ -156,7 +429,7 @@ class Vector : public List<T>
 
             mCursor = -1;
             return this->mTab[mCursor+1];
-        }        
+        }
 
         T last() const{
             if(this->mFilled == 0)
@@ -166,12 +439,215 @@ class Vector : public List<T>
             return this->mTab[this->mFilled-1];
         }
 
+        /**
+         * Recherches dans le tableau : vectorisées (SSE2/AVX2) pour les types arithmétiques, voir simdsearch.hpp. pos() et remove() passent par indexOf().
+         */
+        int indexOf(const T& t) const{
+            return arrayIndexOf(this->mTab, this->mFilled, t);
+        }
+
+        int lastIndexOf(const T& t) const{
+            return arrayLastIndexOf(this->mTab, this->mFilled, t);
+        }
+
+        int count(const T& t) const{
+            return arrayCount(this->mTab, this->mFilled, t);
+        }
+
+        bool contains(const T& t) const{
+            return this->indexOf(t) != -1;
+        }
+
         void remove(T e){
             int i = this->pos(e);
             this->backOffset(i, 1);
             mFilled--;
         }
-        
+
+        /**
+         * Supprime le i-ème élément du Vecteur
+         */
+        void removeAt(int i){
+            if(this->mFilled == 0)
+                throw EmptyContainerException();
+
+            if(i < 0 || this->mFilled <= i)
+                throw IndexOutOfBoundsException();
+
+            this->backOffset(i, 1);
+            mFilled--;
+        }
+
+        /**
+         * Ajout de tous les éléments de o (qui peut être ce Vecteur) : une seule réservation, puis une copie par bloc contigu de o (un memcpy pour un type trivialement copiable)
+         */
+        void appendAll(const List<T>& o){
+            int n = o.size();
+            if(mFilled + n > mSize)
+                this->extendTab(n);
+            ListChunk<T> c;
+            for(o.firstChunk(c); c.begin != nullptr; o.nextChunk(c)) //La place est réservée avant de lire o : si o est ce Vecteur, son bloc reste valide
+                this->copyBlock(c.begin, (int)(c.end - c.begin));
+        }
+
+        /**
+         * Ajout des éléments de [first, last[ : une seule réservation si l'on peut compter les éléments à l'avance (itérateurs "forward"), un memcpy si ce sont des pointeurs sur des T trivialement copiables. L'intervalle ne doit pas porter sur ce Vecteur.
+         */
+        template<typename It>
+        void appendAll(It first, It last){
+            if constexpr(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value){
+                int n = (int)std::distance(first, last);
+                if(mFilled + n > mSize)
+                    this->extendTab(n);
+                if constexpr(std::is_pointer<It>::value && std::is_same<typename std::remove_cv<typename std::remove_pointer<It>::type>::type, T>::value){
+                    this->copyBlock(first, n);
+                    return;
+                }
+                LIST_STAT(COPIES, n);
+            }
+            for(; first != last; ++first)
+                this->append(*first);
+        }
+
+        /**
+         * Ajout de tous les éléments de o par déplacement : o est vidé. Si ce Vecteur est vide, il récupère simplement le tableau de o.
+         */
+        void appendAll(Vector<T>&& o){
+            if(&o == this){
+                this->appendAll(static_cast<const List<T>&>(o));
+                return;
+            }
+            if(mFilled == 0 && o.mSize > mSize){
+                std::swap(mTab, o.mTab);
+                std::swap(mSize, o.mSize);
+                std::swap(mFilled, o.mFilled);
+                return;
+            }
+            if(mFilled + o.mFilled > mSize)
+                this->extendTab(o.mFilled);
+            LIST_STAT(MOVES, o.mFilled);
+            relocate(mTab + mFilled, o.mTab, o.mFilled);
+            mFilled += o.mFilled;
+            o.mFilled = 0;
+        }
+
+        /**
+         * Insertion des éléments de o (qui peut être ce Vecteur) devant le i-ème élément : la fin du tableau n'est décalée qu'une fois
+         */
+        void insertRange(int i, const List<T>& o){
+            if(i < 0 || mFilled < i)
+                throw IndexOutOfBoundsException();
+            if(&o == this){
+                Vector<T> copy(*this);
+                this->insertN(i, std::make_move_iterator(copy.mTab), copy.mFilled);
+                return;
+            }
+            this->insertN(i, o.begin(), o.size());
+        }
+
+        template<typename It>
+        void insertRange(int i, It first, It last){
+            if(i < 0 || mFilled < i)
+                throw IndexOutOfBoundsException();
+            if constexpr(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value){
+                this->insertN(i, first, (int)std::distance(first, last));
+            }else{
+                Vector<T> tmp;
+                tmp.appendAll(first, last);
+                this->insertN(i, std::make_move_iterator(tmp.mTab), tmp.mFilled);
+            }
+        }
+
+        void prependAll(const List<T>& o){
+            this->insertRange(0, o);
+        }
+
+        template<typename It>
+        void prependAll(It first, It last){
+            this->insertRange(0, first, last);
+        }
+
+        /**
+         * Supprime les éléments qui vérifient pred en un seul parcours : les éléments gardés sont déplacés vers l'avant, puis la fin du tableau est détruite. O(n) au total, quel que soit le nombre d'éléments supprimés (contre un parcours et un décalage par élément avec remove()). Si pred lance une exception, les éléments qui restaient à examiner sont gardés.
+         */
+        template<typename Pred>
+        int removeIf(Pred pred){
+            int w = 0;
+            int r = 0;
+            try{
+                for(; r < mFilled; r++){
+                    if(pred(mTab[r]))
+                        continue;
+                    if(w != r){
+                        mTab[w] = std::move(mTab[r]);
+                        LIST_STAT(MOVES, 1);
+                    }
+                    w++;
+                }
+            }catch(...){
+                for(; r < mFilled; r++, w++){
+                    if(w != r)
+                        mTab[w] = std::move(mTab[r]);
+                }
+                this->truncate(w);
+                throw;
+            }
+            int removed = mFilled - w;
+            this->truncate(w);
+            return removed;
+        }
+
+        int removeIf(const typename List<T>::Predicate& pred){
+            return this->template removeIf<const typename List<T>::Predicate&>(pred);
+        }
+
+        /**
+         * Versions sans exception (voir List<T>) : une seule vérification d'indice pour tryGet(), une seule recherche vectorisée pour tryRemove()
+         */
+        std::optional<T> tryGet(int i) const{
+            if((unsigned)i >= (unsigned)this->mFilled)
+                return std::nullopt;
+            return this->mTab[i];
+        }
+
+        bool tryRemove(const T& e){
+            int i = this->indexOf(e);
+            if(i == -1)
+                return false;
+            this->backOffset(i, 1);
+            mFilled--;
+            return true;
+        }
+
+        /**
+         * Retrait en fin de tableau, sans aucun décalage
+         */
+        T removeLast(){
+            if(this->mFilled == 0)
+                throw EmptyContainerException();
+
+            T ret = std::move(this->mTab[this->mFilled - 1]);
+            this->mTab[this->mFilled - 1].~T();
+            mFilled--;
+            return ret;
+        }
+
+        /**
+         * Tri en place du tableau (introsort, voir sort.hpp). La version template inline la comparaison ; les deux autres sont celles de List<T>.
+         */
+        template<typename Cmp>
+        void sort(Cmp cmp){
+            arraySort(this->mTab, this->mTab + this->mFilled, cmp);
+        }
+
+        void sort(const typename List<T>::Comparator& cmp){
+            arraySort(this->mTab, this->mTab + this->mFilled, cmp);
+        }
+
+        void sort(){
+            this->sort(std::less<T>());
+        }
+
 };
 
 #endif